@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Microbenchmarks for the Open1722 field codec and the header encoding and
+ * decoding of the supported PDU formats. Results are printed as JSON to
+ * stdout so they can be stored and compared across library versions.
+ *
+ * Usage:
+ *     open1722-bench [-n ITERATIONS] [-f FILTER]
+ *
+ * Every benchmark runs ITERATIONS operations (after a short warm-up) and
+ * reports the average time per operation in nanoseconds. With -f only the
+ * benchmarks whose name contains FILTER are run.
+ */
+
+#include <argp.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "avtp/Byteorder.h"
+#include "avtp/Dispatcher.h"
+#include "avtp/Utils.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/Rvf.h"
+#include "avtp/aaf/PcmStream.h"
+#include "avtp/acf/Can.h"
+#include "avtp/acf/Iterator.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/cvf/Cvf.h"
+
+#define DEFAULT_ITERATIONS      10000000ULL
+#define NSEC_PER_SEC            1000000000ULL
+#define BENCH_PDU_SIZE          64
+
+static uint64_t iterations = DEFAULT_ITERATIONS;
+static const char* filter;
+
+static struct argp_option options[] = {
+    {"iterations", 'n', "NUM", 0, "Number of operations per benchmark" },
+    {"filter", 'f', "NAME", 0, "Only run benchmarks whose name contains NAME" },
+    { 0 }
+};
+
+static error_t parser(int key, char *arg, struct argp_state *state)
+{
+    switch (key) {
+    case 'n':
+        iterations = strtoull(arg, NULL, 0);
+        if (iterations == 0) {
+            argp_error(state, "Invalid number of iterations");
+        }
+        break;
+    case 'f':
+        filter = arg;
+        break;
+    }
+
+    return 0;
+}
+
+static struct argp argp = { options, parser };
+
+/* Keeps the compiler from optimizing away results that are never read. */
+static volatile uint64_t sink;
+
+static inline void escape(void* p)
+{
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+/******************************************************************************
+ * Generic field codec
+ *****************************************************************************/
+
+/*
+ * Fields of different widths. The last two entries span a quadlet boundary,
+ * the 64 bit one even touches three quadlets.
+ */
+enum {
+    FIELD_1BIT,
+    FIELD_8BIT,
+    FIELD_29BIT,
+    FIELD_64BIT,
+    FIELD_16BIT_CROSSING,
+    FIELD_64BIT_CROSSING,
+    FIELD_MAX
+};
+
+static const Avtp_FieldDescriptor_t fieldDescriptors[FIELD_MAX] = {
+    [FIELD_1BIT]            = { .quadlet = 0, .offset =  8, .bits =  1 },
+    [FIELD_8BIT]            = { .quadlet = 0, .offset = 16, .bits =  8 },
+    [FIELD_29BIT]           = { .quadlet = 3, .offset =  3, .bits = 29 },
+    [FIELD_64BIT]           = { .quadlet = 1, .offset =  0, .bits = 64 },
+    [FIELD_16BIT_CROSSING]  = { .quadlet = 4, .offset = 24, .bits = 16 },
+    [FIELD_64BIT_CROSSING]  = { .quadlet = 4, .offset = 16, .bits = 64 },
+};
+
+#define DEFINE_FIELD_BENCH(name, field)                                         \
+    static void get_field_##name(uint8_t* pdu, uint64_t i)                      \
+    {                                                                           \
+        uint64_t value;                                                         \
+        Avtp_GetField(fieldDescriptors, FIELD_MAX, pdu, (field), &value);       \
+        sink = value;                                                           \
+    }                                                                           \
+    static void set_field_##name(uint8_t* pdu, uint64_t i)                      \
+    {                                                                           \
+        Avtp_SetField(fieldDescriptors, FIELD_MAX, pdu, (field), i);            \
+        escape(pdu);                                                            \
+    }
+
+DEFINE_FIELD_BENCH(1bit, FIELD_1BIT)
+DEFINE_FIELD_BENCH(8bit, FIELD_8BIT)
+DEFINE_FIELD_BENCH(29bit, FIELD_29BIT)
+DEFINE_FIELD_BENCH(64bit, FIELD_64BIT)
+DEFINE_FIELD_BENCH(16bit_crossing, FIELD_16BIT_CROSSING)
+DEFINE_FIELD_BENCH(64bit_crossing, FIELD_64BIT_CROSSING)
+
+/******************************************************************************
+ * Header encode/decode per format
+ *****************************************************************************/
+
+/*
+ * For every format four benchmarks are defined:
+ *  - decode_fields: read every header field with GetField()
+ *  - encode_fields: Init() followed by SetField() on every header field
+ *  - unpack: single-pass decode of the whole header
+ *  - pack: single-pass encode of the whole header
+ */
+#define DEFINE_FORMAT_BENCH(name, prefix, type, maxField)                       \
+    static void name##_decode_fields(uint8_t* pdu, uint64_t i)                  \
+    {                                                                           \
+        uint64_t value, sum = 0;                                                \
+        for (int field = 0; field < (maxField); field++) {                      \
+            prefix##_GetField((type*)pdu, field, &value);                       \
+            sum += value;                                                       \
+        }                                                                       \
+        sink = sum;                                                             \
+    }                                                                           \
+    static void name##_encode_fields(uint8_t* pdu, uint64_t i)                  \
+    {                                                                           \
+        prefix##_Init((type*)pdu);                                              \
+        for (int field = 1; field < (maxField); field++) {                      \
+            prefix##_SetField((type*)pdu, field, i);                            \
+        }                                                                       \
+        escape(pdu);                                                            \
+    }                                                                           \
+    static void name##_unpack(uint8_t* pdu, uint64_t i)                         \
+    {                                                                           \
+        prefix##Header_t header;                                                \
+        prefix##_Unpack((type*)pdu, &header);                                   \
+        escape(&header);                                                        \
+    }                                                                           \
+    static void name##_pack(uint8_t* pdu, uint64_t i)                           \
+    {                                                                           \
+        prefix##Header_t header;                                                \
+        memset(&header, (int)i, sizeof(header));                                \
+        prefix##_Pack((type*)pdu, &header);                                     \
+        escape(pdu);                                                            \
+    }
+
+DEFINE_FORMAT_BENCH(aaf, Avtp_AafPcmStream, Avtp_AafPcmStream_t, AVTP_AAF_PCM_STREAM_FIELD_MAX)
+DEFINE_FORMAT_BENCH(crf, Avtp_Crf, Avtp_Crf_t, AVTP_CRF_FIELD_MAX)
+DEFINE_FORMAT_BENCH(cvf, Avtp_Cvf, Avtp_Cvf_t, AVTP_CVF_FIELD_MAX)
+DEFINE_FORMAT_BENCH(rvf, Avtp_Rvf, Avtp_Rvf_t, AVTP_RVF_FIELD_MAX)
+DEFINE_FORMAT_BENCH(ntscf, Avtp_Ntscf, Avtp_Ntscf_t, AVTP_NTSCF_FIELD_MAX)
+DEFINE_FORMAT_BENCH(tscf, Avtp_Tscf, Avtp_Tscf_t, AVTP_TSCF_FIELD_MAX)
+DEFINE_FORMAT_BENCH(can, Avtp_Can, Avtp_Can_t, AVTP_CAN_FIELD_MAX)
+
+/*
+ * Reads the fields a CAN listener needs using the specialized inline
+ * accessors.
+ */
+static void can_accessors(uint8_t* pdu, uint64_t i)
+{
+    const Avtp_Can_t* can_pdu = (const Avtp_Can_t*)pdu;
+
+    sink = Avtp_Can_GetAcfMsgLength(can_pdu) + Avtp_Can_GetPad(can_pdu)
+            + Avtp_Can_GetEff(can_pdu) + Avtp_Can_GetCanIdentifier(can_pdu)
+            + Avtp_Can_GetMessageTimestamp(can_pdu);
+}
+
+/******************************************************************************
+ * ACF message traversal
+ *****************************************************************************/
+
+/*
+ * Walks an NTSCF PDU carrying eight classic CAN messages and reads the CAN
+ * identifier of each.
+ */
+#define ITER_NUM_MSGS           8
+
+static uint8_t iterPdu[AVTP_NTSCF_HEADER_LEN + ITER_NUM_MSGS * (AVTP_CAN_HEADER_LEN + 8)];
+
+static void acf_iter_setup(void)
+{
+    uint8_t payload[8] = { 0 };
+    size_t len = AVTP_NTSCF_HEADER_LEN;
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)iterPdu);
+    for (int i = 0; i < ITER_NUM_MSGS; i++) {
+        Avtp_Can_Init((Avtp_Can_t*)(iterPdu + len));
+        len += Avtp_Can_SetPayload((Avtp_Can_t*)(iterPdu + len), 0x100 + i, payload,
+                                   sizeof(payload), CAN_CLASSIC);
+    }
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)iterPdu, len - AVTP_NTSCF_HEADER_LEN);
+}
+
+static void acf_iterate(uint8_t* pdu, uint64_t i)
+{
+    Avtp_AcfIter_t iter;
+    Avtp_AcfMsg_t msg;
+    uint64_t sum = 0;
+
+    if (Avtp_Ntscf_GetNtscfDataLength((Avtp_Ntscf_t*)iterPdu) == 0) {
+        acf_iter_setup();
+    }
+
+    Avtp_AcfIter_Init(&iter, iterPdu, sizeof(iterPdu));
+    while (Avtp_AcfIter_Next(&iter, &msg) > 0) {
+        if (msg.msg_type == AVTP_ACF_TYPE_CAN) {
+            sum += Avtp_Can_GetCanIdentifier((const Avtp_Can_t*)msg.msg_ptr);
+        }
+    }
+    sink = sum;
+}
+
+/******************************************************************************
+ * Subtype dispatch
+ *****************************************************************************/
+
+/*
+ * Dispatches a mix of AAF, CVF, CRF and NTSCF PDUs as received from a single
+ * socket carrying all of them.
+ */
+#define DISPATCH_NUM_PDUS       4
+
+static Avtp_Dispatcher_t dispatcher;
+static uint8_t dispatchPdus[DISPATCH_NUM_PDUS][BENCH_PDU_SIZE];
+static int dispatchReady;
+
+static int dispatch_handler(const Avtp_PduView_t* view, void* ctx)
+{
+    sink += view->len;
+    return 0;
+}
+
+static void dispatch_setup(void)
+{
+    Avtp_AafPcmStream_Init((Avtp_AafPcmStream_t*)dispatchPdus[0]);
+    Avtp_AafPcmStream_SetStreamDataLength((Avtp_AafPcmStream_t*)dispatchPdus[0], 16);
+    Avtp_Cvf_Init((Avtp_Cvf_t*)dispatchPdus[1]);
+    Avtp_Cvf_SetStreamDataLength((Avtp_Cvf_t*)dispatchPdus[1], 16);
+    Avtp_Crf_Init((Avtp_Crf_t*)dispatchPdus[2]);
+    Avtp_Crf_SetCrfDataLength((Avtp_Crf_t*)dispatchPdus[2], 16);
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)dispatchPdus[3]);
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)dispatchPdus[3], 16);
+
+    Avtp_Dispatcher_Init(&dispatcher);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_AAF, dispatch_handler, NULL);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_CVF, dispatch_handler, NULL);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_CRF, dispatch_handler, NULL);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_NTSCF, dispatch_handler, NULL);
+    dispatchReady = 1;
+}
+
+static void dispatch_mixed(uint8_t* pdu, uint64_t i)
+{
+    if (!dispatchReady) {
+        dispatch_setup();
+    }
+    Avtp_Dispatcher_Dispatch(&dispatcher, dispatchPdus[i % DISPATCH_NUM_PDUS], BENCH_PDU_SIZE);
+}
+
+/******************************************************************************
+ * Bulk byte-order conversion
+ *****************************************************************************/
+
+/*
+ * Converts a block of 1024 samples (or timestamps) once with the element by
+ * element loop the examples used to have and once with the bulk kernels.
+ */
+#define BSWAP_ARRAY_LEN         1024
+
+#define DEFINE_BSWAP_BENCH(bits)                                                \
+    static uint##bits##_t bswapSrc##bits[BSWAP_ARRAY_LEN];                      \
+    static uint##bits##_t bswapDst##bits[BSWAP_ARRAY_LEN];                      \
+    static void bswap_loop##bits(uint8_t* pdu, uint64_t i)                      \
+    {                                                                           \
+        for (size_t j = 0; j < BSWAP_ARRAY_LEN; j++) {                          \
+            bswapDst##bits[j] = Avtp_CpuToBe##bits(bswapSrc##bits[j]);          \
+        }                                                                       \
+        escape(bswapDst##bits);                                                 \
+    }                                                                           \
+    static void bswap_array##bits(uint8_t* pdu, uint64_t i)                     \
+    {                                                                           \
+        Avtp_CpuToBeArray##bits(bswapDst##bits, bswapSrc##bits, BSWAP_ARRAY_LEN); \
+        escape(bswapDst##bits);                                                 \
+    }
+
+DEFINE_BSWAP_BENCH(16)
+DEFINE_BSWAP_BENCH(32)
+DEFINE_BSWAP_BENCH(64)
+
+/******************************************************************************
+ * Runner
+ *****************************************************************************/
+
+/*
+ * Offset of the PDU from an 8 byte aligned address. Frames received from a
+ * socket typically place the AVTP PDU right after the 14 byte Ethernet header,
+ * so the unaligned variants run on a PDU that is only 2 byte aligned.
+ */
+#define ALIGNED                 0
+#define UNALIGNED               2
+
+typedef struct {
+    const char* name;
+    void (*run)(uint8_t* pdu, uint64_t i);
+    size_t offset;
+} Benchmark_t;
+
+#define FIELD_BENCH_ENTRIES(name)                                               \
+    { "get_field/" #name, get_field_##name, ALIGNED },                          \
+    { "set_field/" #name, set_field_##name, ALIGNED },                          \
+    { "get_field/" #name "/unaligned", get_field_##name, UNALIGNED },           \
+    { "set_field/" #name "/unaligned", set_field_##name, UNALIGNED },
+
+#define FORMAT_BENCH_ENTRIES(name)                                              \
+    { #name "/decode_fields", name##_decode_fields, ALIGNED },                  \
+    { #name "/encode_fields", name##_encode_fields, ALIGNED },                  \
+    { #name "/unpack", name##_unpack, ALIGNED },                                \
+    { #name "/pack", name##_pack, ALIGNED },                                    \
+    { #name "/unpack/unaligned", name##_unpack, UNALIGNED },                    \
+    { #name "/pack/unaligned", name##_pack, UNALIGNED },
+
+static const Benchmark_t benchmarks[] = {
+    FIELD_BENCH_ENTRIES(1bit)
+    FIELD_BENCH_ENTRIES(8bit)
+    FIELD_BENCH_ENTRIES(29bit)
+    FIELD_BENCH_ENTRIES(64bit)
+    FIELD_BENCH_ENTRIES(16bit_crossing)
+    FIELD_BENCH_ENTRIES(64bit_crossing)
+    FORMAT_BENCH_ENTRIES(aaf)
+    FORMAT_BENCH_ENTRIES(crf)
+    FORMAT_BENCH_ENTRIES(cvf)
+    FORMAT_BENCH_ENTRIES(rvf)
+    FORMAT_BENCH_ENTRIES(ntscf)
+    FORMAT_BENCH_ENTRIES(tscf)
+    FORMAT_BENCH_ENTRIES(can)
+    { "can/accessors", can_accessors, ALIGNED },
+    { "can/accessors/unaligned", can_accessors, UNALIGNED },
+    { "acf/iterate", acf_iterate, ALIGNED },
+    { "dispatch/mixed", dispatch_mixed, ALIGNED },
+    { "bswap/loop16", bswap_loop16, ALIGNED },
+    { "bswap/array16", bswap_array16, ALIGNED },
+    { "bswap/loop32", bswap_loop32, ALIGNED },
+    { "bswap/array32", bswap_array32, ALIGNED },
+    { "bswap/loop64", bswap_loop64, ALIGNED },
+    { "bswap/array64", bswap_array64, ALIGNED },
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static double run_benchmark(const Benchmark_t* bench)
+{
+    uint8_t buf[BENCH_PDU_SIZE + UNALIGNED] __attribute__((aligned(8)));
+    uint8_t* pdu = buf + bench->offset;
+    uint64_t i, start, end;
+
+    for (i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)(i * 0x3d);
+    }
+
+    for (i = 0; i < iterations / 10; i++) {
+        bench->run(pdu, i);
+    }
+
+    start = now_ns();
+    for (i = 0; i < iterations; i++) {
+        bench->run(pdu, i);
+    }
+    end = now_ns();
+
+    return (double)(end - start) / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t i;
+    int first = 1;
+
+    argp_parse(&argp, argc, argv, 0, NULL, NULL);
+
+    printf("{\n");
+    printf("  \"iterations\": %" PRIu64 ",\n", iterations);
+    printf("  \"benchmarks\": [");
+
+    for (i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (filter != NULL && strstr(benchmarks[i].name, filter) == NULL) {
+            continue;
+        }
+
+        double ns_per_op = run_benchmark(&benchmarks[i]);
+
+        printf("%s\n    { \"name\": \"%s\", \"ns_per_op\": %.3f }",
+                first ? "" : ",", benchmarks[i].name, ns_per_op);
+        fflush(stdout);
+        first = 0;
+    }
+
+    printf("\n  ]\n}\n");
+
+    return 0;
+}
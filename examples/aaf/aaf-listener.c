@@ -71,6 +71,7 @@
 
 #include "avtp/aaf/PcmStream.h"
 #include "common/common.h"
+#include "common/packet_ring.h"
 #include "avtp/CommonHeader.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -90,11 +91,13 @@ struct sample_entry {
 static STAILQ_HEAD(sample_queue, sample_entry) samples;
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
+static int xdp_queue = -1;
 static uint8_t expected_seq;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
+    {"xdp", 'x', "QUEUE", 0, "Receive through an AF_XDP socket on the given queue" },
     { 0 }
 };
 
@@ -116,6 +119,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'i':
         strncpy(ifname, arg, sizeof(ifname) - 1);
         break;
+    case 'x':
+        xdp_queue = atoi(arg);
+        break;
     }
 
     return 0;
@@ -159,155 +165,99 @@ static int schedule_sample(int fd, struct timespec *tspec, uint8_t *pcm_sample)
 
 static bool is_valid_packet(struct avtp_stream_pdu *pdu)
 {
-    struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-    uint64_t val64;
-    uint32_t val32;
+    Avtp_AafPcmStreamHeader_t header;
     int res;
 
-    res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
+    res = Avtp_AafPcmStream_Unpack((Avtp_AafPcmStream_t*)pdu, &header);
     if (res < 0) {
-        fprintf(stderr, "Failed to get subtype field: %d\n", res);
+        fprintf(stderr, "Failed to unpack AAF header: %d\n", res);
         return false;
     }
-    if (val32 != AVTP_SUBTYPE_AAF) {
+
+    if (header.subtype != AVTP_SUBTYPE_AAF) {
         fprintf(stderr, "Subtype mismatch: expected %u, got %u\n",
-                        AVTP_SUBTYPE_AAF, val32);
+                        AVTP_SUBTYPE_AAF, header.subtype);
         return false;
     }
 
-    res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get version field: %d\n", res);
-        return false;
-    }
-    if (val32 != 0) {
+    if (header.version != 0) {
         fprintf(stderr, "Version mismatch: expected %u, got %u\n",
-                                0, val32);
+                                0, header.version);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TV, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get tv field: %d\n", res);
-        return false;
-    }
-    if (val64 != 1) {
-        fprintf(stderr, "tv mismatch: expected %u, got %" PRIu64 "\n",
-                                1, val64);
+    if (header.tv != 1) {
+        fprintf(stderr, "tv mismatch: expected %u, got %u\n",
+                                1, header.tv);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SP, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get sp field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_PCM_SP_NORMAL) {
-        fprintf(stderr, "sp mismatch: expected %u, got %" PRIu64 "\n",
-                        AVTP_AAF_PCM_SP_NORMAL, val64);
+    if (header.sp != AVTP_AAF_PCM_SP_NORMAL) {
+        fprintf(stderr, "sp mismatch: expected %u, got %u\n",
+                        AVTP_AAF_PCM_SP_NORMAL, header.sp);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_ID, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get stream ID field: %d\n", res);
-        return false;
-    }
-    if (val64 != STREAM_ID) {
+    if (header.stream_id != STREAM_ID) {
         fprintf(stderr, "Stream ID mismatch: expected %" PRIu64 ", got %" PRIu64 "\n",
-                            STREAM_ID, val64);
-        return false;
-    }
-
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SEQ_NUM, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get sequence num field: %d\n", res);
+                            STREAM_ID, header.stream_id);
         return false;
     }
 
-    if (val64 != expected_seq) {
+    if (header.sequence_num != expected_seq) {
         /* If we have a sequence number mismatch, we simply log the
          * issue and continue to process the packet. We don't want to
          * invalidate it since it is a valid packet after all.
          */
-        fprintf(stderr, "Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-                            expected_seq, val64);
-        expected_seq = val64;
+        fprintf(stderr, "Sequence number mismatch: expected %u, got %u\n",
+                            expected_seq, header.sequence_num);
+        expected_seq = header.sequence_num;
     }
 
     expected_seq++;
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_FORMAT, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get format field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_FORMAT_INT_16BIT) {
-        fprintf(stderr, "Format mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_AAF_FORMAT_INT_16BIT, val64);
+    if (header.format != AVTP_AAF_FORMAT_INT_16BIT) {
+        fprintf(stderr, "Format mismatch: expected %u, got %u\n",
+                    AVTP_AAF_FORMAT_INT_16BIT, header.format);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_NSR, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get sample rate field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_PCM_NSR_48KHZ) {
-        fprintf(stderr, "Sample rate mismatch: expected %u, got %" PRIu64 "\n",
-                        AVTP_AAF_PCM_NSR_48KHZ, val64);
+    if (header.nsr != AVTP_AAF_PCM_NSR_48KHZ) {
+        fprintf(stderr, "Sample rate mismatch: expected %u, got %u\n",
+                        AVTP_AAF_PCM_NSR_48KHZ, header.nsr);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_CHAN_PER_FRAME, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get channels field: %d\n", res);
-        return false;
-    }
-    if (val64 != NUM_CHANNELS) {
-        fprintf(stderr, "Channels mismatch: expected %u, got %" PRIu64 "\n",
-                            NUM_CHANNELS, val64);
+    if (header.channels_per_frame != NUM_CHANNELS) {
+        fprintf(stderr, "Channels mismatch: expected %u, got %u\n",
+                            NUM_CHANNELS, header.channels_per_frame);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_BIT_DEPTH, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get depth field: %d\n", res);
-        return false;
-    }
-    if (val64 != 16) {
-        fprintf(stderr, "Depth mismatch: expected %u, got %" PRIu64 "\n",
-                                16, val64);
+    if (header.bit_depth != 16) {
+        fprintf(stderr, "Depth mismatch: expected %u, got %u\n",
+                                16, header.bit_depth);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_DATA_LEN, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get data_len field: %d\n", res);
-        return false;
-    }
-    if (val64 != DATA_LEN) {
-        fprintf(stderr, "Data len mismatch: expected %u, got %" PRIu64 "\n",
-                            DATA_LEN, val64);
+    if (header.stream_data_length != DATA_LEN) {
+        fprintf(stderr, "Data len mismatch: expected %u, got %u\n",
+                            DATA_LEN, header.stream_data_length);
         return false;
     }
 
     return true;
 }
 
-static int new_packet(int sk_fd, int timer_fd)
+static int new_packet(uint8_t *frame, size_t len, int timer_fd)
 {
     int res;
-    ssize_t n;
     uint64_t avtp_time;
     struct timespec tspec;
-    struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
-
-    memset(pdu, 0, PDU_SIZE);
+    struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) frame;
 
-    n = recv(sk_fd, pdu, PDU_SIZE, 0);
-    if (n < 0 || n != PDU_SIZE) {
-        perror("Failed to receive data");
+    if (len != PDU_SIZE) {
+        fprintf(stderr, "Received %zu bytes, expected %zu\n", len, PDU_SIZE);
         return -1;
     }
 
@@ -373,6 +323,9 @@ int main(int argc, char *argv[])
 {
     int sk_fd, timer_fd, res;
     struct pollfd fds[2];
+    struct rx_ring *ring;
+    uint8_t *frame;
+    size_t len;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -382,13 +335,25 @@ int main(int argc, char *argv[])
     if (sk_fd < 0)
         return 1;
 
+    // The socket keeps the multicast membership in AF_XDP mode
+    if (xdp_queue >= 0)
+        ring = rx_ring_alloc_xdp(ifname, macaddr, xdp_queue);
+    else
+        ring = rx_ring_alloc(sk_fd, RX_RING_BLOCK_SIZE, RX_RING_NUM_BLOCKS,
+                             RX_RING_RETIRE_MS);
+    if (!ring) {
+        close(sk_fd);
+        return 1;
+    }
+
     timer_fd = timerfd_create(CLOCK_REALTIME, 0);
     if (timer_fd < 0) {
+        rx_ring_free(ring);
         close(sk_fd);
         return 1;
     }
 
-    fds[0].fd = sk_fd;
+    fds[0].fd = rx_ring_fd(ring);
     fds[0].events = POLLIN;
     fds[1].fd = timer_fd;
     fds[1].events = POLLIN;
@@ -401,7 +366,11 @@ int main(int argc, char *argv[])
         }
 
         if (fds[0].revents & POLLIN) {
-            res = new_packet(sk_fd, timer_fd);
+            while ((res = rx_ring_next(ring, &frame, &len)) > 0) {
+                res = new_packet(frame, len, timer_fd);
+                if (res < 0)
+                    goto err;
+            }
             if (res < 0)
                 goto err;
         }
@@ -416,6 +385,7 @@ int main(int argc, char *argv[])
     return 0;
 
 err:
+    rx_ring_free(ring);
     close(sk_fd);
     close(timer_fd);
     return 1;
@@ -60,12 +60,15 @@
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
 #include "avtp/aaf/PcmStream.h"
+#include "avtp/StreamTemplate.h"
 #include "common/common.h"
+#include "common/packet_ring.h"
 #include "avtp/CommonHeader.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -75,17 +78,26 @@
 #define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
 #define NSEC_PER_SEC		1000000000ULL
 #define NSEC_PER_MSEC		1000000ULL
+/* Maximum number of samples read from STDIN and sent with one flush */
+#define BATCH_SAMPLES		64
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static int priority = -1;
 static int max_transit_time;
+static int qdisc_bypass;
+static int xdp_queue = -1;
+
+static uint8_t buffer[BATCH_SAMPLES * DATA_LEN];
+static size_t buffer_level;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
     {"max-transit-time", 'm', "MSEC", 0, "Maximum Transit Time in ms" },
     {"prio", 'p', "NUM", 0, "SO_PRIORITY to be set in socket" },
+    {"qdisc-bypass", 'q', 0, 0, "Bypass the qdisc layer (no traffic shaping)" },
+    {"xdp", 'x', "QUEUE", 0, "Transmit through an AF_XDP socket on the given queue" },
     { 0 }
 };
 
@@ -113,6 +125,12 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'p':
         priority = atoi(arg);
         break;
+    case 'q':
+        qdisc_bypass = 1;
+        break;
+    case 'x':
+        xdp_queue = atoi(arg);
+        break;
     }
 
     return 0;
@@ -171,6 +189,8 @@ int main(int argc, char *argv[])
     int fd, res;
     struct sockaddr_ll sk_addr;
     struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
+    Avtp_StreamTemplate_t tmpl;
+    struct tx_ring *ring = NULL;
     uint8_t seq_num = 0;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
@@ -187,53 +207,82 @@ int main(int argc, char *argv[])
     if (res < 0)
         goto err;
 
+    res = Avtp_StreamTemplate_Init(&tmpl, (uint8_t *) pdu,
+                                AVTP_AAF_PCM_STREAM_HEADER_LEN);
+    if (res < 0)
+        goto err;
+
+    if (xdp_queue >= 0)
+        ring = tx_ring_alloc_xdp(ifname, macaddr, PDU_SIZE, xdp_queue);
+    else
+        ring = tx_ring_alloc(fd, (struct sockaddr *) &sk_addr, sizeof(sk_addr),
+                             PDU_SIZE, TX_RING_NUM_FRAMES, qdisc_bypass);
+    if (!ring)
+        goto err;
+
     while (1) {
         ssize_t n;
+        size_t offset = 0;
         uint32_t avtp_time;
+        bool end = false;
+
+        n = read(STDIN_FILENO, buffer + buffer_level,
+                        sizeof(buffer) - buffer_level);
+        if (n < 0) {
+            perror("Could not read from standard input");
+            goto err;
+        }
+        buffer_level += n;
+
+        // Send a partial sample left at the end of the input zero padded
+        if (n == 0) {
+            if (buffer_level == 0)
+                break;
+            fprintf(stderr, "read %zu bytes, expected %d\n",
+                                buffer_level, DATA_LEN);
+            memset(buffer + buffer_level, 0, DATA_LEN - buffer_level);
+            buffer_level = DATA_LEN;
+            end = true;
+        }
 
-        memset(pdu->avtp_payload, 0, DATA_LEN);
+        while (buffer_level - offset >= DATA_LEN) {
+            // Build the PDU in place in the transmit ring
+            pdu = (struct avtp_stream_pdu *) tx_ring_reserve(ring);
+            if (!pdu)
+                goto err;
 
-        n = read(STDIN_FILENO, pdu->avtp_payload, DATA_LEN);
-        if (n == 0)
-            break;
+            memcpy(pdu->avtp_payload, buffer + offset, DATA_LEN);
+            offset += DATA_LEN;
 
-        if (n != DATA_LEN) {
-            fprintf(stderr, "read %zd bytes, expected %d\n",
-                                n, DATA_LEN);
-        }
+            res = calculate_avtp_time(&avtp_time, max_transit_time);
+            if (res < 0) {
+                fprintf(stderr, "Failed to calculate avtp time\n");
+                goto err;
+            }
 
-        res = calculate_avtp_time(&avtp_time, max_transit_time);
-        if (res < 0) {
-            fprintf(stderr, "Failed to calculate avtp time\n");
-            goto err;
-        }
+            Avtp_StreamTemplate_Emit(&tmpl, (uint8_t *) pdu, seq_num++,
+                                    avtp_time, DATA_LEN);
 
-        res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_TIMESTAMP,
-                                avtp_time);
-        if (res < 0)
-            goto err;
+            tx_ring_commit(ring, PDU_SIZE);
+        }
 
-        res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_SEQ_NUM, seq_num++);
-        if (res < 0)
+        // Send the PDUs of all samples in this chunk of input at once
+        if (tx_ring_flush(ring) < 0)
             goto err;
 
-        n = sendto(fd, pdu, PDU_SIZE, 0,
-                (struct sockaddr *) &sk_addr, sizeof(sk_addr));
-        if (n < 0) {
-            perror("Failed to send data");
-            goto err;
-        }
+        buffer_level -= offset;
+        memmove(buffer, buffer + offset, buffer_level);
 
-        if (n != PDU_SIZE) {
-            fprintf(stderr, "wrote %zd bytes, expected %zd\n",
-                                n, PDU_SIZE);
-        }
+        if (end)
+            break;
     }
 
+    tx_ring_free(ring);
     close(fd);
     return 0;
 
 err:
+    tx_ring_free(ring);
     close(fd);
     return 1;
 }
\ No newline at end of file
@@ -28,6 +28,7 @@
  */
 
 #include <argp.h>
+#include <errno.h>
 #include <poll.h>
 #include <stdlib.h>
 #include <linux/if_ether.h>
@@ -42,28 +43,59 @@
 #include <sys/ioctl.h>
 
 #include "common/common.h"
+#include "common/candump.h"
+#include "common/canfilter.h"
+#include "common/packet_ring.h"
 #include "avtp/Udp.h"
 #include "avtp/acf/Ntscf.h"
 #include "avtp/acf/Tscf.h"
 #include "avtp/acf/Common.h"
 #include "avtp/acf/Can.h"
+#include "avtp/acf/CanBrief.h"
+#include "avtp/acf/Iterator.h"
 #include "avtp/CommonHeader.h"
+#include "avtp/PduView.h"
+#include "avtp/Dispatcher.h"
 
 #define MAX_PDU_SIZE                1500
+#define CAN_BATCH_SIZE              64
+#define MAX_CAN_BUSES               32
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static uint8_t use_udp;
 static uint32_t udp_port = 17220;
 static char can_ifname[IFNAMSIZ] = "STDOUT\0";
+static Avtp_Dispatcher_t dispatcher;
+static struct candump_writer stdout_writer;
+static struct can_id_filter id_filter;
+
+/* CAN interface to which the frames of an ACF CAN bus ID are written */
+struct can_bus {
+    uint8_t bus_id;
+    char ifname[IFNAMSIZ];
+    int fd;
+    struct batch_io* batch;
+};
+
+static struct can_bus buses[MAX_CAN_BUSES];
+static int num_buses;
+static struct can_bus* bus_routes[MAX_CAN_BUSES];
+static struct can_bus default_bus;
+static int use_stdout;
 
 static char doc[] = "\nacf-can-listener -- a program designed to receive CAN messages from \
-                    a remote CAN bus over Ethernet using Open1722 \
+                    a remote CAN bus over Ethernet using Open1722. Both ACF CAN and \
+                    ACF CAN Brief messages are accepted. \
                     \vEXAMPLES\
                     \n\n  acf-can-listener eth0 aa:bb:cc:dd:ee:ff can1\
                     \n\n    (tunnel Open1722 CAN messages received from eth0 to STDOUT)\
                     \n\n  acf-can-listener can1 -up 1722\
                     \n\n    (tunnel Open1722 CAN messages received over UDP from port 1722 to can1)\
+                    \n\n  acf-can-listener -up 1722 --filter 100-1FF,18DAF110 can1\
+                    \n\n    (as above, but only forward the standard IDs 0x100 to 0x1FF and the extended ID 0x18DAF110)\
+                    \n\n  acf-can-listener -up 1722 --bus 0=can0 --bus 1=can1\
+                    \n\n    (write CAN messages of bus ID 0 to can0 and of bus ID 1 to can1)\
                     \n\n  acf-can-listener -up 1722 | canplayer can1=elmcan\
                     \n\n    (another method to tunnel Open1722 CAN messages to can1)";
 
@@ -72,6 +104,9 @@ static char args_doc[] = "[ifname] dst-mac-address [can ifname]";
 static struct argp_option options[] = {
     {"port", 'p', "UDP_PORT", 0, "UDP Port to listen on if UDP enabled"},
     {"udp", 'u', 0, 0, "Use UDP"},
+    {"bus", 'B', "ID=CAN_IFNAME", 0, "Write CAN frames with CAN bus ID (0-31) to CAN_IFNAME, may be repeated. Frames of other bus IDs go to [can ifname] if given and are dropped otherwise"},
+    {"filter", 'f', "RULES", 0, "Only forward CAN frames matching one of the comma separated rules <id>, <id>:<mask> or <lo>-<hi> (hex, may be repeated)"},
+    {"filter-file", 'F', "FILE", 0, "Read filter rules from FILE, one per line"},
     {"can ifname", 0, 0, OPTION_DOC, "CAN interface (set to STDOUT by default)"},
     {"dst-mac-address", 0, 0, OPTION_DOC, "Stream destination MAC address (If Ethernet)"},
     {"ifname", 0, 0, OPTION_DOC, "Network interface (If Ethernet)" },
@@ -89,6 +124,25 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'u':
         use_udp = 1;
         break;
+    case 'B':
+        if (num_buses == MAX_CAN_BUSES)
+            argp_error(state, "At most %d CAN buses are supported", MAX_CAN_BUSES);
+        if (parse_can_bus_mapping(arg, &buses[num_buses].bus_id, buses[num_buses].ifname,
+                                  sizeof(buses[num_buses].ifname)) < 0)
+            argp_usage(state);
+        if (bus_routes[buses[num_buses].bus_id])
+            argp_error(state, "CAN bus ID %u is used twice", buses[num_buses].bus_id);
+        bus_routes[buses[num_buses].bus_id] = &buses[num_buses];
+        num_buses++;
+        break;
+    case 'f':
+        if (can_id_filter_add_rules(&id_filter, arg) < 0)
+            argp_error(state, "Invalid filter rules '%s'", arg);
+        break;
+    case 'F':
+        if (can_id_filter_load_file(&id_filter, arg) < 0)
+            argp_error(state, "Invalid filter file '%s'", arg);
+        break;
 
     case ARGP_KEY_NO_ARGS:
         break;
@@ -134,20 +188,6 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser, args_doc, doc };
 
-static int is_valid_acf_packet(uint8_t* acf_pdu) {
-
-    uint64_t val64;
-
-    Avtp_AcfCommon_GetField((Avtp_AcfCommon_t*)acf_pdu, AVTP_ACF_FIELD_ACF_MSG_TYPE, &val64);
-    if (val64 != AVTP_ACF_TYPE_CAN) {
-        fprintf(stderr, "ACF type mismatch: expected %u, got %lu\n",
-                AVTP_ACF_TYPE_CAN, val64);
-        return 0;
-    }
-
-    return 1;
-}
-
 void print_can_acf(uint8_t* acf_pdu)
 {
     uint64_t acf_msg_len, can_bus_id, timestamp, can_identifier, pad;
@@ -168,157 +208,280 @@ void print_can_acf(uint8_t* acf_pdu)
     fprintf(stderr, "Pad: %"PRIu64"\n", pad);
 }
 
-static int new_packet(int sk_fd, int can_socket) {
-
-    int res;
-    uint64_t msg_length, proc_bytes = 0, msg_proc_bytes = 0;
-    uint64_t can_frame_id, udp_seq_num = 0, subtype;
-    uint16_t payload_length, pdu_length;
-    uint8_t *can_payload, i;
-    uint8_t pdu[MAX_PDU_SIZE];
-    uint8_t* cf_pdu;
-    uint8_t* acf_pdu;
-    Avtp_UDP_t *udp_pdu;
-    char stdout_string[1000] = "\0";
-    struct can_frame frame;
-    uint64_t eff;
-
-    res = recv(sk_fd, pdu, MAX_PDU_SIZE, 0);
-
-    if (res < 0 || res > MAX_PDU_SIZE) {
-        perror("Failed to receive data");
-        return -1;
-    }
-
-    if (use_udp) {
-        udp_pdu = (Avtp_UDP_t *) pdu;
-        Avtp_UDP_GetField(udp_pdu, AVTP_UDP_FIELD_ENCAPSULATION_SEQ_NO, &udp_seq_num);
-        cf_pdu = pdu + AVTP_UDP_HEADER_LEN;
-        proc_bytes += AVTP_UDP_HEADER_LEN;
-    } else {
-        cf_pdu = pdu;
-    }
+static int send_frames(struct can_bus* bus)
+{
+    if (batch_io_count(bus->batch) == 0)
+        return 0;
 
-    res = Avtp_CommonHeader_GetField((Avtp_CommonHeader_t*)cf_pdu, AVTP_COMMON_HEADER_FIELD_SUBTYPE, &subtype);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get subtype field: %d\n", res);
-        return -1;
-    }
+    return batch_io_send(bus->fd, bus->batch);
+}
 
-    if (!((subtype == AVTP_SUBTYPE_NTSCF) ||
-        (subtype == AVTP_SUBTYPE_TSCF))) {
-        fprintf(stderr, "Subtype mismatch: expected %u or %u, got %"PRIu64". Dropping packet\n",
-                AVTP_SUBTYPE_NTSCF, AVTP_SUBTYPE_TSCF, subtype);
-        return -1;
-    }
+/* Returns the CAN bus to write a frame of a bus ID to, or NULL to drop it */
+static struct can_bus* route_frame(uint64_t bus_id)
+{
+    if (bus_routes[bus_id])
+        return bus_routes[bus_id];
 
-    if(subtype == AVTP_SUBTYPE_TSCF){
-        proc_bytes += AVTP_TSCF_HEADER_LEN;
-        res = Avtp_Tscf_GetField((Avtp_Tscf_t*)cf_pdu, AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, (uint64_t *) &msg_length);
-    }else{
-        proc_bytes += AVTP_NTSCF_HEADER_LEN;
-        res = Avtp_Ntscf_GetField((Avtp_Ntscf_t*)cf_pdu, AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, (uint64_t *) &msg_length);
-    }
+    return default_bus.fd > 0 ? &default_bus : NULL;
+}
 
-    if (res < 0) {
-        fprintf(stderr, "Failed to get message length: %d\n", res);
-        return -1;
-    }
+static int handle_acf_messages(Avtp_PduView_t msgs_view) {
 
-    while (msg_proc_bytes < msg_length) {
+    int res;
+    uint64_t can_frame_id;
+    uint16_t payload_length;
+    const uint8_t *can_payload;
+    Avtp_AcfIter_t iter;
+    Avtp_AcfMsg_t msg;
+    Avtp_PduView_t can_view;
+    struct canfd_frame stdout_frame;
+    struct canfd_frame* frame;
+    struct can_bus* bus = NULL;
+    uint64_t eff, fdf, brs, esi;
+    int i;
+
+    Avtp_AcfIter_InitMessages(&iter, msgs_view.base, msgs_view.len);
+
+    while ((res = Avtp_AcfIter_Next(&iter, &msg)) > 0) {
+
+        if (msg.msg_type == AVTP_ACF_TYPE_CAN) {
+            const Avtp_Can_t* can_pdu;
+
+            if (Avtp_Can_InitView(&can_view, msg.msg_ptr, msg.msg_len) < 0) {
+                fprintf(stderr, "Error: Invalid ACF packet.\n");
+                return -1;
+            }
 
-        acf_pdu = &pdu[proc_bytes + msg_proc_bytes];
+            can_pdu = (const Avtp_Can_t*)can_view.base;
+            can_frame_id = Avtp_Can_GetCanIdentifier(can_pdu);
+            eff = Avtp_Can_GetEff(can_pdu);
+            if (!can_id_filter_match(&id_filter, can_frame_id, eff)) {
+                continue;
+            }
+            if (!use_stdout && !(bus = route_frame(Avtp_Can_GetCanBusId(can_pdu)))) {
+                continue;
+            }
+            fdf = Avtp_Can_GetFdf(can_pdu);
+            brs = Avtp_Can_GetBrs(can_pdu);
+            esi = Avtp_Can_GetEsi(can_pdu);
+            can_payload = Avtp_Can_GetViewPayload(&can_view, &payload_length);
+        } else if (msg.msg_type == AVTP_ACF_TYPE_CAN_BRIEF) {
+            const Avtp_CanBrief_t* can_pdu;
+
+            if (Avtp_CanBrief_InitView(&can_view, msg.msg_ptr, msg.msg_len) < 0) {
+                fprintf(stderr, "Error: Invalid ACF packet.\n");
+                return -1;
+            }
 
-        if (!is_valid_acf_packet(acf_pdu)) {
-            fprintf(stderr, "Error: Invalid ACF packet.\n");
-            return -1;
+            can_pdu = (const Avtp_CanBrief_t*)can_view.base;
+            can_frame_id = Avtp_CanBrief_GetCanIdentifier(can_pdu);
+            eff = Avtp_CanBrief_GetEff(can_pdu);
+            if (!can_id_filter_match(&id_filter, can_frame_id, eff)) {
+                continue;
+            }
+            if (!use_stdout && !(bus = route_frame(Avtp_CanBrief_GetCanBusId(can_pdu)))) {
+                continue;
+            }
+            fdf = Avtp_CanBrief_GetFdf(can_pdu);
+            brs = Avtp_CanBrief_GetBrs(can_pdu);
+            esi = Avtp_CanBrief_GetEsi(can_pdu);
+            can_payload = Avtp_CanBrief_GetViewPayload(&can_view, &payload_length);
+        } else {
+            // Other ACF message types may share the stream, skip them
+            continue;
         }
 
-        res = Avtp_Can_GetField((Avtp_Can_t*)acf_pdu, AVTP_CAN_FIELD_CAN_IDENTIFIER,
-                                &can_frame_id);
-        if (res < 0) {
-            fprintf(stderr, "Error: Getting CAN frame ID\n");
-            return -1;
+        if (can_frame_id > 0x7FF && !eff) {
+          fprintf(stderr, "Error: CAN ID is > 0x7FF but the EFF bit is not set.\n");
+          return -1;
         }
 
-        can_payload = Avtp_Can_GetPayload((Avtp_Can_t*)acf_pdu, &payload_length, &pdu_length);
-        msg_proc_bytes += pdu_length*4;
-
-        res = Avtp_Can_GetField((Avtp_Can_t*)acf_pdu, AVTP_CAN_FIELD_EFF, &eff);
-        if (res < 0) {
-            fprintf(stderr, "Failed to get eff field: %d\n", res);
+        if (payload_length > (fdf ? CANFD_MAX_DLEN : CAN_MAX_DLEN)) {
+            fprintf(stderr, "Error: CAN payload of %u bytes exceeds %u bytes.\n",
+                    payload_length, fdf ? CANFD_MAX_DLEN : CAN_MAX_DLEN);
             return -1;
         }
 
-        if (can_frame_id > 0x7FF && !eff) {
-          fprintf(stderr, "Error: CAN ID is > 0x7FF but the EFF bit is not set.\n");
-          return -1;
+        // Decoded frames are collected and written with one sendmmsg() or
+        // write() per PDU
+        if (use_stdout) {
+            frame = &stdout_frame;
+        } else {
+            frame = (struct canfd_frame*) batch_io_reserve(bus->batch);
+            if (frame == NULL) {
+                if (send_frames(bus) < 0) {
+                    return 1;
+                }
+                frame = (struct canfd_frame*) batch_io_reserve(bus->batch);
+            }
         }
 
-        if (can_socket == 0) {
-            for (i = 0; i < payload_length; i++) {
-                sprintf(stdout_string+(2*i), "%02x", can_payload[i]);
-            }
+        memset(frame, 0, sizeof(*frame));
+        frame->can_id = (canid_t) can_frame_id;
+        if (eff) {
+          frame->can_id |= CAN_EFF_FLAG;
+        }
+        frame->len = payload_length;
+        if (fdf) {
+            frame->flags = (brs ? CANFD_BRS : 0) | (esi ? CANFD_ESI : 0);
+        }
+        memcpy(frame->data, can_payload, payload_length);
 
-            if (eff) {
-              fprintf(stdout, "(000000.000000) elmcan 0000%03lx#%s\n", can_frame_id, stdout_string);
-            } else {
-              fprintf(stdout, "(000000.000000) elmcan %03lx#%s\n", can_frame_id, stdout_string);
+        if (use_stdout) {
+            if (candump_writer_put(&stdout_writer, frame, fdf) < 0) {
+                return -1;
             }
-            fflush(stdout);
         } else {
-            frame.can_id = (canid_t) can_frame_id;
-            if (eff) {
-              frame.can_id |= CAN_EFF_FLAG;
-            }
-            frame.can_dlc = payload_length;
-            memcpy(frame.data, can_payload, payload_length);
-            if (write(can_socket, &frame, sizeof(struct can_frame)) != sizeof(struct can_frame)) {
+            batch_io_commit(bus->batch, fdf ? CANFD_MTU : CAN_MTU);
+        }
+    }
+
+    if (use_stdout) {
+        if (candump_writer_flush(&stdout_writer) < 0) {
+            return -1;
+        }
+    } else {
+        for (i = 0; i < num_buses; i++) {
+            if (send_frames(&buses[i]) < 0) {
                 return 1;
             }
         }
+        if (default_bus.fd > 0 && send_frames(&default_bus) < 0) {
+            return 1;
+        }
+    }
+
+    if (res < 0) {
+        fprintf(stderr, "Error: Truncated ACF message.\n");
+        return -1;
     }
+
     return 1;
 }
 
+static int handle_tscf(const Avtp_PduView_t* view, void* ctx)
+{
+    return handle_acf_messages(Avtp_PduView_Tail(view, AVTP_TSCF_HEADER_LEN));
+}
+
+static int handle_ntscf(const Avtp_PduView_t* view, void* ctx)
+{
+    return handle_acf_messages(Avtp_PduView_Tail(view, AVTP_NTSCF_HEADER_LEN));
+}
+
+static int handle_unexpected_subtype(const Avtp_PduView_t* view, void* ctx)
+{
+    fprintf(stderr, "Subtype mismatch: expected %u or %u, got %u. Dropping packet\n",
+            AVTP_SUBTYPE_NTSCF, AVTP_SUBTYPE_TSCF, view->base[0]);
+    return -1;
+}
+
+static int new_packet(uint8_t* pdu, size_t len) {
+
+    int res;
+    uint64_t udp_seq_num = 0;
+    Avtp_PduView_t frame_view, cf_view;
+
+    if (len > MAX_PDU_SIZE) {
+        fprintf(stderr, "Error: Received frame exceeds %d bytes.\n", MAX_PDU_SIZE);
+        return -1;
+    }
+
+    if (Avtp_PduView_Init(&frame_view, pdu, len) < 0) {
+        fprintf(stderr, "Error: Invalid frame. Dropping packet\n");
+        return -1;
+    }
+
+    if (use_udp) {
+        if (frame_view.len < AVTP_UDP_HEADER_LEN) {
+            fprintf(stderr, "Error: Truncated UDP encapsulation header.\n");
+            return -1;
+        }
+        Avtp_UDP_GetField((Avtp_UDP_t *) pdu, AVTP_UDP_FIELD_ENCAPSULATION_SEQ_NO, &udp_seq_num);
+        cf_view = Avtp_PduView_Tail(&frame_view, AVTP_UDP_HEADER_LEN);
+    } else {
+        cf_view = frame_view;
+    }
+
+    // Validates the control format header and invokes the handler of the subtype
+    res = Avtp_Dispatcher_Dispatch(&dispatcher, cf_view.base, cf_view.len);
+    if (res == -EINVAL) {
+        fprintf(stderr, "Error: Truncated or invalid control format PDU.\n");
+        return -1;
+    }
+
+    return res;
+}
+
 int main(int argc, char *argv[])
 {
     int sk_fd, res;
     struct pollfd fds;
+    struct rx_ring* ring;
+    uint8_t* frame;
+    size_t len;
 
-    int can_socket = 0;
-    struct sockaddr_can can_addr;
-    struct ifreq ifr;
+    int i;
 
+    can_id_filter_init(&id_filter);
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-    // Open a CAN socket for reading frames if required
-    if (strcmp(can_ifname, "STDOUT\0")) {
-        can_socket = socket(PF_CAN, SOCK_RAW, CAN_RAW);
-        if (can_socket < 0)
+    if (can_id_filter_compile(&id_filter) < 0) {
+        fprintf(stderr, "Failed to compile CAN filter\n");
+        return 1;
+    }
+
+    // Open a CAN socket for writing frames of each bus
+    for (i = 0; i < num_buses; i++) {
+        buses[i].fd = create_can_socket(buses[i].ifname);
+        if (buses[i].fd < 0)
             return 1;
 
-        strcpy(ifr.ifr_name, can_ifname);
-        ioctl(can_socket, SIOCGIFINDEX, &ifr);
+        buses[i].batch = batch_io_alloc(CAN_BATCH_SIZE, sizeof(struct canfd_frame), 0);
+        if (!buses[i].batch)
+            return 1;
+    }
 
-        memset(&can_addr, 0, sizeof(can_addr));
-        can_addr.can_family = AF_CAN;
-        can_addr.can_ifindex = ifr.ifr_ifindex;
-        if (bind(can_socket, (struct sockaddr *)&can_addr, sizeof(can_addr)) < 0)
+    // A CAN interface given without bus ID receives the frames of all other
+    // bus IDs. Without any CAN interface, frames are written to STDOUT.
+    if (strcmp(can_ifname, "STDOUT\0")) {
+        snprintf(default_bus.ifname, sizeof(default_bus.ifname), "%s", can_ifname);
+        default_bus.fd = create_can_socket(default_bus.ifname);
+        if (default_bus.fd < 0)
             return 1;
+
+        default_bus.batch = batch_io_alloc(CAN_BATCH_SIZE, sizeof(struct canfd_frame), 0);
+        if (!default_bus.batch)
+            return 1;
+    } else if (num_buses == 0) {
+        use_stdout = 1;
     }
 
+    candump_writer_init(&stdout_writer, STDOUT_FILENO);
+
+    Avtp_Dispatcher_Init(&dispatcher);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_NTSCF, handle_ntscf, NULL);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_TSCF, handle_tscf, NULL);
+    Avtp_Dispatcher_SetDefault(&dispatcher, handle_unexpected_subtype, NULL);
+
     if (use_udp) {
         sk_fd = create_listener_socket_udp(udp_port);
     } else {
         sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
     }
-    fds.fd = sk_fd;
-    fds.events = POLLIN;
-
     if (sk_fd < 0)
         return 1;
 
+    // UDP sockets have no ring, they fall back to recv() behind the same API
+    ring = rx_ring_alloc(sk_fd, RX_RING_BLOCK_SIZE, RX_RING_NUM_BLOCKS, RX_RING_RETIRE_MS);
+    if (!ring) {
+        close(sk_fd);
+        return 1;
+    }
+
+    fds.fd = sk_fd;
+    fds.events = POLLIN;
+
     while (1) {
 
         res = poll(&fds, 1, -1);
@@ -328,7 +491,11 @@ int main(int argc, char *argv[])
         }
 
         if (fds.revents & POLLIN) {
-            res = new_packet(sk_fd, can_socket);
+            while ((res = rx_ring_next(ring, &frame, &len)) > 0) {
+                res = new_packet(frame, len);
+                if (res < 0)
+                    goto err;
+            }
             if (res < 0)
                 goto err;
         }
@@ -338,6 +505,12 @@ int main(int argc, char *argv[])
     return 0;
 
 err:
+    for (i = 0; i < num_buses; i++) {
+        batch_io_free(buses[i].batch);
+        close(buses[i].fd);
+    }
+    batch_io_free(default_bus.batch);
+    rx_ring_free(ring);
     close(sk_fd);
     return 1;
 
@@ -33,7 +33,10 @@
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <errno.h>
 #include <time.h>
+#include <inttypes.h>
 
 #include <arpa/inet.h>
 #include <stdlib.h>
@@ -41,18 +44,29 @@
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
-#include <time.h>
 
 #include "common/common.h"
+#include "common/packet_ring.h"
+#include "common/candump.h"
 #include "avtp/Udp.h"
 #include "avtp/acf/Ntscf.h"
 #include "avtp/acf/Tscf.h"
 #include "avtp/acf/Can.h"
+#include "avtp/acf/CanBrief.h"
+#include "avtp/acf/Packer.h"
 #include "avtp/CommonHeader.h"
 
 #define MAX_PDU_SIZE                1500
 #define STREAM_ID                   0xAABBCCDDEEFF0001
 #define CAN_PAYLOAD_MAX_SIZE        16*4
+#define DEFAULT_LATENCY_USEC        1000
+#define NSEC_PER_USEC               1000ULL
+#define NSEC_PER_MSEC               1000000ULL
+#define NSEC_PER_SEC                1000000000ULL
+#define CAN_BUS_QUANTUM             16
+#define MAX_CAN_BUSES               32
+#define MAX_FAIR_ROUNDS             4
+#define STDIN_EVENT                 UINT32_MAX
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
@@ -62,8 +76,33 @@ static int priority = -1;
 static uint8_t seq_num = 0;
 static uint8_t use_tscf;
 static uint8_t use_udp;
+static uint8_t use_brief;
+static uint8_t qdisc_bypass;
 static uint8_t multi_can_frames = 1;
+static uint32_t latency_usec = DEFAULT_LATENCY_USEC;
 static char can_ifname[IFNAMSIZ] = "STDIN\0";
+static struct candump_reader stdin_reader;
+
+/* CAN interface whose frames are tagged with an ACF CAN bus ID */
+struct can_bus {
+    uint8_t bus_id;
+    char ifname[IFNAMSIZ];
+    int fd;
+    struct batch_io* batch;
+};
+
+static struct can_bus buses[MAX_CAN_BUSES];
+static int num_buses;
+
+/* Outgoing IEEE 1722 stream into which the CAN frames are packed */
+struct acf_stream {
+    struct tx_ring* ring;
+    uint8_t* pdu;
+    uint8_t* cf_pdu;
+    Avtp_AcfPacker_t packer;
+    uint16_t max_msgs;
+    uint64_t latency;
+};
 
 static char doc[] = "\nacf-can-talker -- a program designed to send CAN messages to \
                     a remote CAN bus over Ethernet using Open1722 \
@@ -72,17 +111,27 @@ static char doc[] = "\nacf-can-talker -- a program designed to send CAN messages
                     \n\n    (tunnel transactions from STDIN to a remote CAN bus over Ethernet)\
                     \n\n  acf-can-talker --count 10 eth0 aa:bb:cc:ee:dd:ff\
                     \n\n    (as above, but pack 10 CAN frames in one Ethernet frame)\
+                    \n\n  acf-can-talker --count 10 --latency 500 eth0 aa:bb:cc:ee:dd:ff\
+                    \n\n    (as above, but send a partially filled frame after 500 us)\
+                    \n\n  acf-can-talker --brief eth0 aa:bb:cc:ee:dd:ff can1\
+                    \n\n    (as above, but use CAN Brief messages without timestamp)\
                     \n\n  acf-can-talker -u 10.0.0.2:17220 vcan1\
                     \n\n    (tunnel transactions from can1 interface to a remote CAN bus over IP)\
                     \n\n  candump can1 | acf-can-talker -u 10.0.0.2:17220\
-                    \n\n    (another method to tunnel transactions from vcan1 to a remote CAN bus)";
+                    \n\n    (another method to tunnel transactions from vcan1 to a remote CAN bus)\
+                    \n\n  acf-can-talker -u --bus 0=can0 --bus 1=can1 10.0.0.2:17220\
+                    \n\n    (tunnel transactions from can0 and can1 in one stream, tagged with bus IDs 0 and 1)";
 
 static char args_doc[] = "[ifname] dst-mac-address/dst-nw-address:port [can ifname]";
 
 static struct argp_option options[] = {            
     {"tscf", 't', 0, 0, "Use TSCF"},
     {"udp",  'u', 0, 0, "Use UDP" },
+    {"qdisc-bypass", 'q', 0, 0, "Bypass the qdisc layer (If Ethernet, no traffic shaping)"},
+    {"brief", 'b', 0, 0, "Use CAN Brief messages (no message timestamp)"},
     {"count", 'c', "COUNT", 0, "Set count of CAN messages per Ethernet frame"},
+    {"bus", 'B', "ID=CAN_IFNAME", 0, "Read CAN frames from CAN_IFNAME and send them with CAN bus ID (0-31), may be repeated"},
+    {"latency", 'l', "USEC", 0, "Maximum time a CAN message waits for further messages before the frame is sent (default 1000, 0 waits for COUNT messages)"},
     {"can ifname", 0, 0, OPTION_DOC, "CAN interface (set to STDIN by default)"},
     {"ifname", 0, 0, OPTION_DOC, "Network interface (If Ethernet)"},
     {"dst-mac-address", 0, 0, OPTION_DOC, "Stream destination MAC address (If Ethernet)"},
@@ -102,12 +151,34 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'u':
         use_udp = 1;
         break;
+    case 'q':
+        qdisc_bypass = 1;
+        break;
+    case 'b':
+        use_brief = 1;
+        break;
     case 'c':
         multi_can_frames = atoi(arg);
         break;
+    case 'l':
+        latency_usec = atoi(arg);
+        break;
+    case 'B':
+        if (num_buses == MAX_CAN_BUSES)
+            argp_error(state, "At most %d CAN buses are supported", MAX_CAN_BUSES);
+        if (parse_can_bus_mapping(arg, &buses[num_buses].bus_id, buses[num_buses].ifname,
+                                  sizeof(buses[num_buses].ifname)) < 0)
+            argp_usage(state);
+        for (int i = 0; i < num_buses; i++) {
+            if (buses[i].bus_id == buses[num_buses].bus_id)
+                argp_error(state, "CAN bus ID %u is used twice", buses[i].bus_id);
+        }
+        num_buses++;
+        break;
 
     case ARGP_KEY_NO_ARGS:
         argp_usage(state);
+        break;
 
     case ARGP_KEY_ARG:
 
@@ -180,98 +251,282 @@ static int init_cf_pdu(uint8_t* pdu)
     return res;
 }
 
-static int update_pdu_length(uint8_t* pdu, uint64_t length)
-{
-    if (use_tscf) {
-        uint64_t payloadLen = length - AVTP_TSCF_HEADER_LEN;
-        Avtp_Tscf_SetField((Avtp_Tscf_t*)pdu, AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, payloadLen);
+static int prepare_acf_packet(uint8_t* acf_pdu, struct canfd_frame* frame,
+                              Can_Variant_t can_variant, uint8_t bus_id,
+                              uint64_t timestamp) {
+
+    int processedBytes;
+    uint8_t eff = (frame->can_id & CAN_EFF_FLAG) ? 1 : 0;
+    uint32_t can_frame_id = frame->can_id & (eff ? CAN_EFF_MASK : CAN_SFF_MASK);
+    uint8_t brs = (can_variant == CAN_FD && (frame->flags & CANFD_BRS)) ? 1 : 0;
+    uint8_t esi = (can_variant == CAN_FD && (frame->flags & CANFD_ESI)) ? 1 : 0;
+
+    if (use_brief) {
+        Avtp_CanBrief_t* pdu = (Avtp_CanBrief_t*) acf_pdu;
+
+        // Prepare ACF PDU for CAN Brief
+        Avtp_CanBrief_Init(pdu);
+
+        // Copy payload to ACF CAN Brief PDU
+        processedBytes = Avtp_CanBrief_SetPayload(pdu, can_frame_id, frame->data,
+                                                  frame->len, can_variant);
+        Avtp_CanBrief_SetEff(pdu, eff);
+        Avtp_CanBrief_SetBrs(pdu, brs);
+        Avtp_CanBrief_SetEsi(pdu, esi);
+        Avtp_CanBrief_SetCanBusId(pdu, bus_id);
     } else {
-        uint64_t payloadLen = length - AVTP_NTSCF_HEADER_LEN;
-        Avtp_Ntscf_SetField((Avtp_Ntscf_t*)pdu, AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, payloadLen);
+        Avtp_Can_t* pdu = (Avtp_Can_t*) acf_pdu;
+
+        // Clear bits
+        memset(pdu, 0, AVTP_CAN_HEADER_LEN);
+
+        // Prepare ACF PDU for CAN
+        Avtp_Can_Init(pdu);
+        Avtp_Can_SetField(pdu, AVTP_CAN_FIELD_MESSAGE_TIMESTAMP, timestamp);
+        Avtp_Can_SetField(pdu, AVTP_CAN_FIELD_MTV, 1U);
+
+        // Copy payload to ACF CAN PDU
+        processedBytes = Avtp_Can_SetPayload(pdu, can_frame_id, frame->data,
+                                             frame->len, can_variant);
+        Avtp_Can_SetEff(pdu, eff);
+        Avtp_Can_SetBrs(pdu, brs);
+        Avtp_Can_SetEsi(pdu, esi);
+        Avtp_Can_SetCanBusId(pdu, bus_id);
     }
-    return 0;
+
+    return processedBytes;
 }
 
-static int prepare_acf_packet(uint8_t* acf_pdu,
-                          uint8_t* payload, uint8_t length,
-                          uint32_t can_frame_id) {
+static uint64_t timespec_to_ns(const struct timespec* ts)
+{
+    return (uint64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
 
-    int processedBytes;
-    struct timespec now;
-    Avtp_Can_t* pdu = (Avtp_Can_t*) acf_pdu;
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
 
-    // Clear bits
-    memset(pdu, 0, AVTP_CAN_HEADER_LEN);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
 
-    // Prepare ACF PDU for CAN
-    Avtp_Can_Init(pdu);
-    clock_gettime(CLOCK_REALTIME, &now);
-    Avtp_Can_SetField(pdu, AVTP_CAN_FIELD_MESSAGE_TIMESTAMP, (uint64_t)now.tv_nsec + (uint64_t)(now.tv_sec * 1e9));
-    Avtp_Can_SetField(pdu, AVTP_CAN_FIELD_MTV, 1U);
+    return timespec_to_ns(&ts);
+}
 
-    // Copy payload to ACF CAN PDU
-    processedBytes = Avtp_Can_SetPayload(pdu, can_frame_id, payload, length, CAN_CLASSIC);
+/*
+ * Compute the epoll_wait() timeout in ms until the deadline of the packed
+ * frame, rounded up so the deadline has passed on wakeup.
+ */
+static int get_timeout_ms(Avtp_AcfPacker_t* packer)
+{
+    uint64_t deadline = Avtp_AcfPacker_GetDeadline(packer);
+    uint64_t now = now_ns();
 
-    return processedBytes;
+    if (deadline == AVTP_ACF_PACKER_NO_DEADLINE) {
+        return -1;
+    }
+
+    if (deadline <= now) {
+        return 0;
+    }
+
+    return (deadline - now + NSEC_PER_MSEC - 1) / NSEC_PER_MSEC;
 }
 
-static int get_payload(int can_socket, uint8_t* payload, uint32_t *frame_id, uint8_t *length) {
+/* Reserve the next frame in the transmit ring and start packing into it. */
+static int start_pdu(struct acf_stream* stream)
+{
+    int res;
+
+    stream->pdu = tx_ring_reserve(stream->ring);
+    if (!stream->pdu)
+        return -1;
 
-    char stdin_str[1000];
-    char can_str[10];
-    char can_payload[1000];
-    char *token;
-    size_t n;
+    if (use_udp) {
+        Avtp_UDP_SetEncapsulationSeqNo((Avtp_UDP_t *) stream->pdu, seq_num);
+        stream->cf_pdu = stream->pdu + AVTP_UDP_HEADER_LEN;
+    } else {
+        stream->cf_pdu = stream->pdu;
+    }
+
+    res = init_cf_pdu(stream->cf_pdu);
+    if (res < 0)
+        return res;
+
+    return Avtp_AcfPacker_Init(&stream->packer, stream->cf_pdu,
+                               MAX_PDU_SIZE - (stream->cf_pdu - stream->pdu),
+                               stream->max_msgs, stream->latency);
+}
+
+/*
+ * Queue the packed frame, if any, and start the next one. The queued frames
+ * are handed to the kernel with tx_ring_flush().
+ */
+static int flush_pdu(struct acf_stream* stream)
+{
+    uint32_t pdu_length;
+
+    pdu_length = Avtp_AcfPacker_Finalize(&stream->packer);
+    if (pdu_length == 0)
+        return 0;
+    pdu_length += stream->cf_pdu - stream->pdu;
+
+    tx_ring_commit(stream->ring, pdu_length);
+
+    return start_pdu(stream);
+}
+
+/*
+ * Append a CAN frame to the stream, sending the packed frame when full. The
+ * timestamp is the CLOCK_REALTIME reception time of the frame in ns.
+ */
+static int pack_can_frame(struct acf_stream* stream, struct canfd_frame* frame,
+                          Can_Variant_t can_variant, uint8_t bus_id,
+                          uint64_t timestamp)
+{
     int res;
-	struct can_frame frame;
+    uint8_t* acf_pdu;
+    uint16_t msg_len = (use_brief ? AVTP_CAN_BRIEF_HEADER_LEN : AVTP_CAN_HEADER_LEN) +
+                       CAN_PAYLOAD_MAX_SIZE;
+
+    // Flush first if the frame has no room for another message
+    acf_pdu = Avtp_AcfPacker_Reserve(&stream->packer, msg_len);
+    if (acf_pdu == NULL) {
+        res = flush_pdu(stream);
+        if (res < 0)
+            return res;
+        acf_pdu = Avtp_AcfPacker_Reserve(&stream->packer, msg_len);
+    }
 
-    if (can_socket == 0) {
-        n = read(STDIN_FILENO, stdin_str, 1000);
-        if (n < 0) {
-            return -1;
-        }
+    res = prepare_acf_packet(acf_pdu, frame, can_variant, bus_id, timestamp);
+    if (res < 0)
+        return res;
 
-        res = sscanf(stdin_str, "%s %x [%hhu] %[0-9A-F ]s", can_str, frame_id,
-                                                        length, can_payload);
-        if (res < 0) {
-            return -1;
-        }
+    res = Avtp_AcfPacker_Commit(&stream->packer, res, now_ns());
+    if (res < 0)
+        return res;
+
+    if (res > 0)
+        return flush_pdu(stream);
 
-        token = strtok(can_payload, " ");
-        int index = 0;
-        while (token != NULL) {
-            payload[index++] = (unsigned short)strtol(token, NULL, 16);
-            token = strtok(NULL, " ");
+    return 0;
+}
+
+/*
+ * Receive up to CAN_BUS_QUANTUM frames of a CAN bus with a single recvmmsg()
+ * and pack them. The message timestamps are the kernel receive timestamps of
+ * the frames. Only if the kernel did not provide one, the clock is read, once
+ * per batch.
+ */
+static int pack_can_batch(struct acf_stream* stream, struct can_bus* bus)
+{
+    int res, n, i;
+    size_t len;
+    struct canfd_frame* frame;
+    struct timespec ts;
+    uint64_t batch_time = 0;
+    uint64_t timestamp;
+
+    n = batch_io_recv(bus->fd, bus->batch, MSG_DONTWAIT);
+    if (n < 0)
+        return -1;
+
+    for (i = 0; i < n; i++) {
+        frame = (struct canfd_frame*) batch_io_get(bus->batch, i, &len);
+        if (len != CAN_MTU && len != CANFD_MTU) {
+            fprintf(stderr, "Dropping incomplete CAN frame\n");
+            continue;
         }
-    } else {
-        n = read(can_socket, &frame, sizeof(struct can_frame));
-        if (n > 0) {
-            *frame_id = (uint32_t) frame.can_id;
-            *length = (uint8_t) frame.can_dlc;
-            memcpy(payload, frame.data, (size_t) *length);
+
+        if (batch_io_get_timestamp(bus->batch, i, &ts) == 0) {
+            timestamp = timespec_to_ns(&ts);
+        } else {
+            if (batch_time == 0) {
+                clock_gettime(CLOCK_REALTIME, &ts);
+                batch_time = timespec_to_ns(&ts);
+            }
+            timestamp = batch_time;
         }
+
+        res = pack_can_frame(stream, frame, len == CANFD_MTU ? CAN_FD : CAN_CLASSIC,
+                             bus->bus_id, timestamp);
+        if (res < 0)
+            return res;
     }
-    
+
     return n;
 }
 
+/*
+ * Read the next chunk of candump lines from STDIN and pack all complete
+ * frames. All frames of a chunk share one timestamp. Returns 0 at the end of
+ * the input.
+ */
+static int pack_stdin(struct acf_stream* stream)
+{
+    int res, is_fd;
+    ssize_t n;
+    struct canfd_frame frame;
+    struct timespec ts;
+    uint64_t timestamp;
+
+    n = candump_reader_fill(&stdin_reader);
+    if (n < 0)
+        return n;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    timestamp = timespec_to_ns(&ts);
+
+    while (candump_reader_next(&stdin_reader, &frame, &is_fd) > 0) {
+        res = pack_can_frame(stream, &frame, is_fd ? CAN_FD : CAN_CLASSIC, 0, timestamp);
+        if (res < 0)
+            return res;
+    }
+
+    return n > 0;
+}
+
+/*
+ * Serve all CAN buses which are ready in turns of CAN_BUS_QUANTUM frames, so
+ * that a busy bus cannot starve the others. Buses with more frames pending
+ * are served again for up to MAX_FAIR_ROUNDS turns, the remaining frames are
+ * picked up on the next wakeup.
+ */
+static int pack_ready_buses(struct acf_stream* stream, struct can_bus** ready,
+                            int num_ready)
+{
+    int round, i, n, num_pending;
+
+    for (round = 0; round < MAX_FAIR_ROUNDS && num_ready > 0; round++) {
+        num_pending = 0;
+        for (i = 0; i < num_ready; i++) {
+            n = pack_can_batch(stream, ready[i]);
+            if (n < 0)
+                return n;
+            if (n == CAN_BUS_QUANTUM)
+                ready[num_pending++] = ready[i];
+        }
+        num_ready = num_pending;
+    }
+
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
 
-    int fd, res;
+    int fd, res, i, n;
     struct sockaddr_ll sk_ll_addr;
     struct sockaddr_in sk_udp_addr;
-    uint8_t pdu[MAX_PDU_SIZE];
+    struct acf_stream stream = { 0 };
 
-    uint8_t payload[CAN_PAYLOAD_MAX_SIZE];
-    uint8_t payload_length = 0;
-    uint32_t frame_id = 0;
     uint8_t num_acf_msgs = 1;
-    uint32_t pdu_length;
-
-    int can_socket = 0;
-	struct sockaddr_can can_addr;
-	struct ifreq ifr;
+    int epoll_fd = -1;
+    int stdin_always_ready = 0;
+    int timeout_ms;
+    struct epoll_event ev;
+    struct epoll_event events[MAX_CAN_BUSES + 1];
+    struct can_bus* ready[MAX_CAN_BUSES];
+    int num_ready;
+    int stdin_ready;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -285,96 +540,162 @@ int main(int argc, char *argv[])
 
     num_acf_msgs = multi_can_frames;
 
-    // Open a CAN socket for reading frames if required
+    // A CAN interface given without bus ID is sent as bus 0
     if (strcmp(can_ifname, "STDIN\0")) {
-        can_socket = socket(PF_CAN, SOCK_RAW, CAN_RAW);
-        if (can_socket < 0)
-            return 1;
-
-        strcpy(ifr.ifr_name, can_ifname);
-        ioctl(can_socket, SIOCGIFINDEX, &ifr);
-
-        memset(&can_addr, 0, sizeof(can_addr));
-        can_addr.can_family = AF_CAN;
-        can_addr.can_ifindex = ifr.ifr_ifindex;
-        if (bind(can_socket, (struct sockaddr *)&can_addr, sizeof(can_addr)) < 0) 
-            return 1;
+        for (i = 0; i < num_buses; i++) {
+            if (buses[i].bus_id == 0) {
+                fprintf(stderr, "CAN bus ID 0 is used twice\n");
+                goto err;
+            }
+        }
+        if (num_buses == MAX_CAN_BUSES) {
+            fprintf(stderr, "At most %d CAN buses are supported\n", MAX_CAN_BUSES);
+            goto err;
+        }
+        buses[num_buses].bus_id = 0;
+        strcpy(buses[num_buses].ifname, can_ifname);
+        num_buses++;
+    }
+
+    epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0) {
+        perror("Failed to create epoll instance");
+        goto err;
     }
 
+    // Open a CAN socket for reading frames of each bus
+    for (i = 0; i < num_buses; i++) {
+        buses[i].fd = create_can_socket(buses[i].ifname);
+        if (buses[i].fd < 0)
+            goto err;
+
+        // Take the message timestamps from the kernel at reception
+        enable_rx_timestamps(buses[i].fd);
+
+        buses[i].batch = batch_io_alloc(CAN_BUS_QUANTUM, sizeof(struct canfd_frame),
+                                        BATCH_IO_TIMESTAMP_CONTROL_SIZE);
+        if (!buses[i].batch)
+            goto err;
+
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, buses[i].fd, &ev) < 0) {
+            perror("Failed to add CAN socket to epoll");
+            goto err;
+        }
+    }
+
+    // Without CAN interfaces the frames are read from STDIN. Regular files
+    // cannot be polled, they are always ready.
+    if (num_buses == 0) {
+        candump_reader_init(&stdin_reader, STDIN_FILENO);
+        ev.events = EPOLLIN;
+        ev.data.u32 = STDIN_EVENT;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, STDIN_FILENO, &ev) < 0) {
+            if (errno != EPERM) {
+                perror("Failed to add STDIN to epoll");
+                goto err;
+            }
+            stdin_always_ready = 1;
+        }
+    }
 
     if (use_udp) {
         res = setup_udp_socket_address((struct in_addr*) ip_addr,
                                        udp_port, &sk_udp_addr);
         if (res < 0)
             goto err;
+        stream.ring = tx_ring_alloc(fd, (struct sockaddr *) &sk_udp_addr, sizeof(sk_udp_addr),
+                                    MAX_PDU_SIZE, TX_RING_NUM_FRAMES, 0);
     } else {
         res = setup_socket_address(fd, ifname, macaddr, ETH_P_TSN, &sk_ll_addr);
         if (res < 0)
             goto err;
+        stream.ring = tx_ring_alloc(fd, (struct sockaddr *) &sk_ll_addr, sizeof(sk_ll_addr),
+                                    MAX_PDU_SIZE, TX_RING_NUM_FRAMES, qdisc_bypass);
+    }
+    if (!stream.ring)
+        goto err;
+
+    // Pack into control formats, in place in the transmit ring
+    stream.max_msgs = num_acf_msgs;
+    stream.latency = latency_usec * NSEC_PER_USEC;
+    res = start_pdu(&stream);
+    if (res < 0) {
+        fprintf(stderr, "Failed to initialize ACF packer\n");
+        goto err;
     }
 
     // Sending loop
     for(;;) {
 
-        // Pack into control formats
-        uint8_t *cf_pdu;
-        pdu_length = 0;
+        // Wait for the next CAN frame, but not beyond the deadline of the
+        // frames already packed
+        timeout_ms = stdin_always_ready ? 0 : get_timeout_ms(&stream.packer);
+        n = epoll_wait(epoll_fd, events, MAX_CAN_BUSES + 1, timeout_ms);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to epoll_wait()");
+            goto err;
+        }
 
-        if (use_udp) {
-            Avtp_UDP_t *udp_pdu = (Avtp_UDP_t *) pdu;
-            Avtp_UDP_SetField(udp_pdu, AVTP_UDP_FIELD_ENCAPSULATION_SEQ_NO,
-                              seq_num);
-            cf_pdu = &pdu[sizeof(Avtp_UDP_t)];
-        } else {
-            cf_pdu = pdu;
+        num_ready = 0;
+        stdin_ready = stdin_always_ready;
+        for (i = 0; i < n; i++) {
+            if (events[i].data.u32 == STDIN_EVENT) {
+                stdin_ready = 1;
+            } else {
+                ready[num_ready++] = &buses[events[i].data.u32];
+            }
         }
 
-        res = init_cf_pdu(cf_pdu);
+        res = pack_ready_buses(&stream, ready, num_ready);
         if (res < 0)
             goto err;
-        pdu_length += res;
-
-        int i = 0;
-        while (i < num_acf_msgs) {
-            // Get payload -- will 'spin' here until we get the requested number
-            //                of CAN frames.
-            res = get_payload(can_socket, payload, &frame_id, &payload_length);
-            if (!res) {
-                continue;
-            }
 
-            uint8_t* acf_pdu = cf_pdu + pdu_length;
-            res = prepare_acf_packet(acf_pdu, payload, payload_length, frame_id);
+        if (stdin_ready) {
+            res = pack_stdin(&stream);
             if (res < 0)
                 goto err;
-            pdu_length += res;
-
-            i++;
+            if (res == 0)
+                break;
         }
-        
-        res = update_pdu_length(cf_pdu, pdu_length);
-        if (res < 0)
-            goto err;
 
-        if (use_udp) {
-            pdu_length += sizeof(uint32_t);
-            res = sendto(fd, pdu, pdu_length, 0,
-                    (struct sockaddr *) &sk_udp_addr, sizeof(sk_udp_addr));
-            if (res < 0) {
-                perror("Failed to send data");
-                goto err;
-            }
-        } else {
-            res = sendto(fd, pdu, pdu_length, 0,
-                         (struct sockaddr *) &sk_ll_addr, sizeof(sk_ll_addr));
-            if (res < 0) {
-                perror("Failed to send data");
+        if (Avtp_AcfPacker_IsDue(&stream.packer, now_ns())) {
+            res = flush_pdu(&stream);
+            if (res < 0)
                 goto err;
-            }
         }
+
+        // Kick the kernel once for all frames completed in this round
+        if (tx_ring_flush(stream.ring) < 0)
+            goto err;
+    }
+
+    // End of input, send what is left
+    res = flush_pdu(&stream);
+    if (res < 0 || tx_ring_flush(stream.ring) < 0)
+        goto err;
+
+    if (stdin_reader.invalid_lines > 0) {
+        fprintf(stderr, "Skipped %"PRIu64" invalid lines\n", stdin_reader.invalid_lines);
     }
 
+    tx_ring_free(stream.ring);
+    close(epoll_fd);
+    close(fd);
+    return 0;
+
 err:
+    for (i = 0; i < num_buses; i++) {
+        batch_io_free(buses[i].batch);
+        if (buses[i].fd > 0)
+            close(buses[i].fd);
+    }
+    tx_ring_free(stream.ring);
+    if (epoll_fd >= 0)
+        close(epoll_fd);
     close(fd);
     return 1;
 
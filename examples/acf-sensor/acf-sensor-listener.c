@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * This example implements an ACF Sensor listener. It receives IEEE 1722
+ * frames carrying ACF Sensor and Sensor Brief messages and prints one line
+ * per message to STDOUT: the message timestamp (Sensor messages only), the
+ * sensor group and the samples as signed integers. Run 'acf-sensor-listener
+ * --help' for more information.
+ */
+
+#include <argp.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/if.h>
+
+#include "common/common.h"
+#include "common/packet_ring.h"
+#include "avtp/Udp.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/acf/Common.h"
+#include "avtp/acf/Sensor.h"
+#include "avtp/acf/SensorBrief.h"
+#include "avtp/acf/Iterator.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/PduView.h"
+#include "avtp/Dispatcher.h"
+
+#define MAX_PDU_SIZE                1500
+#define NSEC_PER_SEC                UINT64_C(1000000000)
+
+static char ifname[IFNAMSIZ];
+static uint8_t macaddr[ETH_ALEN];
+static uint8_t use_udp;
+static uint32_t udp_port = 17220;
+static Avtp_Dispatcher_t dispatcher;
+
+static char doc[] = "\nacf-sensor-listener -- a program designed to receive sensor readings \
+                    over Ethernet using Open1722. Both ACF Sensor and ACF Sensor Brief \
+                    messages are accepted. \
+                    \vEXAMPLES\
+                    \n\n  acf-sensor-listener eth0 aa:bb:cc:dd:ee:ff\
+                    \n\n    (print the sensor messages received from eth0)\
+                    \n\n  acf-sensor-listener -up 17220\
+                    \n\n    (print the sensor messages received over UDP on port 17220)";
+
+static char args_doc[] = "[ifname] dst-mac-address";
+
+static struct argp_option options[] = {
+    {"port", 'p', "UDP_PORT", 0, "UDP Port to listen on if UDP enabled"},
+    {"udp", 'u', 0, 0, "Use UDP"},
+    {"dst-mac-address", 0, 0, OPTION_DOC, "Stream destination MAC address (If Ethernet)"},
+    {"ifname", 0, 0, OPTION_DOC, "Network interface (If Ethernet)" },
+    { 0 }
+};
+
+static error_t parser(int key, char *arg, struct argp_state *state)
+{
+    int res;
+
+    switch (key) {
+    case 'p':
+        udp_port = atoi(arg);
+        break;
+    case 'u':
+        use_udp = 1;
+        break;
+
+    case ARGP_KEY_NO_ARGS:
+        if (!use_udp)
+            argp_usage(state);
+        break;
+
+    case ARGP_KEY_ARG:
+
+        if (use_udp || state->next >= state->argc)
+            argp_usage(state);
+
+        strncpy(ifname, arg, sizeof(ifname) - 1);
+
+        res = sscanf(state->argv[state->next], "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+                &macaddr[0], &macaddr[1], &macaddr[2],
+                &macaddr[3], &macaddr[4], &macaddr[5]);
+        if (res != 6) {
+            fprintf(stderr, "Invalid MAC address\n\n");
+            argp_usage(state);
+        }
+        state->next = state->argc;
+
+        break;
+    }
+
+    return 0;
+}
+
+static struct argp argp = { options, parser, args_doc, doc };
+
+/* Print count samples of the given size as signed integers. */
+static void print_samples(const void* samples, int count, Avtp_SensorSz_t sz)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        switch (sz) {
+        case AVTP_SENSOR_SZ_64BIT:
+            printf(" %" PRId64, ((const int64_t*)samples)[i]);
+            break;
+        case AVTP_SENSOR_SZ_32BIT:
+            printf(" %" PRId32, ((const int32_t*)samples)[i]);
+            break;
+        case AVTP_SENSOR_SZ_16BIT:
+            printf(" %" PRId16, ((const int16_t*)samples)[i]);
+            break;
+        default:
+            printf(" %" PRId8, ((const int8_t*)samples)[i]);
+            break;
+        }
+    }
+    printf("\n");
+}
+
+static int handle_acf_messages(Avtp_PduView_t msgs_view)
+{
+    int res, count;
+    uint64_t timestamp;
+    Avtp_AcfIter_t iter;
+    Avtp_AcfMsg_t msg;
+    uint64_t samples[AVTP_SENSOR_MAX_SAMPLES];
+
+    Avtp_AcfIter_InitMessages(&iter, msgs_view.base, msgs_view.len);
+
+    while ((res = Avtp_AcfIter_Next(&iter, &msg)) > 0) {
+
+        if (msg.msg_type == AVTP_ACF_TYPE_SENSOR) {
+            const Avtp_Sensor_t* pdu = (const Avtp_Sensor_t*)msg.msg_ptr;
+
+            if (msg.msg_len < AVTP_SENSOR_HEADER_LEN ||
+                    (count = Avtp_Sensor_UnpackSamples(pdu, samples, AVTP_SENSOR_MAX_SAMPLES)) < 0) {
+                fprintf(stderr, "Error: Invalid ACF Sensor message.\n");
+                return -1;
+            }
+
+            timestamp = Avtp_Sensor_GetMessageTimestamp(pdu);
+            printf("(%010" PRIu64 ".%09" PRIu64 ") %" PRIu64 ":",
+                   timestamp / NSEC_PER_SEC, timestamp % NSEC_PER_SEC,
+                   Avtp_Sensor_GetSensorGroup(pdu));
+            print_samples(samples, count, Avtp_Sensor_GetSz(pdu));
+        } else if (msg.msg_type == AVTP_ACF_TYPE_SENSOR_BRIEF) {
+            const Avtp_SensorBrief_t* pdu = (const Avtp_SensorBrief_t*)msg.msg_ptr;
+
+            if (msg.msg_len < AVTP_SENSOR_BRIEF_HEADER_LEN ||
+                    (count = Avtp_SensorBrief_UnpackSamples(pdu, samples, AVTP_SENSOR_MAX_SAMPLES)) < 0) {
+                fprintf(stderr, "Error: Invalid ACF Sensor Brief message.\n");
+                return -1;
+            }
+
+            printf("%" PRIu64 ":", Avtp_SensorBrief_GetSensorGroup(pdu));
+            print_samples(samples, count, Avtp_SensorBrief_GetSz(pdu));
+        }
+    }
+
+    // Hand the readings of the whole frame to the consumer at once
+    fflush(stdout);
+
+    if (res < 0) {
+        fprintf(stderr, "Error: Truncated ACF message.\n");
+        return -1;
+    }
+
+    return 1;
+}
+
+static int handle_tscf(const Avtp_PduView_t* view, void* ctx)
+{
+    return handle_acf_messages(Avtp_PduView_Tail(view, AVTP_TSCF_HEADER_LEN));
+}
+
+static int handle_ntscf(const Avtp_PduView_t* view, void* ctx)
+{
+    return handle_acf_messages(Avtp_PduView_Tail(view, AVTP_NTSCF_HEADER_LEN));
+}
+
+static int handle_unexpected_subtype(const Avtp_PduView_t* view, void* ctx)
+{
+    fprintf(stderr, "Subtype mismatch: expected %u or %u, got %u. Dropping packet\n",
+            AVTP_SUBTYPE_NTSCF, AVTP_SUBTYPE_TSCF, view->base[0]);
+    return -1;
+}
+
+static int new_packet(uint8_t* pdu, size_t len)
+{
+    int res;
+    Avtp_PduView_t frame_view, cf_view;
+
+    if (len > MAX_PDU_SIZE) {
+        fprintf(stderr, "Error: Received frame exceeds %d bytes.\n", MAX_PDU_SIZE);
+        return -1;
+    }
+
+    if (Avtp_PduView_Init(&frame_view, pdu, len) < 0) {
+        fprintf(stderr, "Error: Invalid frame. Dropping packet\n");
+        return -1;
+    }
+
+    if (use_udp) {
+        if (frame_view.len < AVTP_UDP_HEADER_LEN) {
+            fprintf(stderr, "Error: Truncated UDP encapsulation header.\n");
+            return -1;
+        }
+        cf_view = Avtp_PduView_Tail(&frame_view, AVTP_UDP_HEADER_LEN);
+    } else {
+        cf_view = frame_view;
+    }
+
+    // Validates the control format header and invokes the handler of the subtype
+    res = Avtp_Dispatcher_Dispatch(&dispatcher, cf_view.base, cf_view.len);
+    if (res == -EINVAL) {
+        fprintf(stderr, "Error: Truncated or invalid control format PDU.\n");
+        return -1;
+    }
+
+    return res;
+}
+
+int main(int argc, char *argv[])
+{
+    int sk_fd, res;
+    struct pollfd fds;
+    struct rx_ring* ring;
+    uint8_t* frame;
+    size_t len;
+
+    argp_parse(&argp, argc, argv, 0, NULL, NULL);
+
+    Avtp_Dispatcher_Init(&dispatcher);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_NTSCF, handle_ntscf, NULL);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_TSCF, handle_tscf, NULL);
+    Avtp_Dispatcher_SetDefault(&dispatcher, handle_unexpected_subtype, NULL);
+
+    if (use_udp) {
+        sk_fd = create_listener_socket_udp(udp_port);
+    } else {
+        sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
+    }
+    if (sk_fd < 0)
+        return 1;
+
+    // UDP sockets have no ring, they fall back to recvmmsg() behind the same API
+    ring = rx_ring_alloc(sk_fd, RX_RING_BLOCK_SIZE, RX_RING_NUM_BLOCKS, RX_RING_RETIRE_MS);
+    if (!ring) {
+        close(sk_fd);
+        return 1;
+    }
+
+    fds.fd = sk_fd;
+    fds.events = POLLIN;
+
+    while (1) {
+
+        res = poll(&fds, 1, -1);
+        if (res < 0) {
+            perror("Failed to poll() fds");
+            goto err;
+        }
+
+        if (fds.revents & POLLIN) {
+            while ((res = rx_ring_next(ring, &frame, &len)) > 0) {
+                res = new_packet(frame, len);
+                if (res < 0)
+                    goto err;
+            }
+            if (res < 0)
+                goto err;
+        }
+    }
+
+    return 0;
+
+err:
+    rx_ring_free(ring);
+    close(sk_fd);
+    return 1;
+}
@@ -0,0 +1,627 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * This example implements an ACF Sensor talker. Each sensor message carries
+ * one reading of all sensors of a sensor group (e.g. the three axes of the
+ * accelerometer and gyroscope of an IMU). The readings are either read from
+ * STDIN, one line of whitespace separated integers per message, or generated
+ * at a fixed rate for testing. Several messages are packed into one IEEE 1722
+ * frame. Run 'acf-sensor-talker --help' for more information.
+ */
+
+#include <linux/if_packet.h>
+#include <linux/if.h>
+#include <linux/if_ether.h>
+#include <arpa/inet.h>
+#include <argp.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/common.h"
+#include "common/packet_ring.h"
+#include "avtp/Udp.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/acf/Sensor.h"
+#include "avtp/acf/SensorBrief.h"
+#include "avtp/acf/Packer.h"
+#include "avtp/CommonHeader.h"
+
+#define MAX_PDU_SIZE                1500
+#define STREAM_ID                   0xAABBCCDDEEFF0002
+#define DEFAULT_NUM_SENSORS         6
+#define DEFAULT_LATENCY_USEC        1000
+#define NSEC_PER_USEC               1000ULL
+#define NSEC_PER_MSEC               1000000ULL
+#define NSEC_PER_SEC                1000000000ULL
+#define MAX_LINE_SIZE               4096
+
+static char ifname[IFNAMSIZ];
+static uint8_t macaddr[ETH_ALEN];
+static uint8_t ip_addr[sizeof(struct in_addr)];
+static uint32_t udp_port = 17220;
+static int priority = -1;
+static uint8_t seq_num = 0;
+static uint8_t use_tscf;
+static uint8_t use_udp;
+static uint8_t use_brief;
+static uint8_t qdisc_bypass;
+static uint8_t sensor_group;
+static Avtp_SensorSz_t sample_sz = AVTP_SENSOR_SZ_16BIT;
+static uint8_t num_sensors = DEFAULT_NUM_SENSORS;
+static uint32_t rate_hz;
+static uint16_t msgs_per_frame = 1;
+static uint32_t latency_usec = DEFAULT_LATENCY_USEC;
+
+/* One reading of all sensors in the sample size selected with --size */
+static union {
+    uint8_t u8[AVTP_SENSOR_MAX_SAMPLES];
+    uint16_t u16[AVTP_SENSOR_MAX_SAMPLES];
+    uint32_t u32[AVTP_SENSOR_MAX_SAMPLES];
+    uint64_t u64[AVTP_SENSOR_MAX_SAMPLES];
+} samples;
+
+/* Lines read from STDIN, which is read with read() so that it can be polled */
+struct line_buffer {
+    char buf[MAX_LINE_SIZE];
+    size_t len;
+};
+
+/* Outgoing IEEE 1722 stream into which the sensor messages are packed */
+struct acf_stream {
+    struct tx_ring* ring;
+    uint8_t* pdu;
+    uint8_t* cf_pdu;
+    Avtp_AcfPacker_t packer;
+    uint16_t max_msgs;
+    uint64_t latency;
+};
+
+static char doc[] = "\nacf-sensor-talker -- a program designed to send sensor readings \
+                    over Ethernet using Open1722 ACF Sensor messages \
+                    \vEXAMPLES\
+                    \n\n  acf-sensor-talker eth0 aa:bb:cc:ee:dd:ff\
+                    \n\n    (send one message per line of integers read from STDIN)\
+                    \n\n  acf-sensor-talker --rate 1000 --count 10 -u 10.0.0.2:17220\
+                    \n\n    (send 1000 readings of 6 generated 16 bit samples per second, 10 per frame)\
+                    \n\n  acf-sensor-talker --size 32 --group 3 --brief -u 10.0.0.2:17220\
+                    \n\n    (send 32 bit samples of sensor group 3 in Sensor Brief messages)";
+
+static char args_doc[] = "[ifname] dst-mac-address/dst-nw-address:port";
+
+static struct argp_option options[] = {
+    {"tscf", 't', 0, 0, "Use TSCF"},
+    {"udp",  'u', 0, 0, "Use UDP" },
+    {"qdisc-bypass", 'q', 0, 0, "Bypass the qdisc layer (If Ethernet, no traffic shaping)"},
+    {"brief", 'b', 0, 0, "Use Sensor Brief messages (no message timestamp)"},
+    {"size", 's', "BITS", 0, "Sample size in bits: 8, 16 (default), 32 or 64"},
+    {"group", 'g', "GROUP", 0, "Sensor group (0-63, default 0)"},
+    {"num-sensors", 'n', "NUM", 0, "Number of generated samples per message (1-127, default 6)"},
+    {"rate", 'r', "HZ", 0, "Generate readings at HZ instead of reading them from STDIN"},
+    {"count", 'c', "COUNT", 0, "Set count of sensor messages per Ethernet frame"},
+    {"latency", 'l', "USEC", 0, "Maximum time a sensor message waits for further messages before the frame is sent (default 1000, 0 waits for COUNT messages)"},
+    {"ifname", 0, 0, OPTION_DOC, "Network interface (If Ethernet)"},
+    {"dst-mac-address", 0, 0, OPTION_DOC, "Stream destination MAC address (If Ethernet)"},
+    {"dst-nw-address:port", 0, 0, OPTION_DOC, "Stream destination network address and port (If UDP)"},
+    { 0 }
+};
+
+static error_t parser(int key, char *arg, struct argp_state *state)
+{
+    int res;
+    char ip_addr_str[100];
+
+    switch (key) {
+    case 't':
+        use_tscf = 1;
+        break;
+    case 'u':
+        use_udp = 1;
+        break;
+    case 'q':
+        qdisc_bypass = 1;
+        break;
+    case 'b':
+        use_brief = 1;
+        break;
+    case 's':
+        switch (atoi(arg)) {
+        case 8:  sample_sz = AVTP_SENSOR_SZ_8BIT; break;
+        case 16: sample_sz = AVTP_SENSOR_SZ_16BIT; break;
+        case 32: sample_sz = AVTP_SENSOR_SZ_32BIT; break;
+        case 64: sample_sz = AVTP_SENSOR_SZ_64BIT; break;
+        default: argp_error(state, "Invalid sample size '%s'", arg);
+        }
+        break;
+    case 'g':
+        res = atoi(arg);
+        if (res < 0 || res > 63)
+            argp_error(state, "Invalid sensor group '%s'", arg);
+        sensor_group = res;
+        break;
+    case 'n':
+        res = atoi(arg);
+        if (res < 1 || res > AVTP_SENSOR_MAX_SAMPLES)
+            argp_error(state, "Invalid number of sensors '%s'", arg);
+        num_sensors = res;
+        break;
+    case 'r':
+        rate_hz = atoi(arg);
+        break;
+    case 'c':
+        msgs_per_frame = atoi(arg);
+        break;
+    case 'l':
+        latency_usec = atoi(arg);
+        break;
+
+    case ARGP_KEY_NO_ARGS:
+        argp_usage(state);
+        break;
+
+    case ARGP_KEY_ARG:
+
+        if (!use_udp) {
+            strncpy(ifname, arg, sizeof(ifname) - 1);
+
+            if (state->next >= state->argc)
+                argp_usage(state);
+
+            res = sscanf(state->argv[state->next], "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+                    &macaddr[0], &macaddr[1], &macaddr[2],
+                    &macaddr[3], &macaddr[4], &macaddr[5]);
+            if (res != 6) {
+                fprintf(stderr, "Invalid MAC address\n\n");
+                argp_usage(state);
+            }
+        } else {
+            res = sscanf(arg, "%[^:]:%d", ip_addr_str, &udp_port);
+            if (!res) {
+                fprintf(stderr, "Invalid IP address or port\n\n");
+                argp_usage(state);
+            }
+            res = inet_pton(AF_INET, ip_addr_str, ip_addr);
+            if (!res) {
+                fprintf(stderr, "Invalid IP address\n\n");
+                argp_usage(state);
+            }
+        }
+        state->next = state->argc;
+
+        break;
+    }
+
+    return 0;
+}
+
+static struct argp argp = { options, parser, args_doc, doc };
+
+static int init_cf_pdu(uint8_t* pdu)
+{
+    int res;
+    if (use_tscf) {
+        Avtp_Tscf_t* tscf_pdu = (Avtp_Tscf_t*) pdu;
+        memset(tscf_pdu, 0, AVTP_TSCF_HEADER_LEN);
+        Avtp_Tscf_Init(tscf_pdu);
+        Avtp_Tscf_SetField(tscf_pdu, AVTP_TSCF_FIELD_TU, 0U);
+        Avtp_Tscf_SetField(tscf_pdu, AVTP_TSCF_FIELD_SEQUENCE_NUM, seq_num++);
+        Avtp_Tscf_SetField(tscf_pdu, AVTP_TSCF_FIELD_STREAM_ID, STREAM_ID);
+        res = AVTP_TSCF_HEADER_LEN;
+    } else {
+        Avtp_Ntscf_t* ntscf_pdu = (Avtp_Ntscf_t*) pdu;
+        memset(ntscf_pdu, 0, AVTP_NTSCF_HEADER_LEN);
+        Avtp_Ntscf_Init(ntscf_pdu);
+        Avtp_Ntscf_SetField(ntscf_pdu, AVTP_NTSCF_FIELD_SEQUENCE_NUM, seq_num++);
+        Avtp_Ntscf_SetField(ntscf_pdu, AVTP_NTSCF_FIELD_STREAM_ID, STREAM_ID);
+        res = AVTP_NTSCF_HEADER_LEN;
+    }
+    return res;
+}
+
+static uint64_t clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+
+    clock_gettime(clock, &ts);
+
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/* Store a sample in the size selected with --size, truncating wider values. */
+static void set_sample(int index, int64_t value)
+{
+    switch (sample_sz) {
+    case AVTP_SENSOR_SZ_64BIT:
+        samples.u64[index] = value;
+        break;
+    case AVTP_SENSOR_SZ_32BIT:
+        samples.u32[index] = value;
+        break;
+    case AVTP_SENSOR_SZ_16BIT:
+        samples.u16[index] = value;
+        break;
+    default:
+        samples.u8[index] = value;
+        break;
+    }
+}
+
+static int prepare_acf_packet(uint8_t* acf_pdu, uint8_t count, uint64_t timestamp)
+{
+    if (use_brief) {
+        Avtp_SensorBrief_t* pdu = (Avtp_SensorBrief_t*) acf_pdu;
+
+        Avtp_SensorBrief_Init(pdu);
+        Avtp_SensorBrief_SetSensorGroup(pdu, sensor_group);
+
+        return Avtp_SensorBrief_PackSamples(pdu, &samples, count, sample_sz);
+    } else {
+        Avtp_Sensor_t* pdu = (Avtp_Sensor_t*) acf_pdu;
+
+        Avtp_Sensor_Init(pdu);
+        Avtp_Sensor_SetMtv(pdu, 1);
+        Avtp_Sensor_SetMessageTimestamp(pdu, timestamp);
+        Avtp_Sensor_SetSensorGroup(pdu, sensor_group);
+
+        return Avtp_Sensor_PackSamples(pdu, &samples, count, sample_sz);
+    }
+}
+
+/*
+ * Compute the poll() timeout in ms until the deadline of the packed frame,
+ * rounded up so the deadline has passed on wakeup.
+ */
+static int get_timeout_ms(Avtp_AcfPacker_t* packer)
+{
+    uint64_t deadline = Avtp_AcfPacker_GetDeadline(packer);
+    uint64_t now = clock_ns(CLOCK_MONOTONIC);
+
+    if (deadline == AVTP_ACF_PACKER_NO_DEADLINE) {
+        return -1;
+    }
+
+    if (deadline <= now) {
+        return 0;
+    }
+
+    return (deadline - now + NSEC_PER_MSEC - 1) / NSEC_PER_MSEC;
+}
+
+/* Reserve the next frame in the transmit ring and start packing into it. */
+static int start_pdu(struct acf_stream* stream)
+{
+    int res;
+
+    stream->pdu = tx_ring_reserve(stream->ring);
+    if (!stream->pdu)
+        return -1;
+
+    if (use_udp) {
+        Avtp_UDP_SetEncapsulationSeqNo((Avtp_UDP_t *) stream->pdu, seq_num);
+        stream->cf_pdu = stream->pdu + AVTP_UDP_HEADER_LEN;
+    } else {
+        stream->cf_pdu = stream->pdu;
+    }
+
+    res = init_cf_pdu(stream->cf_pdu);
+    if (res < 0)
+        return res;
+
+    return Avtp_AcfPacker_Init(&stream->packer, stream->cf_pdu,
+                               MAX_PDU_SIZE - (stream->cf_pdu - stream->pdu),
+                               stream->max_msgs, stream->latency);
+}
+
+/*
+ * Queue the packed frame, if any, and start the next one. The queued frames
+ * are handed to the kernel with tx_ring_flush().
+ */
+static int flush_pdu(struct acf_stream* stream)
+{
+    uint32_t pdu_length;
+
+    pdu_length = Avtp_AcfPacker_Finalize(&stream->packer);
+    if (pdu_length == 0)
+        return 0;
+    pdu_length += stream->cf_pdu - stream->pdu;
+
+    tx_ring_commit(stream->ring, pdu_length);
+
+    return start_pdu(stream);
+}
+
+/*
+ * Append the current reading of count samples to the stream as one sensor
+ * message. The frame is sent when it is full or its first message has waited
+ * for the latency given with --latency.
+ */
+static int pack_reading(struct acf_stream* stream, uint8_t count)
+{
+    int res;
+    uint8_t* acf_pdu;
+    uint64_t now = clock_ns(CLOCK_MONOTONIC);
+    uint16_t header_len = use_brief ? AVTP_SENSOR_BRIEF_HEADER_LEN : AVTP_SENSOR_HEADER_LEN;
+    uint16_t msg_len = header_len +
+                       ((count * Avtp_Sensor_GetSampleSize(sample_sz) + 3) & ~3);
+
+    acf_pdu = Avtp_AcfPacker_Reserve(&stream->packer, msg_len);
+    if (acf_pdu == NULL) {
+        res = flush_pdu(stream);
+        if (res < 0)
+            return res;
+        acf_pdu = Avtp_AcfPacker_Reserve(&stream->packer, msg_len);
+    }
+
+    res = prepare_acf_packet(acf_pdu, count, clock_ns(CLOCK_REALTIME));
+    if (res < 0)
+        return res;
+
+    res = Avtp_AcfPacker_Commit(&stream->packer, res, now);
+    if (res < 0)
+        return res;
+
+    if (res > 0 || Avtp_AcfPacker_IsDue(&stream->packer, now))
+        return flush_pdu(stream);
+
+    return 0;
+}
+
+/*
+ * Parse a line of whitespace separated integers (decimal, or hex with 0x
+ * prefix) into the sample buffer. Returns the number of samples.
+ */
+static int parse_reading(char* line)
+{
+    char* end;
+    int count = 0;
+    int64_t value;
+
+    while (count < AVTP_SENSOR_MAX_SAMPLES) {
+        errno = 0;
+        value = strtoll(line, &end, 0);
+        if (end == line)
+            break;
+        if (errno == ERANGE)
+            value = (int64_t)strtoull(line, &end, 0);
+        set_sample(count++, value);
+        line = end;
+    }
+
+    return count;
+}
+
+/*
+ * Pack one message per complete line in the STDIN buffer and keep a partial
+ * line for the next read. At the end of the input a last line without newline
+ * is packed as well, as is a line that fills the whole buffer.
+ */
+static int pack_lines(struct acf_stream* stream, struct line_buffer* input, int eof)
+{
+    int res, count;
+    char* line = input->buf;
+    char* end = input->buf + input->len;
+    char* eol;
+
+    while (line < end) {
+        eol = memchr(line, '\n', end - line);
+        if (!eol) {
+            if (!eof && (line != input->buf || input->len < sizeof(input->buf) - 1))
+                break;
+            eol = end;
+        }
+        *eol = '\0';
+
+        count = parse_reading(line);
+        if (count > 0) {
+            res = pack_reading(stream, count);
+            if (res < 0)
+                return res;
+        }
+
+        line = eol < end ? eol + 1 : end;
+    }
+
+    input->len = end - line;
+    memmove(input->buf, line, input->len);
+
+    return 0;
+}
+
+/*
+ * Pack one message per line of STDIN until the end of the input. STDIN is
+ * polled with a timeout so that a frame is sent at its latency deadline even
+ * if no further line arrives.
+ */
+static int stream_stdin(struct acf_stream* stream)
+{
+    int res;
+    ssize_t n;
+    struct line_buffer input = { .len = 0 };
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+
+    for (;;) {
+
+        // Wait for the next line, but not beyond the deadline of the
+        // readings already packed
+        res = poll(&pfd, 1, get_timeout_ms(&stream->packer));
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to poll STDIN");
+            return -1;
+        }
+
+        if (res > 0) {
+            n = read(STDIN_FILENO, input.buf + input.len, sizeof(input.buf) - 1 - input.len);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                perror("Failed to read STDIN");
+                return -1;
+            }
+            input.len += n;
+
+            if (pack_lines(stream, &input, n == 0) < 0)
+                return -1;
+            if (n == 0)
+                break;
+        }
+
+        if (Avtp_AcfPacker_IsDue(&stream->packer, clock_ns(CLOCK_MONOTONIC))) {
+            if (flush_pdu(stream) < 0)
+                return -1;
+        }
+
+        // Kick the kernel once for all frames completed in this round
+        if (tx_ring_flush(stream->ring) < 0)
+            return -1;
+    }
+
+    if (flush_pdu(stream) < 0)
+        return -1;
+
+    return tx_ring_flush(stream->ring);
+}
+
+/* Sleep until an absolute CLOCK_MONOTONIC time in ns. */
+static void sleep_until(uint64_t time_ns)
+{
+    struct timespec ts;
+
+    ts.tv_sec = time_ns / NSEC_PER_SEC;
+    ts.tv_nsec = time_ns % NSEC_PER_SEC;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+/*
+ * Generate a reading of num_sensors samples rate_hz times per second. Each
+ * sample is a sawtooth with its own offset so that the readings can be
+ * checked on the listener side. Between two readings the frame is sent when
+ * its latency deadline expires.
+ */
+static int stream_generated(struct acf_stream* stream)
+{
+    int res, i;
+    uint64_t n;
+    uint64_t deadline;
+    uint64_t period_ns = NSEC_PER_SEC / rate_hz;
+    uint64_t next = clock_ns(CLOCK_MONOTONIC);
+
+    for (n = 0; ; n++) {
+        for (i = 0; i < num_sensors; i++) {
+            set_sample(i, (int64_t)(n + i * 1000));
+        }
+
+        res = pack_reading(stream, num_sensors);
+        if (res < 0 || tx_ring_flush(stream->ring) < 0)
+            return -1;
+
+        // Sleep until the next reading, but not beyond the deadline of the
+        // readings already packed
+        next += period_ns;
+        while ((deadline = Avtp_AcfPacker_GetDeadline(&stream->packer)) < next) {
+            sleep_until(deadline);
+            if (Avtp_AcfPacker_IsDue(&stream->packer, clock_ns(CLOCK_MONOTONIC))) {
+                if (flush_pdu(stream) < 0 || tx_ring_flush(stream->ring) < 0)
+                    return -1;
+            }
+        }
+        sleep_until(next);
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int fd, res;
+    struct sockaddr_ll sk_ll_addr;
+    struct sockaddr_in sk_udp_addr;
+    struct acf_stream stream = { 0 };
+
+    argp_parse(&argp, argc, argv, 0, NULL, NULL);
+
+    if (use_udp) {
+        fd = create_talker_socket_udp(priority);
+    } else {
+        fd = create_talker_socket(priority);
+    }
+    if (fd < 0)
+        return 1;
+
+    if (use_udp) {
+        res = setup_udp_socket_address((struct in_addr*) ip_addr,
+                                       udp_port, &sk_udp_addr);
+        if (res < 0)
+            goto err;
+        stream.ring = tx_ring_alloc(fd, (struct sockaddr *) &sk_udp_addr, sizeof(sk_udp_addr),
+                                    MAX_PDU_SIZE, TX_RING_NUM_FRAMES, 0);
+    } else {
+        res = setup_socket_address(fd, ifname, macaddr, ETH_P_TSN, &sk_ll_addr);
+        if (res < 0)
+            goto err;
+        stream.ring = tx_ring_alloc(fd, (struct sockaddr *) &sk_ll_addr, sizeof(sk_ll_addr),
+                                    MAX_PDU_SIZE, TX_RING_NUM_FRAMES, qdisc_bypass);
+    }
+    if (!stream.ring)
+        goto err;
+
+    // Pack into control formats, in place in the transmit ring
+    stream.max_msgs = msgs_per_frame;
+    stream.latency = latency_usec * NSEC_PER_USEC;
+    res = start_pdu(&stream);
+    if (res < 0) {
+        fprintf(stderr, "Failed to initialize ACF packer\n");
+        goto err;
+    }
+
+    if (rate_hz > 0) {
+        res = stream_generated(&stream);
+    } else {
+        res = stream_stdin(&stream);
+    }
+    if (res < 0)
+        goto err;
+
+    tx_ring_free(stream.ring);
+    close(fd);
+    return 0;
+
+err:
+    tx_ring_free(stream.ring);
+    close(fd);
+    return 1;
+}
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/candump.h"
+
+/* Value of each hex digit with HEX_VALID set, 0 for all other characters */
+#define HEX_VALID       0x10
+
+#define HEX_DIGIT(c, v) [c] = HEX_VALID | (v)
+
+static const uint8_t hex_value[256] = {
+    HEX_DIGIT('0', 0x0), HEX_DIGIT('1', 0x1), HEX_DIGIT('2', 0x2), HEX_DIGIT('3', 0x3),
+    HEX_DIGIT('4', 0x4), HEX_DIGIT('5', 0x5), HEX_DIGIT('6', 0x6), HEX_DIGIT('7', 0x7),
+    HEX_DIGIT('8', 0x8), HEX_DIGIT('9', 0x9),
+    HEX_DIGIT('a', 0xa), HEX_DIGIT('b', 0xb), HEX_DIGIT('c', 0xc), HEX_DIGIT('d', 0xd),
+    HEX_DIGIT('e', 0xe), HEX_DIGIT('f', 0xf),
+    HEX_DIGIT('A', 0xa), HEX_DIGIT('B', 0xb), HEX_DIGIT('C', 0xc), HEX_DIGIT('D', 0xd),
+    HEX_DIGIT('E', 0xe), HEX_DIGIT('F', 0xf),
+};
+
+/* Two hex digits of each byte value */
+static const char hex_pairs[512] =
+    "000102030405060708090a0b0c0d0e0f"
+    "101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f"
+    "303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f"
+    "505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f"
+    "707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f"
+    "909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+    "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+    "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+static const char hex_digits[16] = "0123456789abcdef";
+
+static inline int is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* Parse a hex number, returns the number of digits or 0 if there is none */
+static size_t parse_hex(const char *p, const char *end, uint32_t *value)
+{
+    const char *start = p;
+    uint32_t v = 0;
+
+    while (p < end && (hex_value[(uint8_t)*p] & HEX_VALID) && p - start < 8) {
+        v = (v << 4) | (hex_value[(uint8_t)*p] & 0xf);
+        p++;
+    }
+
+    *value = v;
+
+    return p - start;
+}
+
+/* Decode pairs of hex digits until the end of the data or a non-hex digit */
+static size_t decode_hex_bytes(const char *p, const char *end, uint8_t *data,
+                               size_t max)
+{
+    size_t n = 0;
+    uint8_t hi, lo;
+
+    while (end - p >= 2 && n < max) {
+        hi = hex_value[(uint8_t)p[0]];
+        lo = hex_value[(uint8_t)p[1]];
+        if (!(hi & lo & HEX_VALID))
+            break;
+        data[n++] = (uint8_t)((hi & 0xf) << 4 | (lo & 0xf));
+        p += 2;
+    }
+
+    return n;
+}
+
+static inline void set_can_id(struct canfd_frame *frame, uint32_t id, size_t digits)
+{
+    if (digits == 8 || id > CAN_SFF_MASK)
+        frame->can_id = (id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    else
+        frame->can_id = id;
+}
+
+/* "<id>#<data>", "<id>#R" or "<id>##<flags><data>" */
+static int parse_log_frame(const char *p, const char *end,
+                           struct canfd_frame *frame, int *is_fd)
+{
+    uint32_t id, flags;
+    size_t digits;
+
+    digits = parse_hex(p, end, &id);
+    if (digits == 0 || p + digits >= end || p[digits] != '#')
+        return -1;
+    set_can_id(frame, id, digits);
+    p += digits + 1;
+
+    if (p < end && *p == '#') {
+        // CAN FD frame with one digit of flags
+        p++;
+        if (parse_hex(p, p + 1 <= end ? p + 1 : end, &flags) != 1)
+            return -1;
+        p++;
+        *is_fd = 1;
+        frame->flags = flags & (CANFD_BRS | CANFD_ESI);
+        frame->len = decode_hex_bytes(p, end, frame->data, CANFD_MAX_DLEN);
+    } else if (p < end && (*p == 'R' || *p == 'r')) {
+        *is_fd = 0;
+        frame->can_id |= CAN_RTR_FLAG;
+        return 0;
+    } else {
+        *is_fd = 0;
+        frame->len = decode_hex_bytes(p, end, frame->data, CAN_MAX_DLEN);
+    }
+
+    p += 2 * frame->len;
+
+    return p == end ? 0 : -1;
+}
+
+/* "<id>  [<len>]  <byte> <byte> ..." */
+static int parse_default_frame(const char *p, const char *end,
+                               struct canfd_frame *frame, int *is_fd)
+{
+    uint32_t id, len = 0;
+    size_t digits;
+
+    digits = parse_hex(p, end, &id);
+    if (digits == 0)
+        return -1;
+    set_can_id(frame, id, digits);
+    p += digits;
+
+    while (p < end && is_space(*p))
+        p++;
+    if (p == end || *p++ != '[')
+        return -1;
+    while (p < end && *p >= '0' && *p <= '9' && len <= CANFD_MAX_DLEN)
+        len = len * 10 + (*p++ - '0');
+    if (p == end || *p++ != ']' || len > CANFD_MAX_DLEN)
+        return -1;
+
+    *is_fd = len > CAN_MAX_DLEN;
+    frame->len = len;
+
+    for (len = 0; len < frame->len; len++) {
+        while (p < end && is_space(*p))
+            p++;
+        if (decode_hex_bytes(p, end, &frame->data[len], 1) != 1)
+            return -1;
+        p += 2;
+    }
+
+    return 0;
+}
+
+int candump_parse_line(const char *line, size_t len, struct canfd_frame *frame,
+                       int *is_fd)
+{
+    const char *p = line;
+    const char *end = line + len;
+    const char *token;
+
+    memset(frame, 0, sizeof(*frame));
+
+    while (end > p && is_space(end[-1]))
+        end--;
+    while (p < end && is_space(*p))
+        p++;
+
+    // Optional timestamp of the log format
+    if (p < end && *p == '(') {
+        p = memchr(p, ')', end - p);
+        if (!p)
+            return -1;
+        p++;
+    }
+
+    // The first token is either the frame itself or the interface name
+    while (p < end && is_space(*p))
+        p++;
+    token = p;
+    while (p < end && !is_space(*p) && *p != '#')
+        p++;
+    if (p < end && *p == '#')
+        return parse_log_frame(token, end, frame, is_fd);
+
+    while (p < end && is_space(*p))
+        p++;
+    token = p;
+    while (p < end && !is_space(*p) && *p != '#')
+        p++;
+    if (p < end && *p == '#')
+        return parse_log_frame(token, end, frame, is_fd);
+
+    return parse_default_frame(token, end, frame, is_fd);
+}
+
+size_t candump_format_frame(char *out, const struct canfd_frame *frame, int is_fd)
+{
+    static const char prefix[] = "(000000.000000) elmcan ";
+    char *p = out;
+    uint32_t id;
+    int i, digits;
+
+    memcpy(p, prefix, sizeof(prefix) - 1);
+    p += sizeof(prefix) - 1;
+
+    if (frame->can_id & CAN_EFF_FLAG) {
+        id = frame->can_id & CAN_EFF_MASK;
+        digits = 8;
+    } else {
+        id = frame->can_id & CAN_SFF_MASK;
+        digits = 3;
+    }
+    for (i = digits - 1; i >= 0; i--)
+        *p++ = hex_digits[(id >> (4 * i)) & 0xf];
+
+    *p++ = '#';
+    if (is_fd) {
+        *p++ = '#';
+        *p++ = hex_digits[frame->flags & 0xf];
+    } else if (frame->can_id & CAN_RTR_FLAG) {
+        *p++ = 'R';
+        *p++ = '\n';
+        return p - out;
+    }
+
+    for (i = 0; i < frame->len && i < CANFD_MAX_DLEN; i++) {
+        memcpy(p, &hex_pairs[2 * frame->data[i]], 2);
+        p += 2;
+    }
+    *p++ = '\n';
+
+    return p - out;
+}
+
+void candump_reader_init(struct candump_reader *reader, int fd)
+{
+    reader->fd = fd;
+    reader->start = 0;
+    reader->end = 0;
+    reader->eof = 0;
+    reader->skip_line = 0;
+    reader->invalid_lines = 0;
+}
+
+ssize_t candump_reader_fill(struct candump_reader *reader)
+{
+    ssize_t n;
+
+    // Move the incomplete line to the front of the buffer
+    if (reader->start > 0) {
+        memmove(reader->buf, reader->buf + reader->start,
+                reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+
+    // Drop a line that does not fit into the buffer, including the rest of
+    // it still to be read
+    if (reader->end == sizeof(reader->buf)) {
+        reader->invalid_lines++;
+        reader->end = 0;
+        reader->skip_line = 1;
+    }
+
+    do {
+        n = read(reader->fd, reader->buf + reader->end,
+                 sizeof(reader->buf) - reader->end);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        perror("Failed to read()");
+        return -1;
+    }
+
+    reader->end += n;
+    if (n == 0)
+        reader->eof = 1;
+
+    return n;
+}
+
+int candump_reader_next(struct candump_reader *reader, struct canfd_frame *frame,
+                        int *is_fd)
+{
+    char *line, *eol;
+
+    while (reader->start < reader->end) {
+        line = reader->buf + reader->start;
+        eol = memchr(line, '\n', reader->end - reader->start);
+        if (reader->skip_line) {
+            // Discard the input up to the end of a dropped line
+            if (!eol) {
+                reader->start = reader->end;
+                return 0;
+            }
+            reader->start += eol - line + 1;
+            reader->skip_line = 0;
+            continue;
+        }
+        if (!eol) {
+            // No more input will complete the last line
+            if (!reader->eof)
+                return 0;
+            eol = reader->buf + reader->end;
+            reader->start = reader->end;
+        } else {
+            reader->start += eol - line + 1;
+        }
+
+        if (eol == line)
+            continue;
+
+        if (candump_parse_line(line, eol - line, frame, is_fd) == 0)
+            return 1;
+
+        reader->invalid_lines++;
+    }
+
+    return 0;
+}
+
+void candump_writer_init(struct candump_writer *writer, int fd)
+{
+    writer->fd = fd;
+    writer->len = 0;
+}
+
+int candump_writer_put(struct candump_writer *writer,
+                       const struct canfd_frame *frame, int is_fd)
+{
+    if (sizeof(writer->buf) - writer->len < CANDUMP_MAX_LINE_LEN) {
+        if (candump_writer_flush(writer) < 0)
+            return -1;
+    }
+
+    writer->len += candump_format_frame(writer->buf + writer->len, frame, is_fd);
+
+    return 0;
+}
+
+int candump_writer_flush(struct candump_writer *writer)
+{
+    size_t written = 0;
+    ssize_t n;
+
+    while (written < writer->len) {
+        n = write(writer->fd, writer->buf + written, writer->len - written);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to write()");
+            writer->len = 0;
+            return -1;
+        }
+        written += n;
+    }
+
+    writer->len = 0;
+
+    return 0;
+}
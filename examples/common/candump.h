@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <linux/can.h>
+
+/* Size of the buffers of the candump reader and writer. A line longer than
+ * the buffer is dropped.
+ */
+#define CANDUMP_BUF_SIZE        65536
+
+/* Maximum length of a line produced by candump_format_frame() */
+#define CANDUMP_MAX_LINE_LEN    (64 + 2 * CANFD_MAX_DLEN)
+
+/* Streaming parser for CAN frames in the candump formats. Lines are read
+ * from a file descriptor in large chunks and parsed in place.
+ */
+struct candump_reader {
+    int fd;
+    size_t start;
+    size_t end;
+    int eof;
+    int skip_line;
+    uint64_t invalid_lines;
+    char buf[CANDUMP_BUF_SIZE];
+};
+
+/* Buffered writer for CAN frames in the candump log format. */
+struct candump_writer {
+    int fd;
+    size_t len;
+    char buf[CANDUMP_BUF_SIZE];
+};
+
+/* Parse one line in one of the candump formats into a CAN frame. Supported
+ * are the log format of 'candump -L' and canplayer, i.e.
+ * "(sec.usec) iface <id>#<data>", "(sec.usec) iface <id>##<flags><data>" for
+ * CAN FD and "<id>#R" for remote frames, where the timestamp and interface
+ * are optional, and the default format of candump, i.e.
+ * "iface <id> [<len>] <byte> <byte> ...". Extended frame IDs are detected by
+ * their length (8 digits) or value (> 0x7FF).
+ * @line: Line to be parsed, without line terminator.
+ * @len: Length of the line.
+ * @frame: Pointer to struct canfd_frame to store the frame in.
+ * @is_fd: Pointer to store 1 in for CAN FD frames and 0 for classic frames.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Line is not a valid candump line.
+ */
+int candump_parse_line(const char *line, size_t len, struct canfd_frame *frame,
+                       int *is_fd);
+
+/* Format a CAN frame in the candump log format, using a zero timestamp and
+ * the interface name 'elmcan' as expected by canplayer.
+ * @out: Buffer of at least CANDUMP_MAX_LINE_LEN bytes.
+ * @frame: Frame to be formatted.
+ * @is_fd: 1 if the frame is a CAN FD frame, 0 otherwise.
+ *
+ * Returns:
+ *    Length of the line including the line terminator. The line is not
+ *    zero terminated.
+ */
+size_t candump_format_frame(char *out, const struct canfd_frame *frame, int is_fd);
+
+/* Initialize a candump reader.
+ * @reader: Reader to be initialized.
+ * @fd: File descriptor to read from, e.g. STDIN_FILENO.
+ */
+void candump_reader_init(struct candump_reader *reader, int fd);
+
+/* Read the next chunk of input with a single read() call.
+ * @reader: Reader to fill.
+ *
+ * Returns:
+ *    > 0: Number of bytes read.
+ *    0: End of file.
+ *    -1: Could not read.
+ */
+ssize_t candump_reader_fill(struct candump_reader *reader);
+
+/* Parse the next frame from the data read so far. Invalid lines are skipped
+ * and counted in invalid_lines.
+ * @reader: Reader to parse from.
+ * @frame: Pointer to struct canfd_frame to store the frame in.
+ * @is_fd: Pointer to store 1 in for CAN FD frames and 0 for classic frames.
+ *
+ * Returns:
+ *    1: A frame was parsed.
+ *    0: No complete line is left, candump_reader_fill() has to be called.
+ *       Once it reported the end of file, a last line without a trailing
+ *       newline is parsed as well.
+ */
+int candump_reader_next(struct candump_reader *reader, struct canfd_frame *frame,
+                        int *is_fd);
+
+/* Initialize a candump writer.
+ * @writer: Writer to be initialized.
+ * @fd: File descriptor to write to, e.g. STDOUT_FILENO.
+ */
+void candump_writer_init(struct candump_writer *writer, int fd);
+
+/* Append a CAN frame in the candump log format to the writer buffer. The
+ * buffer is flushed if it has no room for another line.
+ * @writer: Writer to append to.
+ * @frame: Frame to be written.
+ * @is_fd: 1 if the frame is a CAN FD frame, 0 otherwise.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not flush the buffer.
+ */
+int candump_writer_put(struct candump_writer *writer,
+                       const struct canfd_frame *frame, int is_fd);
+
+/* Write all buffered lines.
+ * @writer: Writer to be flushed.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not write all data.
+ */
+int candump_writer_flush(struct candump_writer *writer);
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/canfilter.h"
+
+#define SFF_MASK        0x7FFU
+#define EFF_MASK        0x1FFFFFFFU
+
+void can_id_filter_init(struct can_id_filter *filter)
+{
+    memset(filter, 0, sizeof(*filter));
+}
+
+void can_id_filter_free(struct can_id_filter *filter)
+{
+    free(filter->rules);
+    free(filter->eff_ids);
+    free(filter->eff_ranges);
+    free(filter->eff_masks);
+    can_id_filter_init(filter);
+}
+
+/* Parse a hex number, returns the number of digits or 0 on error */
+static size_t parse_hex(const char *s, const char **end, uint32_t *value)
+{
+    unsigned long v;
+    char *e;
+
+    if (!isxdigit((unsigned char)*s))
+        return 0;
+
+    errno = 0;
+    v = strtoul(s, &e, 16);
+    if (errno || v > EFF_MASK)
+        return 0;
+
+    *value = v;
+    *end = e;
+
+    return e - s;
+}
+
+static int append_rule(struct can_id_filter *filter, const struct can_id_filter_rule *rule)
+{
+    struct can_id_filter_rule *rules;
+    size_t max;
+
+    if (filter->num_rules == filter->max_rules) {
+        max = filter->max_rules ? 2 * filter->max_rules : 64;
+        rules = realloc(filter->rules, max * sizeof(*rules));
+        if (!rules)
+            return -1;
+        filter->rules = rules;
+        filter->max_rules = max;
+    }
+
+    filter->rules[filter->num_rules++] = *rule;
+
+    return 0;
+}
+
+int can_id_filter_add_rule(struct can_id_filter *filter, const char *rule)
+{
+    struct can_id_filter_rule r = { CAN_ID_FILTER_EXACT, 0, 0, 0 };
+    const char *p = rule;
+    size_t digits;
+
+    while (isspace((unsigned char)*p))
+        p++;
+
+    digits = parse_hex(p, &p, &r.a);
+    if (digits == 0)
+        goto invalid;
+
+    if (*p == ':' || *p == '-') {
+        r.type = *p == ':' ? CAN_ID_FILTER_MASK : CAN_ID_FILTER_RANGE;
+        if (parse_hex(p + 1, &p, &r.b) == 0)
+            goto invalid;
+    }
+
+    while (isspace((unsigned char)*p))
+        p++;
+    if (*p != '\0')
+        goto invalid;
+
+    r.eff = digits == 8 || r.a > SFF_MASK ||
+            (r.type != CAN_ID_FILTER_EXACT && r.b > SFF_MASK);
+
+    if (r.type == CAN_ID_FILTER_RANGE && r.b < r.a)
+        goto invalid;
+
+    /* A range crossing 0x7FF also covers the standard identifiers up to it */
+    if (r.type == CAN_ID_FILTER_RANGE && digits != 8 && r.a <= SFF_MASK &&
+        r.b > SFF_MASK) {
+        struct can_id_filter_rule sff = { CAN_ID_FILTER_RANGE, 0, r.a, SFF_MASK };
+
+        if (append_rule(filter, &sff) < 0)
+            return -1;
+    }
+
+    return append_rule(filter, &r);
+
+invalid:
+    fprintf(stderr, "Invalid CAN filter rule '%s'\n", rule);
+    return -1;
+}
+
+int can_id_filter_add_rules(struct can_id_filter *filter, const char *rules)
+{
+    char buf[64];
+    const char *p = rules;
+    const char *comma;
+    size_t len;
+    int res = 0;
+
+    while (*p) {
+        comma = strchr(p, ',');
+        len = comma ? (size_t)(comma - p) : strlen(p);
+
+        if (len >= sizeof(buf)) {
+            fprintf(stderr, "Invalid CAN filter rule '%.*s'\n", (int)len, p);
+            res = -1;
+        } else if (len > 0) {
+            memcpy(buf, p, len);
+            buf[len] = '\0';
+            if (can_id_filter_add_rule(filter, buf) < 0)
+                res = -1;
+        }
+
+        p += len;
+        if (*p == ',')
+            p++;
+    }
+
+    return res;
+}
+
+int can_id_filter_load_file(struct can_id_filter *filter, const char *path)
+{
+    char line[256];
+    char *comment;
+    FILE *f;
+    int res = 0;
+
+    f = fopen(path, "r");
+    if (!f) {
+        perror("Failed to open CAN filter file");
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        comment = strpbrk(line, "#\n");
+        if (comment)
+            *comment = '\0';
+        if (strspn(line, " \t\r") == strlen(line))
+            continue;
+        if (can_id_filter_add_rule(filter, line) < 0)
+            res = -1;
+    }
+
+    fclose(f);
+
+    return res;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+static int compare_range(const void *a, const void *b)
+{
+    return compare_u32(&((const struct can_id_filter_range *)a)->lo,
+                       &((const struct can_id_filter_range *)b)->lo);
+}
+
+/* Number of IDs matching a mask rule, 0 if it exceeds the limit */
+static size_t mask_rule_size(uint32_t mask, uint32_t id_mask, size_t limit)
+{
+    uint32_t free_bits = ~mask & id_mask;
+    size_t n = 1;
+
+    while (free_bits) {
+        free_bits &= free_bits - 1;
+        n *= 2;
+        if (n > limit)
+            return 0;
+    }
+
+    return n;
+}
+
+/* Enumerate all IDs matching a mask rule by counting over its free bits */
+static size_t expand_mask(uint32_t id, uint32_t mask, uint32_t id_mask, uint32_t *out)
+{
+    uint32_t free_bits = ~mask & id_mask;
+    uint32_t sub = 0;
+    size_t n = 0;
+
+    id &= mask & id_mask;
+    do {
+        out[n++] = id | sub;
+        sub = (sub - free_bits) & free_bits;
+    } while (sub);
+
+    return n;
+}
+
+static void set_sff_bit(struct can_id_filter *filter, uint32_t id)
+{
+    filter->sff_bitmap[id >> 3] |= 1 << (id & 7);
+}
+
+int can_id_filter_compile(struct can_id_filter *filter)
+{
+    size_t i, j, n, num_ids = 0, num_ranges = 0, num_masks = 0;
+    struct can_id_filter_rule *r;
+    uint32_t sff_ids[CAN_ID_FILTER_SFF_IDS];
+    uint32_t id;
+
+    free(filter->eff_ids);
+    free(filter->eff_ranges);
+    free(filter->eff_masks);
+    filter->eff_ids = NULL;
+    filter->eff_ranges = NULL;
+    filter->eff_masks = NULL;
+    memset(filter->sff_bitmap, 0, sizeof(filter->sff_bitmap));
+
+    filter->active = filter->num_rules > 0;
+
+    // Size the tables for extended identifiers
+    for (i = 0; i < filter->num_rules; i++) {
+        r = &filter->rules[i];
+        if (!r->eff)
+            continue;
+        if (r->type == CAN_ID_FILTER_EXACT)
+            num_ids++;
+        else if (r->type == CAN_ID_FILTER_RANGE)
+            num_ranges++;
+        else if ((n = mask_rule_size(r->b, EFF_MASK, CAN_ID_FILTER_MAX_EXPAND)))
+            num_ids += n;
+        else
+            num_masks++;
+    }
+
+    filter->eff_ids = malloc((num_ids ? num_ids : 1) * sizeof(uint32_t));
+    filter->eff_ranges = malloc((num_ranges ? num_ranges : 1) * sizeof(struct can_id_filter_range));
+    filter->eff_masks = malloc((num_masks ? num_masks : 1) * sizeof(struct can_id_filter_mask));
+    if (!filter->eff_ids || !filter->eff_ranges || !filter->eff_masks)
+        return -1;
+
+    num_ids = num_ranges = num_masks = 0;
+    for (i = 0; i < filter->num_rules; i++) {
+        r = &filter->rules[i];
+
+        if (!r->eff) {
+            // Standard identifiers all go into the bitmap
+            if (r->type == CAN_ID_FILTER_EXACT) {
+                set_sff_bit(filter, r->a);
+            } else if (r->type == CAN_ID_FILTER_RANGE) {
+                for (id = r->a; id <= r->b; id++)
+                    set_sff_bit(filter, id);
+            } else {
+                n = expand_mask(r->a, r->b, SFF_MASK, sff_ids);
+                for (j = 0; j < n; j++)
+                    set_sff_bit(filter, sff_ids[j]);
+            }
+        } else if (r->type == CAN_ID_FILTER_EXACT) {
+            filter->eff_ids[num_ids++] = r->a;
+        } else if (r->type == CAN_ID_FILTER_RANGE) {
+            filter->eff_ranges[num_ranges].lo = r->a;
+            filter->eff_ranges[num_ranges].hi = r->b;
+            num_ranges++;
+        } else if (mask_rule_size(r->b, EFF_MASK, CAN_ID_FILTER_MAX_EXPAND)) {
+            num_ids += expand_mask(r->a, r->b, EFF_MASK, &filter->eff_ids[num_ids]);
+        } else {
+            filter->eff_masks[num_masks].id = r->a & r->b;
+            filter->eff_masks[num_masks].mask = r->b;
+            num_masks++;
+        }
+    }
+
+    // Sort and deduplicate the exact IDs for a binary search
+    qsort(filter->eff_ids, num_ids, sizeof(uint32_t), compare_u32);
+    for (i = 0, j = 0; i < num_ids; i++) {
+        if (j == 0 || filter->eff_ids[j - 1] != filter->eff_ids[i])
+            filter->eff_ids[j++] = filter->eff_ids[i];
+    }
+    filter->num_eff_ids = j;
+
+    // Sort and merge overlapping ranges
+    qsort(filter->eff_ranges, num_ranges, sizeof(struct can_id_filter_range), compare_range);
+    for (i = 0, j = 0; i < num_ranges; i++) {
+        if (j > 0 && filter->eff_ranges[i].lo <= filter->eff_ranges[j - 1].hi + 1) {
+            if (filter->eff_ranges[i].hi > filter->eff_ranges[j - 1].hi)
+                filter->eff_ranges[j - 1].hi = filter->eff_ranges[i].hi;
+        } else {
+            filter->eff_ranges[j++] = filter->eff_ranges[i];
+        }
+    }
+    filter->num_eff_ranges = j;
+
+    filter->num_eff_masks = num_masks;
+
+    return 0;
+}
+
+int can_id_filter_match_eff(const struct can_id_filter *filter, uint32_t id)
+{
+    size_t lo, hi, mid;
+
+    // Exact IDs
+    lo = 0;
+    hi = filter->num_eff_ids;
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (filter->eff_ids[mid] < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < filter->num_eff_ids && filter->eff_ids[lo] == id)
+        return 1;
+
+    // Last range starting at or below id
+    lo = 0;
+    hi = filter->num_eff_ranges;
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (filter->eff_ranges[mid].lo <= id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo > 0 && id <= filter->eff_ranges[lo - 1].hi)
+        return 1;
+
+    // Wide masks are rare and checked linearly
+    for (lo = 0; lo < filter->num_eff_masks; lo++) {
+        if ((id & filter->eff_masks[lo].mask) == filter->eff_masks[lo].id)
+            return 1;
+    }
+
+    return 0;
+}
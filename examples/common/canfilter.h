@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of standard (11 bit) CAN identifiers */
+#define CAN_ID_FILTER_SFF_IDS      2048
+
+/* A mask rule for extended identifiers with at most this many matching IDs
+ * is expanded into exact IDs when the filter is compiled.
+ */
+#define CAN_ID_FILTER_MAX_EXPAND   256
+
+enum can_id_filter_rule_type {
+    CAN_ID_FILTER_EXACT,
+    CAN_ID_FILTER_MASK,
+    CAN_ID_FILTER_RANGE,
+};
+
+struct can_id_filter_rule {
+    enum can_id_filter_rule_type type;
+    int eff;
+    uint32_t a;     /* ID or lower bound */
+    uint32_t b;     /* Mask or upper bound */
+};
+
+struct can_id_filter_range {
+    uint32_t lo;
+    uint32_t hi;
+};
+
+struct can_id_filter_mask {
+    uint32_t id;
+    uint32_t mask;
+};
+
+/* Filter for CAN identifiers. Rules are added with can_id_filter_add_rule() and
+ * friends and compiled with can_id_filter_compile() into a bitmap for standard
+ * identifiers and sorted tables for extended identifiers. A filter without
+ * rules accepts all frames.
+ */
+struct can_id_filter {
+    /* Rules as configured */
+    struct can_id_filter_rule *rules;
+    size_t num_rules;
+    size_t max_rules;
+
+    /* Compiled lookup structures */
+    int active;
+    uint8_t sff_bitmap[CAN_ID_FILTER_SFF_IDS / 8];
+    uint32_t *eff_ids;
+    size_t num_eff_ids;
+    struct can_id_filter_range *eff_ranges;
+    size_t num_eff_ranges;
+    struct can_id_filter_mask *eff_masks;
+    size_t num_eff_masks;
+};
+
+/* Initialize an empty filter.
+ * @filter: Filter to be initialized.
+ */
+void can_id_filter_init(struct can_id_filter *filter);
+
+/* Free the memory of a filter.
+ * @filter: Filter to be freed.
+ */
+void can_id_filter_free(struct can_id_filter *filter);
+
+/* Add a rule to a filter. A rule is one of
+ *   <id>           exact identifier,
+ *   <id>:<mask>    identifiers which equal id in all bits set in mask,
+ *   <lo>-<hi>      identifiers from lo to hi (inclusive),
+ * with all numbers in hex. A rule applies to extended (29 bit) identifiers
+ * if id (or lo) has 8 digits or any number exceeds 0x7FF, and to standard
+ * (11 bit) identifiers otherwise. A range with fewer than 8 digits in lo which
+ * crosses 0x7FF applies to standard identifiers from lo to 0x7FF as well.
+ * @filter: Filter to add the rule to.
+ * @rule: Rule to be parsed.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Invalid rule.
+ */
+int can_id_filter_add_rule(struct can_id_filter *filter, const char *rule);
+
+/* Add a comma separated list of rules to a filter.
+ * @filter: Filter to add the rules to.
+ * @rules: List of rules, see can_id_filter_add_rule().
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: At least one rule is invalid.
+ */
+int can_id_filter_add_rules(struct can_id_filter *filter, const char *rules);
+
+/* Add the rules of a file to a filter. The file holds one rule per line,
+ * empty lines and text following '#' are ignored.
+ * @filter: Filter to add the rules to.
+ * @path: Path of the file.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not read the file or at least one rule is invalid.
+ */
+int can_id_filter_load_file(struct can_id_filter *filter, const char *path);
+
+/* Compile the rules of a filter into its lookup structures. Must be called
+ * after the last rule was added and before can_id_filter_match() is used.
+ * @filter: Filter to be compiled.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not allocate memory.
+ */
+int can_id_filter_compile(struct can_id_filter *filter);
+
+/* Look up an extended identifier in the compiled tables. Use
+ * can_id_filter_match() instead.
+ */
+int can_id_filter_match_eff(const struct can_id_filter *filter, uint32_t id);
+
+/* Check whether a CAN frame passes a compiled filter.
+ * @filter: Compiled filter.
+ * @id: CAN identifier without flags.
+ * @eff: 1 for extended (29 bit) identifiers, 0 for standard identifiers.
+ *
+ * Returns:
+ *    1: The frame passes the filter.
+ *    0: The frame is filtered out.
+ */
+static inline int can_id_filter_match(const struct can_id_filter *filter, uint32_t id, int eff)
+{
+    if (!filter->active)
+        return 1;
+
+    if (!eff)
+        return id < CAN_ID_FILTER_SFF_IDS &&
+               (filter->sff_bitmap[id >> 3] >> (id & 7)) & 1;
+
+    return can_id_filter_match_eff(filter, id);
+}
@@ -28,12 +28,21 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define _GNU_SOURCE
+
 #include <arpa/inet.h>
+#include <errno.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/udp.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/timerfd.h>
@@ -46,6 +55,29 @@
 #define NSEC_PER_SEC		1000000000ULL
 #define NSEC_PER_MSEC		1000000ULL
 
+/* Limits of a buffer sent with UDP segmentation offload: the kernel accepts
+ * at most 64 segments (UDP_MAX_SEGMENTS) and the payload of an IPv6
+ * datagram.
+ */
+#define BATCH_IO_MAX_SEGMENTS           64
+#define BATCH_IO_MAX_SEGMENTED_LEN      (0xFFFF - 8 - 40)
+
+struct batch_io {
+    unsigned int size;
+    unsigned int count;
+    size_t msg_size;
+    size_t control_size;
+    uint8_t *buffers;
+    uint8_t *controls;
+    struct iovec *iovs;
+    struct mmsghdr *msgs;
+    struct sockaddr_storage dst_addr;
+    /* UDP segmentation offload: one message per run of equal-sized messages */
+    int segmentation;
+    struct mmsghdr *gso_msgs;
+    uint8_t *gso_controls;
+};
+
 int calculate_avtp_time(uint32_t *avtp_time, uint32_t max_transit_time)
 {
     int res;
@@ -285,3 +317,404 @@ int present_data(uint8_t *data, size_t len)
 
     return 0;
 }
+
+struct batch_io *batch_io_alloc(unsigned int size, size_t msg_size,
+                                size_t control_size)
+{
+    struct batch_io *batch;
+    unsigned int i;
+
+    batch = calloc(1, sizeof(*batch));
+    if (!batch)
+        return NULL;
+
+    batch->buffers = calloc(size, msg_size);
+    batch->iovs = calloc(size, sizeof(struct iovec));
+    batch->msgs = calloc(size, sizeof(struct mmsghdr));
+    if (control_size)
+        batch->controls = calloc(size, control_size);
+    if (!batch->buffers || !batch->iovs || !batch->msgs ||
+        (control_size && !batch->controls)) {
+        batch_io_free(batch);
+        return NULL;
+    }
+
+    batch->size = size;
+    batch->msg_size = msg_size;
+    batch->control_size = control_size;
+
+    for (i = 0; i < size; i++) {
+        batch->iovs[i].iov_base = batch->buffers + i * msg_size;
+        batch->iovs[i].iov_len = msg_size;
+        batch->msgs[i].msg_hdr.msg_iov = &batch->iovs[i];
+        batch->msgs[i].msg_hdr.msg_iovlen = 1;
+        if (control_size) {
+            batch->msgs[i].msg_hdr.msg_control = batch->controls + i * control_size;
+            batch->msgs[i].msg_hdr.msg_controllen = control_size;
+        }
+    }
+
+    return batch;
+}
+
+void batch_io_free(struct batch_io *batch)
+{
+    if (!batch)
+        return;
+
+    free(batch->buffers);
+    free(batch->controls);
+    free(batch->iovs);
+    free(batch->msgs);
+    free(batch->gso_msgs);
+    free(batch->gso_controls);
+    free(batch);
+}
+
+int batch_io_recv(int fd, struct batch_io *batch, int flags)
+{
+    unsigned int i;
+    int n;
+
+    /* iov_len may have been shortened by a previous send and msg_controllen
+     * by a previous receive.
+     */
+    for (i = 0; i < batch->size; i++) {
+        batch->iovs[i].iov_len = batch->msg_size;
+        batch->msgs[i].msg_hdr.msg_controllen = batch->control_size;
+    }
+
+    batch->count = 0;
+
+    /* Without MSG_WAITFORONE a blocking recvmmsg() waits for a full batch */
+    if (!(flags & MSG_DONTWAIT))
+        flags |= MSG_WAITFORONE;
+
+    n = recvmmsg(fd, batch->msgs, batch->size, flags, NULL);
+    if (n < 0) {
+        if ((flags & MSG_DONTWAIT) && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return 0;
+        perror("Failed to recvmmsg()");
+        return -1;
+    }
+
+    batch->count = n;
+
+    return n;
+}
+
+uint8_t *batch_io_get(struct batch_io *batch, unsigned int index, size_t *len)
+{
+    *len = batch->msgs[index].msg_len;
+
+    return batch->iovs[index].iov_base;
+}
+
+int batch_io_get_timestamp(struct batch_io *batch, unsigned int index,
+                           struct timespec *tspec)
+{
+    struct msghdr *hdr = &batch->msgs[index].msg_hdr;
+    struct cmsghdr *cmsg;
+    struct scm_timestamping *stamps;
+
+    for (cmsg = CMSG_FIRSTHDR(hdr); cmsg; cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET)
+            continue;
+
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            /* ts[0] holds the software timestamp on CLOCK_REALTIME. The raw
+             * hardware timestamp in ts[2] runs on the NIC clock, mixing both
+             * would give a stream timestamps of different time bases.
+             */
+            stamps = (struct scm_timestamping *) CMSG_DATA(cmsg);
+            if (stamps->ts[0].tv_sec || stamps->ts[0].tv_nsec) {
+                *tspec = stamps->ts[0];
+                return 0;
+            }
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            memcpy(tspec, CMSG_DATA(cmsg), sizeof(*tspec));
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+uint8_t *batch_io_reserve(struct batch_io *batch)
+{
+    if (batch->count == batch->size)
+        return NULL;
+
+    return batch->iovs[batch->count].iov_base;
+}
+
+void batch_io_commit(struct batch_io *batch, size_t len)
+{
+    batch->iovs[batch->count].iov_len = len;
+    batch->msgs[batch->count].msg_len = len;
+    batch->count++;
+}
+
+unsigned int batch_io_count(struct batch_io *batch)
+{
+    return batch->count;
+}
+
+int batch_io_set_destination(struct batch_io *batch,
+                             const struct sockaddr *dst_addr,
+                             socklen_t dst_addr_len)
+{
+    unsigned int i;
+
+    if (dst_addr_len > sizeof(batch->dst_addr))
+        return -1;
+
+    memcpy(&batch->dst_addr, dst_addr, dst_addr_len);
+
+    for (i = 0; i < batch->size; i++) {
+        batch->msgs[i].msg_hdr.msg_name = &batch->dst_addr;
+        batch->msgs[i].msg_hdr.msg_namelen = dst_addr_len;
+    }
+
+    return 0;
+}
+
+/* Empty the batch. The buffer of the next message, which may have been
+ * reserved and written already, becomes the first buffer of the batch.
+ */
+static void batch_io_reset(struct batch_io *batch)
+{
+    void *next;
+
+    if (batch->count > 0 && batch->count < batch->size) {
+        next = batch->iovs[batch->count].iov_base;
+        batch->iovs[batch->count].iov_base = batch->iovs[0].iov_base;
+        batch->iovs[0].iov_base = next;
+    }
+
+    batch->count = 0;
+}
+
+int batch_io_enable_segmentation(int fd, struct batch_io *batch)
+{
+    int gso_size;
+    socklen_t len = sizeof(gso_size);
+
+    // Kernels without UDP GSO do not know the option
+    if (getsockopt(fd, SOL_UDP, UDP_SEGMENT, &gso_size, &len) < 0)
+        return -1;
+
+    batch->gso_msgs = calloc(batch->size, sizeof(struct mmsghdr));
+    batch->gso_controls = calloc(batch->size, BATCH_IO_SEGMENT_CONTROL_SIZE);
+    if (!batch->gso_msgs || !batch->gso_controls) {
+        free(batch->gso_msgs);
+        free(batch->gso_controls);
+        batch->gso_msgs = NULL;
+        batch->gso_controls = NULL;
+        return -1;
+    }
+
+    batch->segmentation = 1;
+
+    return 0;
+}
+
+int batch_io_get_segment_size(struct batch_io *batch, unsigned int index,
+                              size_t *seg_size)
+{
+    struct msghdr *hdr = &batch->msgs[index].msg_hdr;
+    struct cmsghdr *cmsg;
+    int gso_size;
+
+    for (cmsg = CMSG_FIRSTHDR(hdr); cmsg; cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+            if (gso_size <= 0)
+                return -1;
+            *seg_size = gso_size;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/* Send messages with as few sendmmsg() calls as possible. Returns the
+ * number of messages sent, -1 if none could be sent and -2 if only some.
+ */
+static int send_msgs(int fd, struct mmsghdr *msgs, unsigned int count)
+{
+    unsigned int sent = 0;
+    int n;
+
+    while (sent < count) {
+        n = sendmmsg(fd, msgs + sent, count - sent, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return sent > 0 ? -2 : -1;
+        }
+        sent += n;
+    }
+
+    return sent;
+}
+
+/* Group the committed messages into runs which UDP GSO can split again:
+ * all segments of a run have the same size except for a shorter last one.
+ * The iovecs of a run are consecutive, so a run is sent straight from the
+ * message buffers without copying.
+ */
+static unsigned int build_segmented_msgs(struct batch_io *batch)
+{
+    unsigned int i, j, num_msgs = 0;
+    size_t seg_size, total;
+    uint16_t gso_size;
+    struct msghdr *hdr;
+    struct cmsghdr *cmsg;
+
+    for (i = 0; i < batch->count; i = j) {
+        seg_size = batch->iovs[i].iov_len;
+        total = seg_size;
+        for (j = i + 1; j < batch->count && j - i < BATCH_IO_MAX_SEGMENTS &&
+                        seg_size > 0 && batch->iovs[j - 1].iov_len == seg_size &&
+                        batch->iovs[j].iov_len <= seg_size &&
+                        total + batch->iovs[j].iov_len <= BATCH_IO_MAX_SEGMENTED_LEN; j++)
+            total += batch->iovs[j].iov_len;
+
+        hdr = &batch->gso_msgs[num_msgs].msg_hdr;
+        memset(hdr, 0, sizeof(*hdr));
+        hdr->msg_name = batch->msgs[i].msg_hdr.msg_name;
+        hdr->msg_namelen = batch->msgs[i].msg_hdr.msg_namelen;
+        hdr->msg_iov = &batch->iovs[i];
+        hdr->msg_iovlen = j - i;
+
+        if (j - i > 1) {
+            hdr->msg_control = batch->gso_controls + num_msgs * BATCH_IO_SEGMENT_CONTROL_SIZE;
+            hdr->msg_controllen = CMSG_SPACE(sizeof(gso_size));
+            cmsg = CMSG_FIRSTHDR(hdr);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(gso_size));
+            gso_size = seg_size;
+            memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+        }
+
+        num_msgs++;
+    }
+
+    return num_msgs;
+}
+
+int batch_io_send(int fd, struct batch_io *batch)
+{
+    unsigned int count = batch->count;
+    int n = -1;
+
+    if (batch->segmentation) {
+        n = send_msgs(fd, batch->gso_msgs, build_segmented_msgs(batch));
+        // The route may not support GSO, send plain datagrams from now on
+        if (n == -1 && (errno == EIO || errno == EINVAL || errno == EOPNOTSUPP)) {
+            fprintf(stderr, "UDP segmentation offload failed, disabling it\n");
+            batch->segmentation = 0;
+        }
+    }
+
+    if (!batch->segmentation)
+        n = send_msgs(fd, batch->msgs, count);
+
+    batch_io_reset(batch);
+
+    if (n < 0) {
+        perror("Failed to sendmmsg()");
+        return -1;
+    }
+
+    return count;
+}
+
+int enable_rx_timestamps(int fd)
+{
+    int res;
+    int enable = 1;
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+    res = setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+    if (res == 0)
+        return 0;
+
+    res = setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    if (res < 0) {
+        perror("Failed to enable receive timestamps");
+        return -1;
+    }
+
+    return 0;
+}
+
+int enable_udp_gro(int fd)
+{
+    int enable = 1;
+
+    return setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) < 0 ? -1 : 0;
+}
+
+int create_can_socket(const char *can_ifname)
+{
+    int fd, res;
+    int enable_canfd = 1;
+    struct ifreq req;
+    struct sockaddr_can can_addr;
+
+    fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
+        perror("Failed to open CAN socket");
+        return -1;
+    }
+
+    snprintf(req.ifr_name, sizeof(req.ifr_name), "%s", can_ifname);
+    res = ioctl(fd, SIOCGIFINDEX, &req);
+    if (res < 0) {
+        perror("Failed to get CAN interface index");
+        goto err;
+    }
+
+    memset(&can_addr, 0, sizeof(can_addr));
+    can_addr.can_family = AF_CAN;
+    can_addr.can_ifindex = req.ifr_ifindex;
+    res = bind(fd, (struct sockaddr *) &can_addr, sizeof(can_addr));
+    if (res < 0) {
+        perror("Failed to bind CAN socket");
+        goto err;
+    }
+
+    /* CAN interfaces without FD support still handle classic frames */
+    res = setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable_canfd,
+                     sizeof(enable_canfd));
+    if (res < 0)
+        perror("Failed to enable CAN FD frames");
+
+    return fd;
+
+err:
+    close(fd);
+    return -1;
+}
+
+int parse_can_bus_mapping(const char *arg, uint8_t *bus_id, char *can_ifname,
+                          size_t len)
+{
+    unsigned int id;
+    int n = 0;
+
+    if (sscanf(arg, "%u=%n", &id, &n) != 1 || n == 0 || id > 31 ||
+        arg[n] == '\0' || strlen(arg + n) >= len) {
+        fprintf(stderr, "Invalid CAN bus mapping '%s'\n", arg);
+        return -1;
+    }
+
+    *bus_id = id;
+    snprintf(can_ifname, len, "%s", arg + n);
+
+    return 0;
+}
@@ -29,8 +29,24 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <netinet/in.h>
 
+/* Batch of messages received with recvmmsg() or sent with sendmmsg(). The
+ * batch owns one buffer of a fixed size per message, see batch_io_alloc().
+ */
+struct batch_io;
+
+/* Size of the ancillary data buffer needed for receive timestamps, large
+ * enough for a SCM_TIMESTAMPING (three struct timespec) control message.
+ */
+#define BATCH_IO_TIMESTAMP_CONTROL_SIZE     64
+
+/* Size of the ancillary data buffer needed for the segment size of UDP GRO
+ * datagrams, see batch_io_get_segment_size().
+ */
+#define BATCH_IO_SEGMENT_CONTROL_SIZE       32
+
 /* Calculate AVTP presentation time based on current time and informed
  * max_transit_time.
  * @avtp_time: Pointer to variable which the calculated time should be saved.
@@ -138,3 +154,191 @@ int present_data(uint8_t *data, size_t len);
  *    -1: Could not arm timer.
  */
 int arm_timer(int fd, struct timespec *tspec);
+
+/* Allocate a batch for socket I/O with recvmmsg()/sendmmsg().
+ * @size: Maximum number of messages per batch.
+ * @msg_size: Size of the buffer of each message in bytes.
+ * @control_size: Size of the ancillary data buffer of each message in bytes,
+ *                e.g. BATCH_IO_TIMESTAMP_CONTROL_SIZE to receive timestamps.
+ *                0 if no ancillary data is needed.
+ *
+ * Returns:
+ *    Pointer to the batch. Should be freed with batch_io_free() when done.
+ *    NULL: Could not allocate memory.
+ */
+struct batch_io *batch_io_alloc(unsigned int size, size_t msg_size,
+                                size_t control_size);
+
+/* Free a batch allocated with batch_io_alloc().
+ * @batch: Batch to be freed, may be NULL.
+ */
+void batch_io_free(struct batch_io *batch);
+
+/* Receive up to the batch size of messages with a single recvmmsg() call.
+ * Messages from a previous call are discarded.
+ * @fd: Socket file descriptor.
+ * @batch: Batch to receive into.
+ * @flags: Flags passed to recvmmsg(), e.g. MSG_DONTWAIT. Without it, the
+ *         call blocks until at least one message is received.
+ *
+ * Returns:
+ *    >= 0: Number of messages received. 0 if no message was pending and
+ *          MSG_DONTWAIT was set.
+ *    -1: Could not receive messages.
+ */
+int batch_io_recv(int fd, struct batch_io *batch, int flags);
+
+/* Get a message of the batch.
+ * @batch: Batch to get the message from.
+ * @index: Index of the message, less than the number of messages received
+ *         or reserved.
+ * @len: Pointer to store the length of the message in bytes.
+ *
+ * Returns:
+ *    Pointer to the message buffer.
+ */
+uint8_t *batch_io_get(struct batch_io *batch, unsigned int index, size_t *len);
+
+/* Get the receive timestamp of a message of the batch. The socket must have
+ * receive timestamps enabled, see enable_rx_timestamps(), and the batch must
+ * be allocated with BATCH_IO_TIMESTAMP_CONTROL_SIZE.
+ * @batch: Batch to get the timestamp from.
+ * @index: Index of the message, less than the number of messages received.
+ * @tspec: Pointer to struct timespec where the timestamp should be saved.
+ *         The timestamp is always taken on CLOCK_REALTIME.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: The message carries no timestamp.
+ */
+int batch_io_get_timestamp(struct batch_io *batch, unsigned int index,
+                           struct timespec *tspec);
+
+/* Reserve the buffer of the next message to be sent.
+ * @batch: Batch to add the message to.
+ *
+ * Returns:
+ *    Pointer to a buffer of msg_size bytes.
+ *    NULL: The batch is full and should be sent with batch_io_send() first.
+ */
+uint8_t *batch_io_reserve(struct batch_io *batch);
+
+/* Add the message written to the buffer returned by batch_io_reserve() to
+ * the batch.
+ * @batch: Batch to add the message to.
+ * @len: Length of the message in bytes.
+ */
+void batch_io_commit(struct batch_io *batch, size_t len);
+
+/* Get the number of messages received or committed to the batch.
+ * @batch: Batch to query.
+ *
+ * Returns:
+ *    Number of messages in the batch.
+ */
+unsigned int batch_io_count(struct batch_io *batch);
+
+/* Set the destination address of all messages of a batch, for sending on
+ * sockets which are not connected, e.g. UDP sockets. The batch should only
+ * be used to send afterwards.
+ * @batch: Batch to set the destination of.
+ * @dst_addr: Destination address. The address is copied.
+ * @dst_addr_len: Length of the destination address in bytes.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: The address is too long.
+ */
+int batch_io_set_destination(struct batch_io *batch,
+                             const struct sockaddr *dst_addr,
+                             socklen_t dst_addr_len);
+
+/* Send runs of committed messages of equal size as one buffer with UDP
+ * segmentation offload (UDP_SEGMENT), so the kernel or the NIC splits them
+ * into datagrams. A run ends after a shorter message, after 64 messages or
+ * before the buffer would exceed 64 KiB. Messages are still sent as
+ * individual datagrams otherwise.
+ * @fd: UDP socket file descriptor the batch is sent on.
+ * @batch: Batch to enable segmentation on.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: The socket does not support UDP segmentation offload.
+ */
+int batch_io_enable_segmentation(int fd, struct batch_io *batch);
+
+/* Get the segment size of a coalesced datagram of the batch, which holds
+ * several datagrams of that size back to back, the last one possibly
+ * shorter. The socket must have UDP GRO enabled, see enable_udp_gro(), and
+ * the batch must be allocated with BATCH_IO_SEGMENT_CONTROL_SIZE.
+ * @batch: Batch to get the segment size from.
+ * @index: Index of the message, less than the number of messages received.
+ * @seg_size: Pointer to store the segment size in bytes.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: The message is a single datagram.
+ */
+int batch_io_get_segment_size(struct batch_io *batch, unsigned int index,
+                              size_t *seg_size);
+
+/* Send all committed messages with as few sendmmsg() calls as possible and
+ * empty the batch. A buffer reserved with batch_io_reserve() but not
+ * committed yet keeps its content and is returned by the next reserve.
+ * @fd: Socket file descriptor. The socket must be connected or bound to a
+ *      destination, e.g. a raw CAN socket, unless the destination was set
+ *      with batch_io_set_destination().
+ * @batch: Batch to be sent.
+ *
+ * Returns:
+ *    >= 0: Number of messages sent.
+ *    -1: Could not send all messages. The batch is emptied anyway.
+ */
+int batch_io_send(int fd, struct batch_io *batch);
+
+/* Enable receive timestamps on a socket. SO_TIMESTAMPING with software
+ * receive timestamps is tried first, SO_TIMESTAMPNS is used as a fallback.
+ * Either way the timestamps are taken on CLOCK_REALTIME.
+ * @fd: Socket file descriptor.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not enable timestamps.
+ */
+int enable_rx_timestamps(int fd);
+
+/* Enable UDP GRO on a socket. The kernel then coalesces consecutive
+ * datagrams of a flow with the same size into one message, see
+ * batch_io_get_segment_size(). Receive buffers have to be large enough for
+ * up to 64 KiB.
+ * @fd: UDP socket file descriptor.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: The socket does not support UDP GRO.
+ */
+int enable_udp_gro(int fd);
+
+/* Create a raw CAN socket bound to a CAN interface. Reception and
+ * transmission of CAN FD frames is enabled if the interface supports it.
+ * @can_ifname: CAN interface name.
+ *
+ * Returns:
+ *    >= 0: Socket file descriptor. Should be closed with close() when done.
+ *    -1: Could not create socket.
+ */
+int create_can_socket(const char *can_ifname);
+
+/* Parse a mapping of an ACF CAN bus ID to a CAN interface given as
+ * "<bus id>=<can ifname>", e.g. "3=can1".
+ * @arg: Mapping to be parsed.
+ * @bus_id: Pointer to store the bus ID (0 to 31) in.
+ * @can_ifname: Buffer to store the interface name in.
+ * @len: Size of the can_ifname buffer.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Invalid mapping.
+ */
+int parse_can_bus_mapping(const char *arg, uint8_t *bus_id, char *can_ifname,
+                          size_t len);
@@ -0,0 +1,623 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+
+#include "common/common.h"
+#include "common/packet_ring.h"
+#include "common/xdp_socket.h"
+
+/* Frame size reported to the kernel. TPACKET_V3 packs frames of any size
+ * into a block, the value only bounds the number of frames per ring.
+ */
+#define RX_RING_FRAME_SIZE      2048
+
+/* Size of the blocks the transmit ring is allocated in */
+#define TX_RING_BLOCK_SIZE      (1 << 16)
+
+/* Offset of the PDU within a TPACKET_V2 transmit frame */
+#define TX_RING_DATA_OFFSET     TPACKET_ALIGN(sizeof(struct tpacket2_hdr))
+
+struct rx_ring {
+    int fd;
+    unsigned int block_size;
+    unsigned int num_blocks;
+    uint8_t *map;
+    /* Mapped mode: current block and position within it */
+    unsigned int block;
+    uint32_t pkts_left;
+    struct tpacket3_hdr *next_pkt;
+    int holds_block;
+    /* Fallback mode: datagrams of the last recvmmsg() and next one to hand
+     * out, and the rest of a coalesced UDP GRO datagram being split.
+     */
+    struct batch_io *batch;
+    unsigned int batch_next;
+    uint8_t *seg_next;
+    size_t seg_left;
+    size_t seg_size;
+    /* AF_XDP mode: socket and destination address to accept */
+    struct xdp_socket *xsk;
+    uint8_t macaddr[ETH_ALEN];
+};
+
+struct tx_ring {
+    int fd;
+    struct sockaddr_storage dst_addr;
+    socklen_t dst_addr_len;
+    size_t max_pdu_len;
+    unsigned int num_frames;
+    unsigned int pending;
+    /* Mapped mode: frame geometry and next frame to be reserved */
+    uint8_t *map;
+    size_t map_len;
+    unsigned int frame_size;
+    unsigned int block_size;
+    unsigned int frames_per_block;
+    unsigned int head;
+    /* Fallback mode: PDUs sent with sendmmsg() on flush */
+    struct batch_io *batch;
+    /* AF_XDP mode: socket and Ethernet header prepended to each PDU */
+    struct xdp_socket *xsk;
+    struct ethhdr eth_hdr;
+};
+
+static struct tpacket_block_desc *get_block(struct rx_ring *ring, unsigned int block)
+{
+    return (struct tpacket_block_desc *)(ring->map + (size_t)block * ring->block_size);
+}
+
+static int setup_mapped_ring(struct rx_ring *ring, unsigned int retire_ms)
+{
+    int version = TPACKET_V3;
+    struct tpacket_req3 req;
+
+    if (setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+        return -1;
+
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = ring->block_size;
+    req.tp_block_nr = ring->num_blocks;
+    req.tp_frame_size = RX_RING_FRAME_SIZE;
+    req.tp_frame_nr = (ring->block_size / RX_RING_FRAME_SIZE) * ring->num_blocks;
+    req.tp_retire_blk_tov = retire_ms;
+
+    if (setsockopt(ring->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+        perror("Failed to set up PACKET_RX_RING");
+        return -1;
+    }
+
+    ring->map = mmap(NULL, (size_t)ring->block_size * ring->num_blocks,
+                     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, ring->fd, 0);
+    if (ring->map == MAP_FAILED) {
+        // Locking may exceed RLIMIT_MEMLOCK, the ring works without it
+        ring->map = mmap(NULL, (size_t)ring->block_size * ring->num_blocks,
+                         PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+    }
+    if (ring->map == MAP_FAILED) {
+        perror("Failed to map PACKET_RX_RING");
+        ring->map = NULL;
+        memset(&req, 0, sizeof(req));
+        setsockopt(ring->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+        return -1;
+    }
+
+    return 0;
+}
+
+struct rx_ring *rx_ring_alloc(int fd, unsigned int block_size,
+                              unsigned int num_blocks, unsigned int retire_ms)
+{
+    struct rx_ring *ring;
+
+    ring = calloc(1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+
+    ring->fd = fd;
+    ring->block_size = block_size;
+    ring->num_blocks = num_blocks;
+
+    // Only AF_PACKET sockets support the ring, receive copies otherwise
+    if (setup_mapped_ring(ring, retire_ms) < 0) {
+        if (enable_udp_gro(fd) == 0)
+            ring->batch = batch_io_alloc(RX_RING_GRO_BATCH_SIZE, RX_RING_GRO_MSG_SIZE,
+                                         BATCH_IO_SEGMENT_CONTROL_SIZE);
+        else
+            ring->batch = batch_io_alloc(RX_RING_BATCH_SIZE, RX_RING_BATCH_MSG_SIZE, 0);
+        if (!ring->batch) {
+            free(ring);
+            return NULL;
+        }
+    }
+
+    return ring;
+}
+
+struct rx_ring *rx_ring_alloc_xdp(const char *ifname, const uint8_t *macaddr,
+                                  unsigned int queue)
+{
+    struct rx_ring *ring;
+
+    ring = calloc(1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+
+    ring->xsk = xdp_socket_open(ifname, queue, XDP_SOCKET_NUM_FRAMES, 1);
+    if (!ring->xsk) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->fd = xdp_socket_fd(ring->xsk);
+    memcpy(ring->macaddr, macaddr, ETH_ALEN);
+
+    return ring;
+}
+
+void rx_ring_free(struct rx_ring *ring)
+{
+    if (!ring)
+        return;
+
+    if (ring->map)
+        munmap(ring->map, (size_t)ring->block_size * ring->num_blocks);
+    xdp_socket_close(ring->xsk);
+    batch_io_free(ring->batch);
+    free(ring);
+}
+
+static int block_ready(struct rx_ring *ring, unsigned int block)
+{
+    return __atomic_load_n(&get_block(ring, block)->hdr.bh1.block_status,
+                           __ATOMIC_ACQUIRE) & TP_STATUS_USER;
+}
+
+/* Return the current block to the kernel and move on to the next one. */
+static void release_block(struct rx_ring *ring)
+{
+    __atomic_store_n(&get_block(ring, ring->block)->hdr.bh1.block_status,
+                     TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    ring->holds_block = 0;
+    ring->block = (ring->block + 1) % ring->num_blocks;
+}
+
+static int next_mapped(struct rx_ring *ring, uint8_t **frame, size_t *len)
+{
+    struct tpacket_block_desc *desc;
+    struct tpacket3_hdr *pkt;
+
+    if (ring->holds_block && ring->pkts_left == 0)
+        release_block(ring);
+
+    if (!ring->holds_block) {
+        if (!block_ready(ring, ring->block))
+            return 0;
+
+        desc = get_block(ring, ring->block);
+        ring->holds_block = 1;
+        ring->pkts_left = desc->hdr.bh1.num_pkts;
+        ring->next_pkt = (struct tpacket3_hdr *)((uint8_t *)desc +
+                                                 desc->hdr.bh1.offset_to_first_pkt);
+        if (ring->pkts_left == 0) {
+            release_block(ring);
+            return 0;
+        }
+    }
+
+    pkt = ring->next_pkt;
+    *frame = (uint8_t *)pkt + pkt->tp_mac;
+    *len = pkt->tp_snaplen;
+
+    ring->pkts_left--;
+    ring->next_pkt = (struct tpacket3_hdr *)((uint8_t *)pkt + pkt->tp_next_offset);
+
+    return 1;
+}
+
+/* The XDP program steers all TSN frames of the queue to the socket, so
+ * frames of other streams are dropped here. The Ethernet header and a VLAN
+ * tag are stripped to match the AF_PACKET SOCK_DGRAM sockets.
+ */
+static int next_xdp(struct rx_ring *ring, uint8_t **frame, size_t *len)
+{
+    int res;
+    uint8_t *eth;
+    size_t eth_len, hdr_len;
+
+    while ((res = xdp_socket_rx(ring->xsk, &eth, &eth_len)) > 0) {
+        hdr_len = ETH_HLEN;
+        if (eth_len >= ETH_HLEN + 4 &&
+            ((struct ethhdr *)eth)->h_proto == htons(ETH_P_8021Q))
+            hdr_len += 4;
+
+        if (eth_len < hdr_len || memcmp(eth, ring->macaddr, ETH_ALEN) != 0)
+            continue;
+
+        *frame = eth + hdr_len;
+        *len = eth_len - hdr_len;
+        return 1;
+    }
+
+    return res;
+}
+
+int rx_ring_next(struct rx_ring *ring, uint8_t **frame, size_t *len)
+{
+    int n;
+
+    if (ring->map)
+        return next_mapped(ring, frame, len);
+    if (ring->xsk)
+        return next_xdp(ring, frame, len);
+
+    // Split a coalesced datagram back into the datagrams sent by the peer
+    if (ring->seg_left > 0) {
+        *frame = ring->seg_next;
+        *len = ring->seg_left < ring->seg_size ? ring->seg_left : ring->seg_size;
+        ring->seg_next += *len;
+        ring->seg_left -= *len;
+        return 1;
+    }
+
+    // Hand out the datagrams of the last batch before fetching the next one
+    if (ring->batch_next == batch_io_count(ring->batch)) {
+        ring->batch_next = 0;
+        n = batch_io_recv(ring->fd, ring->batch, MSG_DONTWAIT);
+        if (n <= 0)
+            return n;
+    }
+
+    *frame = batch_io_get(ring->batch, ring->batch_next, len);
+    if (batch_io_get_segment_size(ring->batch, ring->batch_next, &ring->seg_size) == 0 &&
+        ring->seg_size < *len) {
+        ring->seg_next = *frame + ring->seg_size;
+        ring->seg_left = *len - ring->seg_size;
+        *len = ring->seg_size;
+    }
+    ring->batch_next++;
+
+    return 1;
+}
+
+int rx_ring_wait(struct rx_ring *ring, int timeout_ms)
+{
+    int res;
+    struct pollfd pfd;
+
+    // Frames left in the block held by the application or in the batch
+    if (ring->map && ring->holds_block && ring->pkts_left > 0)
+        return 1;
+    if (ring->batch && (ring->seg_left > 0 ||
+                        ring->batch_next < batch_io_count(ring->batch)))
+        return 1;
+
+    pfd.fd = ring->fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    res = poll(&pfd, 1, timeout_ms);
+    if (res < 0) {
+        perror("Failed to poll() fds");
+        return -1;
+    }
+
+    return res > 0;
+}
+
+int rx_ring_is_mapped(struct rx_ring *ring)
+{
+    return ring->map != NULL || ring->xsk != NULL;
+}
+
+int rx_ring_fd(struct rx_ring *ring)
+{
+    return ring->fd;
+}
+
+static struct tpacket2_hdr *get_tx_frame(struct tx_ring *ring, unsigned int frame)
+{
+    return (struct tpacket2_hdr *)(ring->map +
+                                   (size_t)(frame / ring->frames_per_block) * ring->block_size +
+                                   (size_t)(frame % ring->frames_per_block) * ring->frame_size);
+}
+
+static int setup_tx_mapped_ring(struct tx_ring *ring, unsigned int num_frames)
+{
+    int version = TPACKET_V2;
+    int discard = 1;
+    long page_size = sysconf(_SC_PAGESIZE);
+    struct tpacket_req req;
+
+    if (setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+        return -1;
+
+    // Drop malformed frames instead of stalling the ring
+    setsockopt(ring->fd, SOL_PACKET, PACKET_LOSS, &discard, sizeof(discard));
+
+    ring->frame_size = TPACKET_ALIGN(TX_RING_DATA_OFFSET + ring->max_pdu_len);
+    ring->block_size = TX_RING_BLOCK_SIZE;
+    if (ring->block_size < ring->frame_size)
+        ring->block_size = (ring->frame_size + page_size - 1) / page_size * page_size;
+    ring->frames_per_block = ring->block_size / ring->frame_size;
+
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = ring->block_size;
+    req.tp_block_nr = (num_frames + ring->frames_per_block - 1) / ring->frames_per_block;
+    req.tp_frame_size = ring->frame_size;
+    req.tp_frame_nr = req.tp_block_nr * ring->frames_per_block;
+
+    if (setsockopt(ring->fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0) {
+        perror("Failed to set up PACKET_TX_RING");
+        return -1;
+    }
+
+    ring->num_frames = req.tp_frame_nr;
+    ring->map_len = (size_t)req.tp_block_size * req.tp_block_nr;
+    ring->map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     ring->fd, 0);
+    if (ring->map == MAP_FAILED) {
+        perror("Failed to map PACKET_TX_RING");
+        ring->map = NULL;
+        memset(&req, 0, sizeof(req));
+        setsockopt(ring->fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req));
+        return -1;
+    }
+
+    return 0;
+}
+
+struct tx_ring *tx_ring_alloc(int fd, const struct sockaddr *dst_addr,
+                              socklen_t dst_addr_len, size_t max_pdu_len,
+                              unsigned int num_frames, int qdisc_bypass)
+{
+    struct tx_ring *ring;
+    int one = 1;
+
+    if (dst_addr_len > sizeof(ring->dst_addr) || num_frames == 0)
+        return NULL;
+
+    ring = calloc(1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+
+    ring->fd = fd;
+    memcpy(&ring->dst_addr, dst_addr, dst_addr_len);
+    ring->dst_addr_len = dst_addr_len;
+    ring->max_pdu_len = max_pdu_len;
+
+    if (qdisc_bypass &&
+        setsockopt(fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one)) < 0) {
+        perror("Failed to set PACKET_QDISC_BYPASS");
+        free(ring);
+        return NULL;
+    }
+
+    // Only AF_PACKET sockets support the ring, send copies otherwise
+    if (setup_tx_mapped_ring(ring, num_frames) < 0) {
+        ring->num_frames = num_frames;
+        ring->batch = batch_io_alloc(num_frames, max_pdu_len, 0);
+        if (!ring->batch ||
+            batch_io_set_destination(ring->batch, dst_addr, dst_addr_len) < 0) {
+            tx_ring_free(ring);
+            return NULL;
+        }
+        // Optional, equal-sized PDUs are then sent as one UDP GSO buffer
+        batch_io_enable_segmentation(fd, ring->batch);
+    }
+
+    return ring;
+}
+
+struct tx_ring *tx_ring_alloc_xdp(const char *ifname, const uint8_t *macaddr,
+                                  size_t max_pdu_len, unsigned int queue)
+{
+    struct tx_ring *ring;
+    struct ifreq req;
+    int fd, res;
+
+    if (max_pdu_len > XDP_SOCKET_FRAME_SIZE - ETH_HLEN) {
+        fprintf(stderr, "PDUs too large for AF_XDP frames\n");
+        return NULL;
+    }
+
+    ring = calloc(1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+
+    ring->max_pdu_len = max_pdu_len;
+    ring->xsk = xdp_socket_open(ifname, queue, XDP_SOCKET_NUM_FRAMES, 0);
+    if (!ring->xsk) {
+        free(ring);
+        return NULL;
+    }
+    ring->fd = xdp_socket_fd(ring->xsk);
+
+    // Frames are sent as is, so the ring builds the Ethernet header. AF_XDP
+    // sockets do not support interface ioctls, ask through another socket.
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("Failed to open socket");
+        tx_ring_free(ring);
+        return NULL;
+    }
+
+    memset(&req, 0, sizeof(req));
+    strncpy(req.ifr_name, ifname, sizeof(req.ifr_name) - 1);
+    res = ioctl(fd, SIOCGIFHWADDR, &req);
+    close(fd);
+    if (res < 0) {
+        perror("Failed to get interface MAC address");
+        tx_ring_free(ring);
+        return NULL;
+    }
+
+    memcpy(ring->eth_hdr.h_dest, macaddr, ETH_ALEN);
+    memcpy(ring->eth_hdr.h_source, req.ifr_hwaddr.sa_data, ETH_ALEN);
+    ring->eth_hdr.h_proto = htons(ETH_P_TSN);
+
+    return ring;
+}
+
+void tx_ring_free(struct tx_ring *ring)
+{
+    if (!ring)
+        return;
+
+    if (ring->map)
+        munmap(ring->map, ring->map_len);
+    xdp_socket_close(ring->xsk);
+    batch_io_free(ring->batch);
+    free(ring);
+}
+
+static int wait_tx_frame(struct tx_ring *ring, struct tpacket2_hdr *hdr)
+{
+    uint32_t status;
+    struct pollfd pfd;
+
+    while ((status = __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE)) !=
+           TP_STATUS_AVAILABLE) {
+        if (status & TP_STATUS_WRONG_FORMAT) {
+            fprintf(stderr, "Dropping malformed frame\n");
+            __atomic_store_n(&hdr->tp_status, TP_STATUS_AVAILABLE, __ATOMIC_RELEASE);
+            break;
+        }
+
+        // Kick the kernel if the frame is still waiting for us to flush
+        if (ring->pending > 0) {
+            if (tx_ring_flush(ring) < 0)
+                return -1;
+            continue;
+        }
+
+        pfd.fd = ring->fd;
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+            perror("Failed to poll() fds");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+uint8_t *tx_ring_reserve(struct tx_ring *ring)
+{
+    struct tpacket2_hdr *hdr;
+    uint8_t *frame;
+
+    if (ring->xsk) {
+        frame = xdp_socket_tx_reserve(ring->xsk);
+        if (!frame)
+            return NULL;
+        memcpy(frame, &ring->eth_hdr, ETH_HLEN);
+        return frame + ETH_HLEN;
+    }
+
+    if (!ring->map) {
+        if (ring->pending == ring->num_frames && tx_ring_flush(ring) < 0)
+            return NULL;
+        return batch_io_reserve(ring->batch);
+    }
+
+    hdr = get_tx_frame(ring, ring->head);
+    if (wait_tx_frame(ring, hdr) < 0)
+        return NULL;
+
+    return (uint8_t *)hdr + TX_RING_DATA_OFFSET;
+}
+
+void tx_ring_commit(struct tx_ring *ring, size_t len)
+{
+    struct tpacket2_hdr *hdr;
+
+    if (ring->xsk) {
+        xdp_socket_tx_commit(ring->xsk, ETH_HLEN + len);
+        ring->pending++;
+        return;
+    }
+
+    if (!ring->map) {
+        batch_io_commit(ring->batch, len);
+        ring->pending++;
+        return;
+    }
+
+    hdr = get_tx_frame(ring, ring->head);
+    hdr->tp_len = len;
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+
+    ring->head = (ring->head + 1) % ring->num_frames;
+    ring->pending++;
+}
+
+int tx_ring_flush(struct tx_ring *ring)
+{
+    int res;
+    unsigned int sent = ring->pending;
+
+    if (sent == 0)
+        return 0;
+
+    ring->pending = 0;
+
+    if (ring->xsk)
+        return xdp_socket_tx_flush(ring->xsk) < 0 ? -1 : (int)sent;
+
+    if (ring->map) {
+        // One call sends all frames marked TP_STATUS_SEND_REQUEST
+        res = sendto(ring->fd, NULL, 0, 0, (struct sockaddr *)&ring->dst_addr,
+                     ring->dst_addr_len);
+        if (res < 0) {
+            perror("Failed to send data");
+            return -1;
+        }
+        return sent;
+    }
+
+    // All PDUs with as few sendmmsg() calls as possible
+    if (batch_io_send(ring->fd, ring->batch) < 0)
+        return -1;
+
+    return sent;
+}
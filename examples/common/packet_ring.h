@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/socket.h>
+
+/* Default geometry of the receive ring: 64 blocks of 64 KiB. A block is
+ * handed to the application when it is full or RX_RING_RETIRE_MS after its
+ * first frame was received, whichever comes first.
+ */
+#define RX_RING_BLOCK_SIZE      (1 << 16)
+#define RX_RING_NUM_BLOCKS      64
+#define RX_RING_RETIRE_MS       1
+
+/* Sockets without ring support fetch up to RX_RING_BATCH_SIZE datagrams of
+ * at most RX_RING_BATCH_MSG_SIZE bytes with one recvmmsg() call. Larger
+ * datagrams are truncated.
+ */
+#define RX_RING_BATCH_SIZE      64
+#define RX_RING_BATCH_MSG_SIZE  9216
+
+/* UDP sockets receive with UDP GRO if the kernel supports it. A coalesced
+ * datagram holds up to 64 KiB of datagrams of equal size, which are handed
+ * out one by one again.
+ */
+#define RX_RING_GRO_BATCH_SIZE  16
+#define RX_RING_GRO_MSG_SIZE    65535
+
+/* Receive engine on top of a PACKET_RX_RING with TPACKET_V3 block-based
+ * delivery. Frames are handed out as pointers into the memory mapped ring,
+ * so a whole block of frames costs one poll() and no copy. Sockets which do
+ * not support the ring (e.g. UDP sockets) fall back to recvmmsg() into
+ * internal buffers behind the same interface, and rx_ring_alloc_xdp()
+ * receives from an AF_XDP socket instead.
+ */
+struct rx_ring;
+
+/* Set up a receive ring on a socket.
+ * @fd: Socket file descriptor, e.g. from create_listener_socket(). The
+ *      socket is still owned by the caller.
+ * @block_size: Size of each block in bytes, a multiple of the page size,
+ *              e.g. RX_RING_BLOCK_SIZE.
+ * @num_blocks: Number of blocks, e.g. RX_RING_NUM_BLOCKS.
+ * @retire_ms: Time in ms after which a partially filled block is handed to
+ *             the application, e.g. RX_RING_RETIRE_MS.
+ *
+ * Returns:
+ *    Pointer to the ring. Should be freed with rx_ring_free() when done.
+ *    NULL: Could not allocate memory.
+ */
+struct rx_ring *rx_ring_alloc(int fd, unsigned int block_size,
+                              unsigned int num_blocks, unsigned int retire_ms);
+
+/* Set up a receive ring on an AF_XDP socket, see xdp_socket.h. The socket
+ * and the XDP program steering ETH_P_TSN frames to it are owned by the ring.
+ * Frames are handed out without the Ethernet header, like on SOCK_DGRAM
+ * sockets. The interface still has to accept the destination address, e.g.
+ * through the multicast membership of create_listener_socket().
+ * @ifname: Network interface name.
+ * @macaddr: Destination MAC address of the stream, frames to other
+ *           addresses are dropped.
+ * @queue: Receive queue of the interface the stream arrives on.
+ *
+ * Returns:
+ *    Pointer to the ring. Should be freed with rx_ring_free() when done.
+ *    NULL: Could not set up the socket.
+ */
+struct rx_ring *rx_ring_alloc_xdp(const char *ifname, const uint8_t *macaddr,
+                                  unsigned int queue);
+
+/* Free a ring allocated with rx_ring_alloc() or rx_ring_alloc_xdp(). The
+ * socket passed to rx_ring_alloc() is not closed.
+ * @ring: Ring to be freed, may be NULL.
+ */
+void rx_ring_free(struct rx_ring *ring);
+
+/* Get the next received frame without blocking. The frame stays valid until
+ * the next call, after which its memory is returned to the kernel.
+ * @ring: Ring to receive from.
+ * @frame: Pointer to store the pointer to the frame in. For SOCK_DGRAM
+ *         sockets the frame starts after the Ethernet header.
+ * @len: Pointer to store the length of the frame in bytes.
+ *
+ * Returns:
+ *    1: A frame was received.
+ *    0: No frame is pending. Wait with poll() on the socket or
+ *       rx_ring_wait() before trying again.
+ *    -1: Could not receive.
+ */
+int rx_ring_next(struct rx_ring *ring, uint8_t **frame, size_t *len);
+
+/* Wait until a frame can be fetched with rx_ring_next().
+ * @ring: Ring to wait on.
+ * @timeout_ms: Maximum time to wait in ms, -1 to wait forever.
+ *
+ * Returns:
+ *    1: A frame is pending.
+ *    0: The timeout expired.
+ *    -1: Could not wait.
+ */
+int rx_ring_wait(struct rx_ring *ring, int timeout_ms);
+
+/* Check whether a ring is memory mapped or uses the recvmmsg() fallback.
+ * @ring: Ring to query.
+ *
+ * Returns:
+ *    1: Frames are received through the memory mapped ring or UMEM.
+ *    0: Frames are copied with recvmmsg().
+ */
+int rx_ring_is_mapped(struct rx_ring *ring);
+
+/* Get the socket a ring receives from, e.g. to poll() it together with
+ * other file descriptors.
+ * @ring: Ring to query.
+ *
+ * Returns:
+ *    Socket file descriptor.
+ */
+int rx_ring_fd(struct rx_ring *ring);
+
+/* Default number of frames of the transmit ring */
+#define TX_RING_NUM_FRAMES      256
+
+/* Transmit engine on top of a PACKET_TX_RING. PDUs are written in place
+ * into the memory mapped ring with tx_ring_reserve() and tx_ring_commit(),
+ * and all committed PDUs are handed to the kernel with one tx_ring_flush().
+ * Sockets which do not support the ring (e.g. UDP sockets) fall back to
+ * sending all committed PDUs with sendmmsg() on flush behind the same
+ * interface. On UDP sockets, runs of equal-sized PDUs are sent with UDP
+ * segmentation offload. tx_ring_alloc_xdp() transmits through an AF_XDP
+ * socket instead.
+ */
+struct tx_ring;
+
+/* Set up a transmit ring on a socket.
+ * @fd: Socket file descriptor, e.g. from create_talker_socket(). The socket
+ *      is still owned by the caller.
+ * @dst_addr: Destination address of all PDUs, e.g. from
+ *            setup_socket_address(). The address is copied.
+ * @dst_addr_len: Length of the destination address in bytes.
+ * @max_pdu_len: Maximum length of a PDU in bytes.
+ * @num_frames: Number of PDUs the ring can hold, e.g. TX_RING_NUM_FRAMES.
+ * @qdisc_bypass: Send directly to the driver, bypassing the qdisc layer
+ *                (PACKET_QDISC_BYPASS). Traffic shaping configured with tc,
+ *                e.g. CBS, does not apply to the stream then.
+ *
+ * Returns:
+ *    Pointer to the ring. Should be freed with tx_ring_free() when done.
+ *    NULL: Could not set up the ring.
+ */
+struct tx_ring *tx_ring_alloc(int fd, const struct sockaddr *dst_addr,
+                              socklen_t dst_addr_len, size_t max_pdu_len,
+                              unsigned int num_frames, int qdisc_bypass);
+
+/* Set up a transmit ring on an AF_XDP socket, see xdp_socket.h. The socket
+ * is owned by the ring, which prepends an Ethernet header with the MAC
+ * address of the interface and ETH_P_TSN to each PDU. SO_PRIORITY and the
+ * qdisc layer do not apply to the socket.
+ * @ifname: Network interface name.
+ * @macaddr: Destination MAC address of all PDUs.
+ * @max_pdu_len: Maximum length of a PDU in bytes.
+ * @queue: Transmit queue of the interface to send on.
+ *
+ * Returns:
+ *    Pointer to the ring. Should be freed with tx_ring_free() when done.
+ *    NULL: Could not set up the socket.
+ */
+struct tx_ring *tx_ring_alloc_xdp(const char *ifname, const uint8_t *macaddr,
+                                  size_t max_pdu_len, unsigned int queue);
+
+/* Free a ring allocated with tx_ring_alloc() or tx_ring_alloc_xdp(). PDUs
+ * not flushed yet are dropped and the socket passed to tx_ring_alloc() is
+ * not closed.
+ * @ring: Ring to be freed, may be NULL.
+ */
+void tx_ring_free(struct tx_ring *ring);
+
+/* Reserve the buffer of the next PDU. Reserving again without a commit
+ * returns the same buffer. If the ring is full, the committed PDUs are
+ * flushed and the call blocks until the kernel has released a frame.
+ * @ring: Ring to write to.
+ *
+ * Returns:
+ *    Pointer to a buffer of max_pdu_len bytes.
+ *    NULL: Could not send the pending PDUs.
+ */
+uint8_t *tx_ring_reserve(struct tx_ring *ring);
+
+/* Queue the PDU written to the buffer returned by tx_ring_reserve().
+ * @ring: Ring to write to.
+ * @len: Length of the PDU in bytes.
+ */
+void tx_ring_commit(struct tx_ring *ring, size_t len);
+
+/* Hand all committed PDUs to the kernel.
+ * @ring: Ring to be flushed.
+ *
+ * Returns:
+ *    >= 0: Number of PDUs sent.
+ *    -1: Could not send the PDUs.
+ */
+int tx_ring_flush(struct tx_ring *ring);
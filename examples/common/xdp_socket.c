@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "common/xdp_socket.h"
+
+#ifdef OPEN1722_HAVE_AF_XDP
+
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+
+#ifndef AF_XDP
+#define AF_XDP                  44
+#endif
+#ifndef SOL_XDP
+#define SOL_XDP                 283
+#endif
+
+#define BPF_INSN(c, d, s, o, i) \
+    ((struct bpf_insn) { .code = (c), .dst_reg = (d), .src_reg = (s), .off = (o), .imm = (i) })
+
+/* Producer/consumer ring shared with the kernel. Indices run freely and are
+ * masked on access, the local copies avoid touching the shared cache lines
+ * for every entry.
+ */
+struct xdp_ring {
+    uint32_t *producer;
+    uint32_t *consumer;
+    uint32_t *flags;
+    void *descs;
+    uint32_t mask;
+    uint32_t cached_prod;
+    uint32_t cached_cons;
+    void *map;
+    size_t map_len;
+};
+
+struct xdp_socket {
+    int fd;
+    int zerocopy;
+    unsigned int num_frames;
+    uint8_t *umem;
+    struct xdp_ring fill;
+    struct xdp_ring comp;
+    struct xdp_ring rx;
+    struct xdp_ring tx;
+    /* Receive: frame handed to the application, UINT64_MAX if none */
+    uint64_t rx_held;
+    /* Transmit: stack of free frame addresses */
+    uint64_t *free_addrs;
+    unsigned int num_free;
+    /* Transmit: frame popped by the last reserve, UINT64_MAX if none */
+    uint64_t tx_reserved;
+    /* XDP program steering ETH_P_TSN to the socket */
+    int map_fd;
+    int prog_fd;
+    int link_fd;
+};
+
+static long sys_bpf(int cmd, union bpf_attr *attr)
+{
+    return syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+}
+
+static int map_ring(struct xdp_socket *xsk, struct xdp_ring *ring,
+                    const struct xdp_ring_offset *off, size_t desc_size,
+                    uint32_t size, off_t pgoff)
+{
+    ring->map_len = off->desc + size * desc_size;
+    ring->map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, xsk->fd, pgoff);
+    if (ring->map == MAP_FAILED) {
+        ring->map = NULL;
+        return -1;
+    }
+
+    ring->producer = (uint32_t *)((uint8_t *)ring->map + off->producer);
+    ring->consumer = (uint32_t *)((uint8_t *)ring->map + off->consumer);
+    ring->flags = (uint32_t *)((uint8_t *)ring->map + off->flags);
+    ring->descs = (uint8_t *)ring->map + off->desc;
+    ring->mask = size - 1;
+    ring->cached_prod = *ring->producer;
+    ring->cached_cons = *ring->consumer;
+
+    return 0;
+}
+
+static void unmap_ring(struct xdp_ring *ring)
+{
+    if (ring->map)
+        munmap(ring->map, ring->map_len);
+    ring->map = NULL;
+}
+
+static void close_socket(struct xdp_socket *xsk)
+{
+    unmap_ring(&xsk->fill);
+    unmap_ring(&xsk->comp);
+    unmap_ring(&xsk->rx);
+    unmap_ring(&xsk->tx);
+    if (xsk->fd >= 0)
+        close(xsk->fd);
+    xsk->fd = -1;
+}
+
+/* Create the socket, register the UMEM, map the rings and bind to the queue.
+ * The UMEM has to be registered again for every attempt, a failed bind
+ * leaves the socket unusable.
+ */
+static int open_socket(struct xdp_socket *xsk, int ifindex, unsigned int queue,
+                       int rx, uint16_t bind_flags)
+{
+    int res;
+    uint32_t size = xsk->num_frames;
+    struct xdp_umem_reg reg;
+    struct xdp_mmap_offsets off;
+    socklen_t optlen = sizeof(off);
+    struct sockaddr_xdp addr;
+    uint32_t i;
+
+    xsk->fd = socket(AF_XDP, SOCK_RAW, 0);
+    if (xsk->fd < 0) {
+        perror("Failed to open AF_XDP socket");
+        return -1;
+    }
+
+    memset(&reg, 0, sizeof(reg));
+    reg.addr = (uintptr_t)xsk->umem;
+    reg.len = (uint64_t)xsk->num_frames * XDP_SOCKET_FRAME_SIZE;
+    reg.chunk_size = XDP_SOCKET_FRAME_SIZE;
+
+    res = setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg));
+    if (res < 0) {
+        perror("Failed to register UMEM");
+        goto err;
+    }
+
+    // Fill and completion rings are needed in either direction
+    res = setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_FILL_RING, &size, sizeof(size));
+    if (res == 0)
+        res = setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &size, sizeof(size));
+    if (res == 0)
+        res = setsockopt(xsk->fd, SOL_XDP, rx ? XDP_RX_RING : XDP_TX_RING, &size, sizeof(size));
+    if (res < 0) {
+        perror("Failed to set up AF_XDP rings");
+        goto err;
+    }
+
+    res = getsockopt(xsk->fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen);
+    if (res < 0) {
+        perror("Failed to get AF_XDP ring offsets");
+        goto err;
+    }
+
+    res = map_ring(xsk, &xsk->fill, &off.fr, sizeof(uint64_t), size,
+                   XDP_UMEM_PGOFF_FILL_RING);
+    if (res == 0)
+        res = map_ring(xsk, &xsk->comp, &off.cr, sizeof(uint64_t), size,
+                       XDP_UMEM_PGOFF_COMPLETION_RING);
+    if (res == 0 && rx)
+        res = map_ring(xsk, &xsk->rx, &off.rx, sizeof(struct xdp_desc), size,
+                       XDP_PGOFF_RX_RING);
+    if (res == 0 && !rx)
+        res = map_ring(xsk, &xsk->tx, &off.tx, sizeof(struct xdp_desc), size,
+                       XDP_PGOFF_TX_RING);
+    if (res < 0) {
+        perror("Failed to map AF_XDP rings");
+        goto err;
+    }
+
+    // Hand all frames to the kernel for reception
+    if (rx) {
+        for (i = 0; i < size; i++)
+            ((uint64_t *)xsk->fill.descs)[i] = (uint64_t)i * XDP_SOCKET_FRAME_SIZE;
+        xsk->fill.cached_prod = size;
+        __atomic_store_n(xsk->fill.producer, size, __ATOMIC_RELEASE);
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sxdp_family = AF_XDP;
+    addr.sxdp_flags = bind_flags | XDP_USE_NEED_WAKEUP;
+    addr.sxdp_ifindex = ifindex;
+    addr.sxdp_queue_id = queue;
+
+    res = bind(xsk->fd, (struct sockaddr *)&addr, sizeof(addr));
+    if (res < 0)
+        goto err;
+
+    return 0;
+
+err:
+    close_socket(xsk);
+    return -1;
+}
+
+/* Load the XDP program redirecting ETH_P_TSN frames to the socket of their
+ * receive queue and attach it to the interface. Frames of other protocols,
+ * and frames of queues without a socket, pass to the network stack.
+ */
+static int attach_program(struct xdp_socket *xsk, int ifindex, unsigned int queue)
+{
+    union bpf_attr attr;
+    uint32_t key = queue;
+    int fd = xsk->fd;
+    const uint32_t modes[] = { XDP_FLAGS_DRV_MODE, XDP_FLAGS_SKB_MODE };
+    unsigned int i;
+
+    struct bpf_insn prog[] = {
+        // r6 = ctx, r2 = data, r3 = data_end
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0),
+        BPF_INSN(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_6, 0, 0),
+        BPF_INSN(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_3, BPF_REG_6, 4, 0),
+        // r5 = EtherType, pass if the Ethernet header is truncated
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+        BPF_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, ETH_HLEN),
+        BPF_INSN(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 13, 0),
+        BPF_INSN(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_5, BPF_REG_2, 12, 0),
+        // Skip one VLAN tag
+        BPF_INSN(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 4, htons(ETH_P_8021Q)),
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+        BPF_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, ETH_HLEN + 4),
+        BPF_INSN(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 8, 0),
+        BPF_INSN(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_5, BPF_REG_2, 16, 0),
+        BPF_INSN(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_5, 0, 6, htons(ETH_P_TSN)),
+        // return bpf_redirect_map(&xsks, ctx->rx_queue_index, XDP_PASS)
+        BPF_INSN(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_6,
+                 offsetof(struct xdp_md, rx_queue_index), 0),
+        BPF_INSN(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, 0),
+        BPF_INSN(0, 0, 0, 0, 0),
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS),
+        BPF_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+        BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+        // return XDP_PASS
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS),
+        BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    };
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = sizeof(int);
+    attr.max_entries = queue + 1;
+
+    xsk->map_fd = sys_bpf(BPF_MAP_CREATE, &attr);
+    if (xsk->map_fd < 0) {
+        perror("Failed to create XSKMAP");
+        return -1;
+    }
+
+    prog[14].imm = xsk->map_fd;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.expected_attach_type = BPF_XDP;
+    attr.insns = (uintptr_t)prog;
+    attr.insn_cnt = sizeof(prog) / sizeof(prog[0]);
+    attr.license = (uintptr_t)"Dual BSD/GPL";
+
+    xsk->prog_fd = sys_bpf(BPF_PROG_LOAD, &attr);
+    if (xsk->prog_fd < 0) {
+        perror("Failed to load XDP program");
+        return -1;
+    }
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = xsk->map_fd;
+    attr.key = (uintptr_t)&key;
+    attr.value = (uintptr_t)&fd;
+
+    if (sys_bpf(BPF_MAP_UPDATE_ELEM, &attr) < 0) {
+        perror("Failed to add socket to XSKMAP");
+        return -1;
+    }
+
+    // Prefer the driver hook, fall back to the generic one
+    for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        memset(&attr, 0, sizeof(attr));
+        attr.link_create.prog_fd = xsk->prog_fd;
+        attr.link_create.target_ifindex = ifindex;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = modes[i];
+
+        xsk->link_fd = sys_bpf(BPF_LINK_CREATE, &attr);
+        if (xsk->link_fd >= 0)
+            return 0;
+    }
+
+    perror("Failed to attach XDP program");
+    return -1;
+}
+
+struct xdp_socket *xdp_socket_open(const char *ifname, unsigned int queue,
+                                   unsigned int num_frames, int rx)
+{
+    struct xdp_socket *xsk;
+    int ifindex;
+    unsigned int i;
+
+    if (num_frames == 0 || (num_frames & (num_frames - 1)) != 0) {
+        fprintf(stderr, "Number of UMEM frames must be a power of two\n");
+        return NULL;
+    }
+
+    ifindex = if_nametoindex(ifname);
+    if (ifindex == 0) {
+        perror("Failed to get interface index");
+        return NULL;
+    }
+
+    xsk = calloc(1, sizeof(*xsk));
+    if (!xsk)
+        return NULL;
+
+    xsk->fd = -1;
+    xsk->map_fd = -1;
+    xsk->prog_fd = -1;
+    xsk->link_fd = -1;
+    xsk->rx_held = UINT64_MAX;
+    xsk->tx_reserved = UINT64_MAX;
+    xsk->num_frames = num_frames;
+
+    xsk->umem = mmap(NULL, (size_t)num_frames * XDP_SOCKET_FRAME_SIZE,
+                     PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (xsk->umem == MAP_FAILED) {
+        perror("Failed to allocate UMEM");
+        xsk->umem = NULL;
+        goto err;
+    }
+
+    // Zero-copy needs driver support, copy mode works on any interface
+    if (open_socket(xsk, ifindex, queue, rx, XDP_ZEROCOPY) == 0) {
+        xsk->zerocopy = 1;
+    } else if (open_socket(xsk, ifindex, queue, rx, XDP_COPY) < 0) {
+        perror("Failed to bind AF_XDP socket");
+        goto err;
+    }
+
+    if (rx) {
+        if (attach_program(xsk, ifindex, queue) < 0)
+            goto err;
+    } else {
+        xsk->free_addrs = malloc(num_frames * sizeof(uint64_t));
+        if (!xsk->free_addrs)
+            goto err;
+        for (i = 0; i < num_frames; i++)
+            xsk->free_addrs[i] = (uint64_t)(num_frames - 1 - i) * XDP_SOCKET_FRAME_SIZE;
+        xsk->num_free = num_frames;
+    }
+
+    return xsk;
+
+err:
+    xdp_socket_close(xsk);
+    return NULL;
+}
+
+void xdp_socket_close(struct xdp_socket *xsk)
+{
+    if (!xsk)
+        return;
+
+    // Closing the link detaches the program from the interface
+    if (xsk->link_fd >= 0)
+        close(xsk->link_fd);
+    if (xsk->prog_fd >= 0)
+        close(xsk->prog_fd);
+    if (xsk->map_fd >= 0)
+        close(xsk->map_fd);
+    close_socket(xsk);
+    if (xsk->umem)
+        munmap(xsk->umem, (size_t)xsk->num_frames * XDP_SOCKET_FRAME_SIZE);
+    free(xsk->free_addrs);
+    free(xsk);
+}
+
+int xdp_socket_fd(struct xdp_socket *xsk)
+{
+    return xsk->fd;
+}
+
+int xdp_socket_is_zerocopy(struct xdp_socket *xsk)
+{
+    return xsk->zerocopy;
+}
+
+int xdp_socket_rx(struct xdp_socket *xsk, uint8_t **frame, size_t *len)
+{
+    struct xdp_ring *rx = &xsk->rx;
+    struct xdp_ring *fill = &xsk->fill;
+    struct xdp_desc *desc;
+
+    // The fill ring holds all frames, so there is always room to return one
+    if (xsk->rx_held != UINT64_MAX) {
+        ((uint64_t *)fill->descs)[fill->cached_prod & fill->mask] = xsk->rx_held;
+        __atomic_store_n(fill->producer, ++fill->cached_prod, __ATOMIC_RELEASE);
+        xsk->rx_held = UINT64_MAX;
+    }
+
+    if (rx->cached_cons == rx->cached_prod) {
+        rx->cached_prod = __atomic_load_n(rx->producer, __ATOMIC_ACQUIRE);
+        if (rx->cached_cons == rx->cached_prod)
+            return 0;
+    }
+
+    desc = &((struct xdp_desc *)rx->descs)[rx->cached_cons & rx->mask];
+    *frame = xsk->umem + desc->addr;
+    *len = desc->len;
+    xsk->rx_held = desc->addr - desc->addr % XDP_SOCKET_FRAME_SIZE;
+
+    __atomic_store_n(rx->consumer, ++rx->cached_cons, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+/* Move the frames sent by the kernel back to the free stack. */
+static void reclaim_tx_frames(struct xdp_socket *xsk)
+{
+    struct xdp_ring *comp = &xsk->comp;
+    uint32_t prod = __atomic_load_n(comp->producer, __ATOMIC_ACQUIRE);
+
+    while (comp->cached_cons != prod) {
+        xsk->free_addrs[xsk->num_free++] =
+            ((uint64_t *)comp->descs)[comp->cached_cons & comp->mask];
+        comp->cached_cons++;
+    }
+
+    __atomic_store_n(comp->consumer, comp->cached_cons, __ATOMIC_RELEASE);
+}
+
+static int kick_tx(struct xdp_socket *xsk)
+{
+    // Copy mode only transmits from within sendto()
+    if (xsk->zerocopy &&
+        !(__atomic_load_n(xsk->tx.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP))
+        return 0;
+
+    if (sendto(xsk->fd, NULL, 0, MSG_DONTWAIT, NULL, 0) < 0 &&
+        errno != EAGAIN && errno != EBUSY && errno != ENOBUFS) {
+        perror("Failed to send data");
+        return -1;
+    }
+
+    return 0;
+}
+
+uint8_t *xdp_socket_tx_reserve(struct xdp_socket *xsk)
+{
+    struct pollfd pfd;
+
+    if (xsk->tx_reserved != UINT64_MAX)
+        return xsk->umem + xsk->tx_reserved;
+
+    if (xsk->num_free == 0)
+        reclaim_tx_frames(xsk);
+
+    while (xsk->num_free == 0) {
+        if (xdp_socket_tx_flush(xsk) < 0)
+            return NULL;
+        if (xsk->num_free > 0)
+            break;
+
+        pfd.fd = xsk->fd;
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, 1) < 0 && errno != EINTR) {
+            perror("Failed to poll() fds");
+            return NULL;
+        }
+        reclaim_tx_frames(xsk);
+    }
+
+    // Take the frame off the stack so that frames reclaimed by a flush
+    // before the commit cannot take its place
+    xsk->tx_reserved = xsk->free_addrs[--xsk->num_free];
+
+    return xsk->umem + xsk->tx_reserved;
+}
+
+void xdp_socket_tx_commit(struct xdp_socket *xsk, size_t len)
+{
+    struct xdp_ring *tx = &xsk->tx;
+    struct xdp_desc *desc;
+
+    // The TX ring holds all frames, so there is always room for one more
+    desc = &((struct xdp_desc *)tx->descs)[tx->cached_prod & tx->mask];
+    desc->addr = xsk->tx_reserved;
+    desc->len = len;
+    desc->options = 0;
+    tx->cached_prod++;
+
+    xsk->tx_reserved = UINT64_MAX;
+}
+
+int xdp_socket_tx_flush(struct xdp_socket *xsk)
+{
+    __atomic_store_n(xsk->tx.producer, xsk->tx.cached_prod, __ATOMIC_RELEASE);
+
+    if (kick_tx(xsk) < 0)
+        return -1;
+
+    reclaim_tx_frames(xsk);
+
+    return 0;
+}
+
+#else /* OPEN1722_HAVE_AF_XDP */
+
+struct xdp_socket *xdp_socket_open(const char *ifname, unsigned int queue,
+                                   unsigned int num_frames, int rx)
+{
+    fprintf(stderr, "AF_XDP support not available, rebuild with OPEN1722_AF_XDP\n");
+    errno = EOPNOTSUPP;
+    return NULL;
+}
+
+void xdp_socket_close(struct xdp_socket *xsk)
+{
+}
+
+int xdp_socket_fd(struct xdp_socket *xsk)
+{
+    return -1;
+}
+
+int xdp_socket_is_zerocopy(struct xdp_socket *xsk)
+{
+    return 0;
+}
+
+int xdp_socket_rx(struct xdp_socket *xsk, uint8_t **frame, size_t *len)
+{
+    return 0;
+}
+
+uint8_t *xdp_socket_tx_reserve(struct xdp_socket *xsk)
+{
+    return NULL;
+}
+
+void xdp_socket_tx_commit(struct xdp_socket *xsk, size_t len)
+{
+}
+
+int xdp_socket_tx_flush(struct xdp_socket *xsk)
+{
+    return -1;
+}
+
+#endif /* OPEN1722_HAVE_AF_XDP */
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Default number of UMEM frames of an AF_XDP socket */
+#define XDP_SOCKET_NUM_FRAMES   4096
+
+/* Size of each UMEM frame in bytes, the maximum length of an Ethernet frame
+ * including its header.
+ */
+#define XDP_SOCKET_FRAME_SIZE   2048
+
+/* AF_XDP socket bound to one queue of a network interface. Frames are
+ * received and transmitted through a UMEM shared with the kernel:
+ *   - Receive: the fill ring hands empty frames to the kernel, received
+ *     frames come back on the RX ring. A small XDP program attached to the
+ *     interface steers ETH_P_TSN frames (untagged or with one VLAN tag) of
+ *     the queue to the socket, all other traffic passes to the stack.
+ *   - Transmit: frames are queued on the TX ring and come back on the
+ *     completion ring once sent.
+ * Zero-copy mode is used if the driver supports it, copy mode otherwise,
+ * so the socket works on any interface including veth pairs.
+ *
+ * The backend is only available if the examples are built with
+ * OPEN1722_AF_XDP, otherwise xdp_socket_open() fails.
+ */
+struct xdp_socket;
+
+/* Open an AF_XDP socket.
+ * @ifname: Network interface name.
+ * @queue: Queue of the interface to bind to.
+ * @num_frames: Number of UMEM frames, a power of two, e.g.
+ *              XDP_SOCKET_NUM_FRAMES.
+ * @rx: Non-zero to set up the socket for receiving, zero for transmitting.
+ *
+ * Returns:
+ *    Pointer to the socket. Should be closed with xdp_socket_close() when
+ *    done, which also detaches the XDP program.
+ *    NULL: Could not open the socket.
+ */
+struct xdp_socket *xdp_socket_open(const char *ifname, unsigned int queue,
+                                   unsigned int num_frames, int rx);
+
+/* Close a socket opened with xdp_socket_open().
+ * @xsk: Socket to be closed, may be NULL.
+ */
+void xdp_socket_close(struct xdp_socket *xsk);
+
+/* Get the file descriptor of a socket, e.g. to poll() it.
+ * @xsk: Socket to query.
+ *
+ * Returns:
+ *    Socket file descriptor.
+ */
+int xdp_socket_fd(struct xdp_socket *xsk);
+
+/* Check whether a socket runs in zero-copy mode.
+ * @xsk: Socket to query.
+ *
+ * Returns:
+ *    1: Frames are received and sent without copy.
+ *    0: The kernel copies frames to and from the UMEM.
+ */
+int xdp_socket_is_zerocopy(struct xdp_socket *xsk);
+
+/* Get the next received frame without blocking. The frame stays valid until
+ * the next call, after which it is handed back to the kernel.
+ * @xsk: Socket to receive from.
+ * @frame: Pointer to store the pointer to the Ethernet frame in.
+ * @len: Pointer to store the length of the frame in bytes.
+ *
+ * Returns:
+ *    1: A frame was received.
+ *    0: No frame is pending.
+ */
+int xdp_socket_rx(struct xdp_socket *xsk, uint8_t **frame, size_t *len);
+
+/* Reserve the next free UMEM frame for transmission. Reserving again
+ * without a commit returns the same frame. If all frames are in flight, the
+ * call blocks until the kernel has completed one.
+ * @xsk: Socket to transmit on.
+ *
+ * Returns:
+ *    Pointer to a buffer of XDP_SOCKET_FRAME_SIZE bytes.
+ *    NULL: Could not send the pending frames.
+ */
+uint8_t *xdp_socket_tx_reserve(struct xdp_socket *xsk);
+
+/* Queue the Ethernet frame written to the buffer returned by
+ * xdp_socket_tx_reserve().
+ * @xsk: Socket to transmit on.
+ * @len: Length of the frame in bytes.
+ */
+void xdp_socket_tx_commit(struct xdp_socket *xsk, size_t len);
+
+/* Hand all committed frames to the kernel.
+ * @xsk: Socket to transmit on.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not send the frames.
+ */
+int xdp_socket_tx_flush(struct xdp_socket *xsk);
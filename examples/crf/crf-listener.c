@@ -102,6 +102,7 @@
 #include "avtp/Crf.h"
 #include "avtp/aaf/PcmStream.h"
 #include "common/common.h"
+#include "common/packet_ring.h"
 #include "avtp/CommonHeader.h"
 
 #define AAF_STREAM_ID		0xAABBCCDDEEFF0001
@@ -271,126 +272,75 @@ static uint64_t mclk_lookup(uint32_t avtp_time)
 static bool is_valid_crf_pdu(struct avtp_crf_pdu *pdu)
 {
     int res;
-    uint32_t val32;
-    uint64_t val64;
-    struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
+    Avtp_CrfHeader_t header;
 
-    res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
+    res = Avtp_Crf_Unpack((Avtp_Crf_t*)pdu, &header);
     if (res < 0) {
-        fprintf(stderr, "Failed to get CRF subtype field: %d\n", res);
+        fprintf(stderr, "Failed to unpack CRF header: %d\n", res);
         return false;
     }
-    if (val32 != AVTP_SUBTYPE_CRF)
-        return false;
 
-    res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF version field: %d\n", res);
+    if (header.subtype != AVTP_SUBTYPE_CRF)
         return false;
-    }
-    if (val32 != 0) {
+
+    if (header.version != 0) {
         fprintf(stderr, "CRF: Version mismatch: expected %u, got %u\n",
-                                0, val32);
+                                0, header.version);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_SV, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF sv field: %d\n", res);
-        return false;
-    }
-    if (val64 != 1) {
-        fprintf(stderr, "CRF: sv mismatch: expected %u, got %" PRIu64 "\n",
-                                1, val64);
+    if (header.sv != 1) {
+        fprintf(stderr, "CRF: sv mismatch: expected %u, got %u\n",
+                                1, header.sv);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_FS, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF fs field: %d\n", res);
-        return false;
-    }
-    if (val64 != 0) {
-        fprintf(stderr, "CRF: fs mismatch: expected %u, got %" PRIu64 "\n",
-                                0, val64);
+    if (header.fs != 0) {
+        fprintf(stderr, "CRF: fs mismatch: expected %u, got %u\n",
+                                0, header.fs);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_SEQ_NUM, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF sequence num field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != crf_seq_num) {
+    if (header.sequence_num != crf_seq_num) {
         /* If we have a sequence number mismatch, we simply log the
          * issue and continue to process the packet. We don't want to
          * invalidate it since it is a valid packet after all.
          */
-        fprintf(stderr, "CRF: Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-                            crf_seq_num, val64);
+        fprintf(stderr, "CRF: Sequence number mismatch: expected %u, got %u\n",
+                            crf_seq_num, header.sequence_num);
 
-        crf_seq_num = val64;
+        crf_seq_num = header.sequence_num;
     }
 
     crf_seq_num++;
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_TYPE, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF format field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_CRF_TYPE_AUDIO_SAMPLE) {
-        fprintf(stderr, "CRF: Format mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_CRF_TYPE_AUDIO_SAMPLE, val64);
+    if (header.type != AVTP_CRF_TYPE_AUDIO_SAMPLE) {
+        fprintf(stderr, "CRF: Format mismatch: expected %u, got %u\n",
+                    AVTP_CRF_TYPE_AUDIO_SAMPLE, header.type);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_STREAM_ID, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF stream ID field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != CRF_STREAM_ID) {
+    if (header.stream_id != CRF_STREAM_ID) {
         fprintf(stderr, "CRF: Stream ID mismatch: expected %" PRIu64 ", got %" PRIu64 "\n",
-                            CRF_STREAM_ID, val64);
+                            CRF_STREAM_ID, header.stream_id);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_PULL, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF multiplier modifier field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != AVTP_CRF_PULL_MULT_BY_1) {
-        fprintf(stderr, "CRF Pull mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_CRF_PULL_MULT_BY_1, val64);
+    if (header.pull != AVTP_CRF_PULL_MULT_BY_1) {
+        fprintf(stderr, "CRF Pull mismatch: expected %u, got %u\n",
+                    AVTP_CRF_PULL_MULT_BY_1, header.pull);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_BASE_FREQ, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF base frequency field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != CRF_SAMPLE_RATE) {
-        fprintf(stderr, "CRF Base frequency: expected %u, got %" PRIu64 "\n",
-                        CRF_SAMPLE_RATE, val64);
+    if (header.base_frequency != CRF_SAMPLE_RATE) {
+        fprintf(stderr, "CRF Base frequency: expected %u, got %u\n",
+                        CRF_SAMPLE_RATE, header.base_frequency);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_CRF_DATA_LEN, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF data length field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != CRF_DATA_LEN) {
-        fprintf(stderr, "CRF Data length mismatch: expected %zu, got %" PRIu64 "\n",
-                            CRF_DATA_LEN, val64);
+    if (header.crf_data_length != CRF_DATA_LEN) {
+        fprintf(stderr, "CRF Data length mismatch: expected %zu, got %u\n",
+                            CRF_DATA_LEN, header.crf_data_length);
         return false;
     }
 
@@ -731,19 +681,10 @@ static int handle_aaf_pdu(struct avtp_stream_pdu *pdu)
     return 0;
 }
 
-static int aaf_talker_recv_pdu(int fd_sk, int fd_timer)
+static int aaf_talker_recv_pdu(uint8_t *frame, size_t n, int fd_timer)
 {
     int res;
-    ssize_t n;
-    struct avtp_crf_pdu *pdu = alloca(CRF_PDU_SIZE);
-
-    memset(pdu, 0, CRF_PDU_SIZE);
-
-    n = recv(fd_sk, pdu, CRF_PDU_SIZE, 0);
-    if (n < 0) {
-        perror("Failed to receive data");
-        return -1;
-    }
+    struct avtp_crf_pdu *pdu = (struct avtp_crf_pdu *) frame;
 
     /* The protocol type from rx socket is set to ETH_P_ALL so we receive
      * non-AVTP packets as well. In order to filter out those packets, we
@@ -778,22 +719,13 @@ static int aaf_talker_recv_pdu(int fd_sk, int fd_timer)
     return 0;
 }
 
-static int aaf_listener_recv_pdu(int fd)
+static int aaf_listener_recv_pdu(uint8_t *frame, size_t n)
 {
     int res;
-    ssize_t n;
     uint32_t val;
-    void *pdu = alloca(MAX_PDU_SIZE);
+    void *pdu = frame;
     struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
 
-    memset(pdu, 0, MAX_PDU_SIZE);
-
-    n = recv(fd, pdu, MAX_PDU_SIZE, 0);
-    if (n < 0) {
-        perror("Failed to receive data");
-        return -1;
-    }
-
     /* The protocol type from rx socket is set to ETH_P_ALL so we receive
      * non-AVTP packets as well. In order to filter out those packets, we
      * check the number of bytes received. If it doesn't match the CRF or
@@ -864,13 +796,15 @@ err:
     return -1;
 }
 
-static int aaf_talker(int fd_rx)
+static int aaf_talker(int fd_rx, struct rx_ring *ring)
 {
     int res, fd_tx, fd_timer;
     struct pollfd poll_fd[2];
     struct sockaddr_ll sk_addr = {0};
     struct ifreq req = {0};
     struct avtp_stream_pdu *pdu;
+    uint8_t *frame;
+    size_t len;
 
     fd_tx = socket(AF_PACKET, SOCK_DGRAM, htons(ETH_P_TSN));
     if (fd_tx < 0) {
@@ -923,7 +857,11 @@ static int aaf_talker(int fd_rx)
         }
 
         if (poll_fd[0].revents & POLLIN) {
-            res = aaf_talker_recv_pdu(fd_rx, fd_timer);
+            while ((res = rx_ring_next(ring, &frame, &len)) > 0) {
+                res = aaf_talker_recv_pdu(frame, len, fd_timer);
+                if (res < 0)
+                    goto fd_timer_close;
+            }
             if (res < 0)
                 goto fd_timer_close;
         }
@@ -947,12 +885,22 @@ fd_tx_close:
     return 1;
 }
 
-static int aaf_listener(int fd_rx)
+static int aaf_listener(struct rx_ring *ring)
 {
     int res;
+    uint8_t *frame;
+    size_t len;
 
     while (1) {
-        res = aaf_listener_recv_pdu(fd_rx);
+        res = rx_ring_wait(ring, -1);
+        if (res < 0)
+            return -1;
+
+        while ((res = rx_ring_next(ring, &frame, &len)) > 0) {
+            res = aaf_listener_recv_pdu(frame, len);
+            if (res < 0)
+                return -1;
+        }
         if (res < 0)
             return -1;
     }
@@ -961,6 +909,7 @@ static int aaf_listener(int fd_rx)
 int main(int argc, char *argv[])
 {
     int fd_rx;
+    struct rx_ring *ring;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -971,15 +920,23 @@ int main(int argc, char *argv[])
     if (fd_rx < 0)
         return 1;
 
+    ring = rx_ring_alloc(fd_rx, RX_RING_BLOCK_SIZE, RX_RING_NUM_BLOCKS,
+                         RX_RING_RETIRE_MS);
+    if (!ring) {
+        close(fd_rx);
+        return 1;
+    }
+
     switch (mode) {
     case MODE_LISTENER:
-        aaf_listener(fd_rx);
+        aaf_listener(ring);
         break;
     case MODE_TALKER:
-        aaf_talker(fd_rx);
+        aaf_talker(fd_rx, ring);
         break;
     }
 
+    rx_ring_free(ring);
     close(fd_rx);
     return 0;
 }
@@ -62,8 +62,11 @@
 #include <unistd.h>
 #include <math.h>
 
+#include "avtp/Byteorder.h"
 #include "avtp/Crf.h"
+#include "avtp/StreamTemplate.h"
 #include "common/common.h"
+#include "common/packet_ring.h"
 #include "avtp/CommonHeader.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0002
@@ -87,11 +90,13 @@
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static int mtt;
+static int qdisc_bypass;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
     {"max-transit-time", 'm', "MSEC", 0, "Maximum Transit Time in ms" },
+    {"qdisc-bypass", 'q', 0, 0, "Bypass the qdisc layer (no traffic shaping)" },
     { 0 }
 };
 
@@ -116,6 +121,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'm':
         mtt = atoi(arg) * NSEC_PER_MSEC;
         break;
+    case 'q':
+        qdisc_bypass = 1;
+        break;
     }
 
     return 0;
@@ -197,9 +205,12 @@ int main(int argc, char *argv[])
     int sk_fd, res, idx;
     uint8_t seq_num = 0;
     uint64_t crf_time, rounded_mtt;
+    uint64_t crf_data[TIMESTAMPS_PER_PKT];
     struct timespec clksrc_ts = {0};
     struct sockaddr_ll sk_addr = {0};
     struct avtp_crf_pdu *pdu = alloca(PDU_SIZE);
+    Avtp_StreamTemplate_t tmpl;
+    struct tx_ring *ring = NULL;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -216,6 +227,15 @@ int main(int argc, char *argv[])
     if (res < 0)
         goto err;
 
+    res = Avtp_StreamTemplate_Init(&tmpl, (uint8_t *) pdu, AVTP_CRF_HEADER_LEN);
+    if (res < 0)
+        goto err;
+
+    ring = tx_ring_alloc(sk_fd, (struct sockaddr *) &sk_addr, sizeof(sk_addr),
+                         PDU_SIZE, TX_RING_NUM_FRAMES, qdisc_bypass);
+    if (!ring)
+        goto err;
+
     res = clock_gettime(CLOCK_REALTIME, &clksrc_ts);
     if (res < 0) {
         perror("Failed to get time");
@@ -225,27 +245,25 @@ int main(int argc, char *argv[])
     rounded_mtt = ceil(mtt / NOMINAL_PERIOD) * NOMINAL_PERIOD;
 
     while (1) {
-        ssize_t n;
+        // Build the PDU in place in the transmit ring
+        pdu = (struct avtp_crf_pdu *) tx_ring_reserve(ring);
+        if (!pdu)
+            goto err;
 
         crf_time = calculate_crf_timestamp(clksrc_ts, rounded_mtt);
         for (idx = 0; idx < TIMESTAMPS_PER_PKT; idx++)
-            pdu->crf_data[idx] = htobe64(crf_time + (CRF_PERIOD * idx));
+            crf_data[idx] = crf_time + (CRF_PERIOD * idx);
+        Avtp_CpuToBeArray64(pdu->crf_data, crf_data, TIMESTAMPS_PER_PKT);
 
-        res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_SEQ_NUM, seq_num++);
-        if (res < 0)
-            goto err;
+        Avtp_StreamTemplate_Emit(&tmpl, (uint8_t *) pdu, seq_num++, 0,
+                                DATA_LEN);
 
-        n = sendto(sk_fd, pdu, PDU_SIZE, 0,
-                (struct sockaddr *) &sk_addr, sizeof(sk_addr));
-        if (n < 0) {
-            perror("Failed to send data");
-            goto err;
-        }
+        tx_ring_commit(ring, PDU_SIZE);
 
-        if (n != PDU_SIZE) {
-            fprintf(stderr, "wrote %zd bytes, expected %zd\n",
-                                n, PDU_SIZE);
-        }
+        // The PDUs are paced at TX_INTERVAL and each one is due at its own
+        // pacing deadline, so there is never more than one to flush
+        if (tx_ring_flush(ring) < 0)
+            goto err;
 
         clksrc_ts.tv_nsec += TX_INTERVAL;
         if (clksrc_ts.tv_nsec >= NSEC_PER_SEC) {
@@ -255,10 +273,12 @@ int main(int argc, char *argv[])
         clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &clksrc_ts, NULL);
     }
 
+    tx_ring_free(ring);
     close(sk_fd);
     return 0;
 
 err:
+    tx_ring_free(ring);
     close(sk_fd);
     return 1;
 }
@@ -76,6 +76,7 @@
 #include "avtp/cvf/H264.h"
 #include "avtp/CommonHeader.h"
 #include "common/common.h"
+#include "common/packet_ring.h"
 
 #define STREAM_ID				0xAABBCCDDEEFF0001
 #define DATA_LEN				1400
@@ -94,11 +95,13 @@ struct nal_entry {
 static STAILQ_HEAD(nal_queue, nal_entry) nals;
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
+static int xdp_queue = -1;
 static uint8_t expected_seq;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
+    {"xdp", 'x', "QUEUE", 0, "Receive through an AF_XDP socket on the given queue" },
     { 0 }
 };
 
@@ -120,6 +123,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'i':
         strncpy(ifname, arg, sizeof(ifname) - 1);
         break;
+    case 'x':
+        xdp_queue = atoi(arg);
+        break;
     }
 
     return 0;
@@ -269,23 +275,19 @@ static int get_h264_data_len(Avtp_Cvf_t* cvfHeader, uint16_t *stream_data_len)
     return 0;
 }
 
-static int new_packet(int sk_fd, int timer_fd)
+static int new_packet(uint8_t *frame, size_t len, int timer_fd)
 {
     int res;
-    ssize_t n;
     uint16_t h264_data_len;
     uint64_t avtp_time;
     struct timespec tspec;
-    Avtp_Cvf_t* cvfHeader = alloca(MAX_PDU_SIZE);
+    Avtp_Cvf_t* cvfHeader = (Avtp_Cvf_t*) frame;
     Avtp_H264_t* h264Header = (Avtp_H264_t*)(&cvfHeader->payload);
     uint8_t* h264Payload = (uint8_t*)(&h264Header->payload);
 
-    memset(cvfHeader, 1, MAX_PDU_SIZE);
-
-    n = recv(sk_fd, cvfHeader, MAX_PDU_SIZE, 0);
-    if (n < 0 || n > MAX_PDU_SIZE) {
-        perror("Failed to receive data");
-        return -1;
+    if (len < AVTP_FULL_HEADER_LEN || len > MAX_PDU_SIZE) {
+        fprintf(stderr, "Dropping packet of %zu bytes\n", len);
+        return 0;
     }
 
     if (!is_valid_packet(cvfHeader)) {
@@ -307,6 +309,12 @@ static int new_packet(int sk_fd, int timer_fd)
     if (res < 0)
         return -1;
 
+    // The NAL is read in place from the received frame
+    if (h264_data_len > len - AVTP_FULL_HEADER_LEN) {
+        fprintf(stderr, "Dropping truncated packet\n");
+        return 0;
+    }
+
     res = schedule_nal(timer_fd, &tspec, h264Payload, h264_data_len);
     if (res < 0)
         return -1;
@@ -354,6 +362,9 @@ int main(int argc, char *argv[])
 {
     int sk_fd, timer_fd, res;
     struct pollfd fds[2];
+    struct rx_ring *ring;
+    uint8_t *frame;
+    size_t len;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -363,13 +374,25 @@ int main(int argc, char *argv[])
     if (sk_fd < 0)
         return 1;
 
+    // The socket keeps the multicast membership in AF_XDP mode
+    if (xdp_queue >= 0)
+        ring = rx_ring_alloc_xdp(ifname, macaddr, xdp_queue);
+    else
+        ring = rx_ring_alloc(sk_fd, RX_RING_BLOCK_SIZE, RX_RING_NUM_BLOCKS,
+                             RX_RING_RETIRE_MS);
+    if (!ring) {
+        close(sk_fd);
+        return 1;
+    }
+
     timer_fd = timerfd_create(CLOCK_REALTIME, 0);
     if (timer_fd < 0) {
+        rx_ring_free(ring);
         close(sk_fd);
         return 1;
     }
 
-    fds[0].fd = sk_fd;
+    fds[0].fd = rx_ring_fd(ring);
     fds[0].events = POLLIN;
     fds[1].fd = timer_fd;
     fds[1].events = POLLIN;
@@ -382,7 +405,11 @@ int main(int argc, char *argv[])
         }
 
         if (fds[0].revents & POLLIN) {
-            res = new_packet(sk_fd, timer_fd);
+            while ((res = rx_ring_next(ring, &frame, &len)) > 0) {
+                res = new_packet(frame, len, timer_fd);
+                if (res < 0)
+                    goto err;
+            }
             if (res < 0)
                 goto err;
         }
@@ -397,6 +424,7 @@ int main(int argc, char *argv[])
     return 0;
 
 err:
+    rx_ring_free(ring);
     close(sk_fd);
     close(timer_fd);
     return 1;
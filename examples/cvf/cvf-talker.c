@@ -78,6 +78,7 @@
 #include "avtp/cvf/Cvf.h"
 #include "avtp/cvf/H264.h"
 #include "common/common.h"
+#include "common/packet_ring.h"
 #include "avtp/CommonHeader.h"
 
 #define STREAM_ID				0xAABBCCDDEEFF0001
@@ -90,6 +91,8 @@ static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static int priority = -1;
 static int max_transit_time;
+static int qdisc_bypass;
+static int xdp_queue = -1;
 
 static char buffer[MAX_PDU_SIZE * 2];
 static size_t buffer_level;
@@ -103,6 +106,8 @@ static struct argp_option options[] = {
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
     {"max-transit-time", 'm', "MSEC", 0, "Maximum Transit Time in ms" },
     {"prio", 'p', "NUM", 0, "SO_PRIORITY to be set in socket" },
+    {"qdisc-bypass", 'q', 0, 0, "Bypass the qdisc layer (no traffic shaping)" },
+    {"xdp", 'x', "QUEUE", 0, "Transmit through an AF_XDP socket on the given queue" },
     { 0 }
 };
 
@@ -130,6 +135,12 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'p':
         priority = atoi(arg);
         break;
+    case 'q':
+        qdisc_bypass = 1;
+        break;
+    case 'x':
+        xdp_queue = atoi(arg);
+        break;
     }
 
     return 0;
@@ -264,6 +275,8 @@ int main(int argc, char *argv[])
     struct sockaddr_ll sk_addr;
     uint8_t* pdu = alloca(MAX_PDU_SIZE);
     Avtp_Cvf_t* cvf = (Avtp_Cvf_t*)pdu;
+    struct tx_ring *ring = NULL;
+    uint8_t* frame;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -279,6 +292,14 @@ int main(int argc, char *argv[])
     if (res < 0)
         goto err;
 
+    if (xdp_queue >= 0)
+        ring = tx_ring_alloc_xdp(ifname, macaddr, MAX_PDU_SIZE, xdp_queue);
+    else
+        ring = tx_ring_alloc(fd, (struct sockaddr *) &sk_addr, sizeof(sk_addr),
+                             MAX_PDU_SIZE, TX_RING_NUM_FRAMES, qdisc_bypass);
+    if (!ring)
+        goto err;
+
     while (1) {
         ssize_t n;
         bool end = false;
@@ -288,29 +309,36 @@ int main(int argc, char *argv[])
             end = true;
 
         while (buffer_level > 0) {
+            // Build the PDU in place in the transmit ring
+            frame = tx_ring_reserve(ring);
+            if (!frame)
+                goto err;
+            memcpy(frame, pdu, AVTP_FULL_HEADER_LEN);
+
             enum process_result pr =
-                    process_nal(cvf, end, (size_t *)&n);
+                    process_nal((Avtp_Cvf_t*)frame, end, (size_t *)&n);
             if (pr == PROCESS_ERROR)
                 goto err;
             if (pr == PROCESS_NONE)
                 break;
 
-            n = sendto(fd, pdu, AVTP_FULL_HEADER_LEN + n, 0,
-                (struct sockaddr *) &sk_addr, sizeof(sk_addr));
-            if (n < 0) {
-                perror("Failed to send data");
-                goto err;
-            }
+            tx_ring_commit(ring, AVTP_FULL_HEADER_LEN + n);
         }
 
+        // Send all NAL units found in this chunk of input at once
+        if (tx_ring_flush(ring) < 0)
+            goto err;
+
         if (end)
             break;
     }
 
+    tx_ring_free(ring);
     close(fd);
     return 0;
 
 err:
+    tx_ring_free(ring);
     close(fd);
     return 1;
 }
@@ -28,7 +28,9 @@
  */
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,8 +41,12 @@ extern "C" {
  */
 static inline uint16_t Avtp_Bswap16(uint16_t x)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap16(x);
+#else
     return    ((x & 0xff00u) >> 8u)
             | ((x & 0x00ffu) << 8u);
+#endif
 }
 
 /**
@@ -48,10 +54,14 @@ static inline uint16_t Avtp_Bswap16(uint16_t x)
  */
 static inline uint32_t Avtp_Bswap32(uint32_t x)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(x);
+#else
     return    ((x & 0xff000000u) >> 24u)
             | ((x & 0x00ff0000u) >>  8u)
             | ((x & 0x0000ff00u) <<  8u)
             | ((x & 0x000000ffu) << 24u);
+#endif
 }
 
 /**
@@ -59,6 +69,9 @@ static inline uint32_t Avtp_Bswap32(uint32_t x)
  */
 static inline uint64_t Avtp_Bswap64(uint64_t x)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(x);
+#else
     return    ((x & 0xff00000000000000u) >> 56u)
             | ((x & 0x00ff000000000000u) >> 40u)
             | ((x & 0x0000ff0000000000u) >> 24u)
@@ -67,6 +80,7 @@ static inline uint64_t Avtp_Bswap64(uint64_t x)
             | ((x & 0x0000000000ff0000u) << 24u)
             | ((x & 0x000000000000ff00u) << 40u)
             | ((x & 0x00000000000000ffu) << 56u);
+#endif
 }
 
 #if(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
@@ -99,6 +113,126 @@ static inline uint32_t Avtp_BeToCpu32(uint32_t x) { return x; }
 static inline uint64_t Avtp_BeToCpu64(uint64_t x) { return x; }
 #endif
 
+/**
+ * The following functions read and write big-endian (network byte-order)
+ * integers at arbitrary addresses. The memory is accessed through memcpy() so
+ * that no alignment is required and no strict-aliasing rules are violated.
+ * With optimizations enabled, GCC and Clang reduce each of them to a single
+ * load or store plus a byte-swap instruction on x86-64 (mov/bswap or movbe)
+ * and AArch64 (ldr/rev), which both support unaligned accesses.
+ */
+
+/**
+ * Reads a big-endian 16bit integer from an arbitrarily aligned address.
+ */
+static inline uint16_t Avtp_LoadBe16(const void* ptr)
+{
+    uint16_t x;
+    memcpy(&x, ptr, sizeof(x));
+    return Avtp_BeToCpu16(x);
+}
+
+/**
+ * Reads a big-endian 32bit integer from an arbitrarily aligned address.
+ */
+static inline uint32_t Avtp_LoadBe32(const void* ptr)
+{
+    uint32_t x;
+    memcpy(&x, ptr, sizeof(x));
+    return Avtp_BeToCpu32(x);
+}
+
+/**
+ * Reads a big-endian 64bit integer from an arbitrarily aligned address.
+ */
+static inline uint64_t Avtp_LoadBe64(const void* ptr)
+{
+    uint64_t x;
+    memcpy(&x, ptr, sizeof(x));
+    return Avtp_BeToCpu64(x);
+}
+
+/**
+ * Writes a 16bit integer in big-endian byte-order to an arbitrarily aligned
+ * address.
+ */
+static inline void Avtp_StoreBe16(void* ptr, uint16_t value)
+{
+    uint16_t x = Avtp_CpuToBe16(value);
+    memcpy(ptr, &x, sizeof(x));
+}
+
+/**
+ * Writes a 32bit integer in big-endian byte-order to an arbitrarily aligned
+ * address.
+ */
+static inline void Avtp_StoreBe32(void* ptr, uint32_t value)
+{
+    uint32_t x = Avtp_CpuToBe32(value);
+    memcpy(ptr, &x, sizeof(x));
+}
+
+/**
+ * Writes a 64bit integer in big-endian byte-order to an arbitrarily aligned
+ * address.
+ */
+static inline void Avtp_StoreBe64(void* ptr, uint64_t value)
+{
+    uint64_t x = Avtp_CpuToBe64(value);
+    memcpy(ptr, &x, sizeof(x));
+}
+
+/**
+ * Swaps the byteorder of each element of an array of 16bit integers, e.g. to
+ * convert a block of PCM samples from/to network byte-order. The kernel is
+ * selected at run time (AVX2 or SSSE3 on x86, NEON on ARM, scalar otherwise).
+ * Neither array needs to be aligned and dst may be equal to src to convert in
+ * place, but the arrays must not overlap otherwise.
+ *
+ * @param dst Pointer to the destination array.
+ * @param src Pointer to the source array.
+ * @param n Number of elements to convert.
+ */
+void Avtp_BswapArray16(void* dst, const void* src, size_t n);
+
+/**
+ * Swaps the byteorder of each element of an array of 32bit integers. See
+ * Avtp_BswapArray16().
+ *
+ * @param dst Pointer to the destination array.
+ * @param src Pointer to the source array.
+ * @param n Number of elements to convert.
+ */
+void Avtp_BswapArray32(void* dst, const void* src, size_t n);
+
+/**
+ * Swaps the byteorder of each element of an array of 64bit integers. See
+ * Avtp_BswapArray16().
+ *
+ * @param dst Pointer to the destination array.
+ * @param src Pointer to the source array.
+ * @param n Number of elements to convert.
+ */
+void Avtp_BswapArray64(void* dst, const void* src, size_t n);
+
+#if(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+/* System uses little-endian */
+static inline void Avtp_CpuToBeArray16(void* dst, const void* src, size_t n) { Avtp_BswapArray16(dst, src, n); }
+static inline void Avtp_CpuToBeArray32(void* dst, const void* src, size_t n) { Avtp_BswapArray32(dst, src, n); }
+static inline void Avtp_CpuToBeArray64(void* dst, const void* src, size_t n) { Avtp_BswapArray64(dst, src, n); }
+static inline void Avtp_BeToCpuArray16(void* dst, const void* src, size_t n) { Avtp_BswapArray16(dst, src, n); }
+static inline void Avtp_BeToCpuArray32(void* dst, const void* src, size_t n) { Avtp_BswapArray32(dst, src, n); }
+static inline void Avtp_BeToCpuArray64(void* dst, const void* src, size_t n) { Avtp_BswapArray64(dst, src, n); }
+#else
+/* System uses big-endian */
+static inline void Avtp_CpuToBeArray16(void* dst, const void* src, size_t n) { if (dst != src) memmove(dst, src, n * 2); }
+static inline void Avtp_CpuToBeArray32(void* dst, const void* src, size_t n) { if (dst != src) memmove(dst, src, n * 4); }
+static inline void Avtp_CpuToBeArray64(void* dst, const void* src, size_t n) { if (dst != src) memmove(dst, src, n * 8); }
+static inline void Avtp_BeToCpuArray16(void* dst, const void* src, size_t n) { if (dst != src) memmove(dst, src, n * 2); }
+static inline void Avtp_BeToCpuArray32(void* dst, const void* src, size_t n) { if (dst != src) memmove(dst, src, n * 4); }
+static inline void Avtp_BeToCpuArray64(void* dst, const void* src, size_t n) { if (dst != src) memmove(dst, src, n * 8); }
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,7 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/Utils.h"
 
 #define AVTP_COMMON_HEADER_LEN             (1 * AVTP_QUADLET_SIZE)
 
@@ -61,6 +62,22 @@ typedef enum Avtp_CommonHeaderField{
     AVTP_COMMON_HEADER_FIELD_MAX
 } Avtp_CommonHeaderField_t;
 
+/**
+ * Position of all AVTP common header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_COMMON_HEADER_FIELD_LIST(X, prefix, type)                    \
+    /* Common AVTP header */                                              \
+    X(prefix, type, AVTP_COMMON_HEADER_FIELD_SUBTYPE, Subtype, 0,  0,  8) \
+    X(prefix, type, AVTP_COMMON_HEADER_FIELD_H,       H,       0,  8,  1) \
+    X(prefix, type, AVTP_COMMON_HEADER_FIELD_VERSION, Version, 0,  9,  3)
+
+/**
+ * Specialized accessors for each AVTP common header field, e.g.
+ * Avtp_CommonHeader_GetSubtype() and Avtp_CommonHeader_SetSubtype().
+ */
+AVTP_COMMON_HEADER_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_CommonHeader, Avtp_CommonHeader_t)
+
 typedef enum {
     AVTP_SUBTYPE_61883_IIDC        = 0x0,
     AVTP_SUBTYPE_MMA_STREAM        = 0x1,
@@ -106,6 +123,27 @@ int Avtp_CommonHeader_GetField(Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderF
  */
 int Avtp_CommonHeader_SetField(Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderField_t field, uint64_t value);
 
+/**
+ * Same as Avtp_CommonHeader_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param avtp_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_CommonHeader_GetField_Unchecked(const Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderField_t field);
+
+/**
+ * Same as Avtp_CommonHeader_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param avtp_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_CommonHeader_SetField_Unchecked(Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderField_t field, uint64_t value);
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
@@ -32,11 +32,12 @@
 
 #include <stdint.h>
 
+#include "avtp/PduView.h"
 #include "avtp/Utils.h"
 
 #define AVTP_CRF_HEADER_LEN     (5 * AVTP_QUADLET_SIZE)
 
-typedef struct Avtp_Cvf {
+typedef struct Avtp_Crf {
     uint8_t header[AVTP_CRF_HEADER_LEN];
     uint8_t payload[0];
 } Avtp_Crf_t;
@@ -76,12 +77,112 @@ typedef enum Avtp_CrfField {
     AVTP_CRF_FIELD_MAX,
 }Avtp_CrfField_t;
 
+/**
+ * Position of all CRF header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_CRF_FIELD_LIST(X, prefix, type)                                         \
+    X(prefix, type, AVTP_CRF_FIELD_SUBTYPE,            Subtype,           0,  0,  8) \
+    X(prefix, type, AVTP_CRF_FIELD_SV,                 Sv,                0,  8,  1) \
+    X(prefix, type, AVTP_CRF_FIELD_VERSION,            Version,           0,  9,  3) \
+    X(prefix, type, AVTP_CRF_FIELD_MR,                 Mr,                0, 12,  1) \
+    X(prefix, type, AVTP_CRF_FIELD_RESERVED,           Reserved,          0, 13,  1) \
+    X(prefix, type, AVTP_CRF_FIELD_FS,                 Fs,                0, 14,  1) \
+    X(prefix, type, AVTP_CRF_FIELD_TU,                 Tu,                0, 15,  1) \
+    X(prefix, type, AVTP_CRF_FIELD_SEQUENCE_NUM,       SequenceNum,       0, 16,  8) \
+    X(prefix, type, AVTP_CRF_FIELD_TYPE,               Type,              0, 24,  8) \
+    X(prefix, type, AVTP_CRF_FIELD_STREAM_ID,          StreamId,          1,  0, 64) \
+    X(prefix, type, AVTP_CRF_FIELD_PULL,               Pull,              3,  0,  3) \
+    X(prefix, type, AVTP_CRF_FIELD_BASE_FREQUENCY,     BaseFrequency,     3,  3, 29) \
+    X(prefix, type, AVTP_CRF_FIELD_CRF_DATA_LENGTH,    CrfDataLength,     4,  0, 16) \
+    X(prefix, type, AVTP_CRF_FIELD_TIMESTAMP_INTERVAL, TimestampInterval, 4, 16, 16)
+
+/**
+ * Specialized accessors for each CRF header field, e.g.
+ * Avtp_Crf_GetBaseFrequency() and Avtp_Crf_SetBaseFrequency().
+ */
+AVTP_CRF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Crf, Avtp_Crf_t)
+
+/**
+ * Host byte-order representation of all CRF header fields. Reserved bits are
+ * not represented and are cleared by Avtp_Crf_Pack().
+ */
+typedef struct {
+    uint8_t  subtype;
+    uint8_t  sv;
+    uint8_t  version;
+    uint8_t  mr;
+    uint8_t  fs;
+    uint8_t  tu;
+    uint8_t  sequence_num;
+    uint8_t  type;
+    uint64_t stream_id;
+    uint8_t  pull;
+    uint32_t base_frequency;
+    uint16_t crf_data_length;
+    uint16_t timestamp_interval;
+} Avtp_CrfHeader_t;
+
 int Avtp_Crf_Init(Avtp_Crf_t* pdu);
 
 int Avtp_Crf_GetField(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t* value);
 
 int Avtp_Crf_SetField(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t value);
 
+/**
+ * Same as Avtp_Crf_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Crf_GetField_Unchecked(const Avtp_Crf_t* pdu, Avtp_CrfField_t field);
+
+/**
+ * Same as Avtp_Crf_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Crf_SetField_Unchecked(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t value);
+
+/**
+ * Decodes all header fields of a CRF PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of a 1722 CRF PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_Crf_Unpack(const Avtp_Crf_t* pdu, Avtp_CrfHeader_t* header);
+
+/**
+ * Encodes all header fields of a CRF PDU in a single pass. This is the
+ * counterpart of Avtp_Crf_Unpack().
+ *
+ * @param pdu Pointer to the first bit of a 1722 CRF PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_Crf_Pack(Avtp_Crf_t* pdu, const Avtp_CrfHeader_t* header);
+
+/**
+ * Creates a view of a received CRF PDU. Checks that the buffer holds the
+ * complete CRF header, that the subtype matches and that the payload announced
+ * by crf_data_length fits into the buffer. On success the view covers the
+ * header and the payload, which can then be accessed without further checks.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the received CRF PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete CRF PDU.
+ */
+int Avtp_Crf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
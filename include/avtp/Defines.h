@@ -56,3 +56,12 @@ typedef struct Avtp_FieldDescriptor {
     uint8_t offset;
     uint8_t bits;
 } Avtp_FieldDescriptor_t;
+
+/**
+ * A data field of a 1722 frame together with its value. This is used to read
+ * or write several data fields of a PDU with a single call.
+ */
+typedef struct Avtp_FieldValue {
+    uint8_t field;
+    uint64_t value;
+} Avtp_FieldValue_t;
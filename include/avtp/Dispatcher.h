@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Demultiplexes received 1722 PDUs by their subtype.
+ *
+ * A dispatcher holds one entry per possible subtype value. Dispatching a PDU
+ * reads its first byte, looks up the entry of that subtype, validates the PDU
+ * with the view constructor of the format (e.g. Avtp_Crf_InitView()) and
+ * passes the resulting view to the registered handler. Handlers can therefore
+ * access the header and payload of their format without further checks.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp/PduView.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVTP_DISPATCHER_NUM_SUBTYPES    256
+
+/**
+ * Handler invoked for a dispatched PDU.
+ *
+ * @param view View of the PDU, validated for the format of its subtype.
+ * @param ctx The context pointer passed when the handler was registered.
+ * @returns The value is returned by Avtp_Dispatcher_Dispatch().
+ */
+typedef int (*Avtp_DispatchHandler_t)(const Avtp_PduView_t* view, void* ctx);
+
+/**
+ * View constructor used to validate the PDUs of a subtype. Has the signature
+ * of the per-format constructors like Avtp_Ntscf_InitView().
+ */
+typedef int (*Avtp_DispatchInitView_t)(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
+typedef struct Avtp_DispatchEntry {
+    Avtp_DispatchInitView_t initView;
+    Avtp_DispatchHandler_t handler;
+    void* ctx;
+} Avtp_DispatchEntry_t;
+
+typedef struct Avtp_Dispatcher {
+    Avtp_DispatchEntry_t entries[AVTP_DISPATCHER_NUM_SUBTYPES];
+    Avtp_DispatchEntry_t fallback;
+} Avtp_Dispatcher_t;
+
+/**
+ * Initializes a dispatcher without any registered handlers.
+ *
+ * @param dispatcher Pointer to the dispatcher.
+ * @returns This function returns 0 if the dispatcher was successfully
+ * initialized.
+ */
+int Avtp_Dispatcher_Init(Avtp_Dispatcher_t* dispatcher);
+
+/**
+ * Registers the handler of a subtype, replacing any previous one. PDUs of
+ * the subtypes AAF, CRF, CVF, RVF, NTSCF and TSCF are validated with the view
+ * constructor of their format before the handler is invoked. For all other
+ * subtypes the handler receives the unvalidated view of the received bytes.
+ *
+ * @param dispatcher Pointer to the dispatcher.
+ * @param subtype Subtype (see Avtp_AvtpSubtype_t) to register the handler for.
+ * @param handler Handler to invoke, or NULL to unregister the subtype.
+ * @param ctx Context pointer passed to the handler.
+ * @returns This function returns 0 if the handler was successfully registered.
+ */
+int Avtp_Dispatcher_Register(Avtp_Dispatcher_t* dispatcher, uint8_t subtype,
+                            Avtp_DispatchHandler_t handler, void* ctx);
+
+/**
+ * Registers a handler that is invoked for every subtype without a handler of
+ * its own. The handler receives the unvalidated view of the received bytes.
+ *
+ * @param dispatcher Pointer to the dispatcher.
+ * @param handler Handler to invoke, or NULL to drop such PDUs.
+ * @param ctx Context pointer passed to the handler.
+ * @returns This function returns 0 if the handler was successfully registered.
+ */
+int Avtp_Dispatcher_SetDefault(Avtp_Dispatcher_t* dispatcher,
+                            Avtp_DispatchHandler_t handler, void* ctx);
+
+/**
+ * Validates a received PDU and invokes the handler registered for its
+ * subtype.
+ *
+ * @param dispatcher Pointer to the dispatcher.
+ * @param buf Pointer to the first byte of the received PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns The return value of the handler, -ENOENT if no handler is
+ * registered for the subtype or -EINVAL if the PDU is truncated or invalid
+ * for its format.
+ */
+static inline int Avtp_Dispatcher_Dispatch(const Avtp_Dispatcher_t* dispatcher,
+                            const uint8_t* buf, size_t len)
+{
+    Avtp_PduView_t view;
+
+    if (len < 1) {
+        return -EINVAL;
+    }
+
+    const Avtp_DispatchEntry_t* entry = &dispatcher->entries[buf[0]];
+    if (entry->handler == NULL) {
+        entry = &dispatcher->fallback;
+        if (entry->handler == NULL) {
+            return -ENOENT;
+        }
+    }
+
+    if (entry->initView == NULL) {
+        view.base = buf;
+        view.len = len;
+    } else if (entry->initView(&view, buf, len) < 0) {
+        return -EINVAL;
+    }
+
+    return entry->handler(&view, entry->ctx);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Length-aware, read-only view of a received 1722 PDU.
+ *
+ * The field accessors of the individual formats do not know how many bytes of
+ * a PDU are actually present in the receive buffer. A view pairs a pointer to
+ * a PDU with its length. Views are created by the per-format constructors
+ * (e.g. Avtp_Ntscf_InitView()) which check once that the buffer holds the
+ * complete header and the payload announced by the length field of the
+ * header. After that, header fields can be read with the specialized inline
+ * accessors and the payload can be accessed in place without further checks.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Avtp_PduView {
+    const uint8_t* base;
+    size_t len;
+} Avtp_PduView_t;
+
+/**
+ * Creates a view of an unparsed buffer, e.g. a whole received frame.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the buffer.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the view was successfully initialized.
+ */
+static inline int Avtp_PduView_Init(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = len;
+
+    return 0;
+}
+
+/**
+ * Creates a view of the bytes of a view starting at the given offset, e.g. of
+ * the payload following a header or of the data following a message. The
+ * offset is checked against the length of the view.
+ *
+ * @param view Pointer to the view to slice.
+ * @param offset Number of bytes to skip.
+ * @param rest Pointer to the view to store the remaining bytes in. May be the
+ * same as view.
+ * @returns This function returns 0 if the offset is within the view.
+ */
+static inline int Avtp_PduView_Advance(const Avtp_PduView_t* view, size_t offset,
+                            Avtp_PduView_t* rest)
+{
+    if (offset > view->len) {
+        return -EINVAL;
+    }
+
+    rest->base = view->base + offset;
+    rest->len = view->len - offset;
+
+    return 0;
+}
+
+/**
+ * Same as Avtp_PduView_Advance() but without checking the offset. Meant for
+ * offsets that were already validated by a view constructor, e.g. the header
+ * length of the format.
+ *
+ * @param view Pointer to the view to slice.
+ * @param offset Number of bytes to skip. Must not exceed view->len.
+ * @returns The view of the remaining bytes.
+ */
+static inline Avtp_PduView_t Avtp_PduView_Tail(const Avtp_PduView_t* view, size_t offset)
+{
+    Avtp_PduView_t rest = { view->base + offset, view->len - offset };
+    return rest;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -33,9 +33,11 @@
 
 #include <stdint.h>
 
+#include "avtp/PduView.h"
 #include "avtp/Utils.h"
 
 #define AVTP_RVF_HEADER_LEN (8 * AVTP_QUADLET_SIZE)
+#define AVTP_RVF_RAW_HEADER_LEN (2 * AVTP_QUADLET_SIZE)
 
 typedef struct Avtp_Rvf {
     uint8_t header[AVTP_RVF_HEADER_LEN];
@@ -79,6 +81,81 @@ typedef enum Avtp_RvfField {
     AVTP_RVF_FIELD_MAX
 } Avtp_RvfField_t;
 
+/**
+ * Position of all RVF header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_RVF_FIELD_LIST(X, prefix, type)                                        \
+    X(prefix, type, AVTP_RVF_FIELD_SUBTYPE,            Subtype,          0,  0,  8) \
+    X(prefix, type, AVTP_RVF_FIELD_SV,                 Sv,               0,  8,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_VERSION,            Version,          0,  9,  3) \
+    X(prefix, type, AVTP_RVF_FIELD_MR,                 Mr,               0, 12,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_RESERVED,           Reserved,         0, 13,  2) \
+    X(prefix, type, AVTP_RVF_FIELD_TV,                 Tv,               0, 15,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_SEQUENCE_NUM,       SequenceNum,      0, 16,  8) \
+    X(prefix, type, AVTP_RVF_FIELD_RESERVED_2,         Reserved2,        0, 24,  7) \
+    X(prefix, type, AVTP_RVF_FIELD_TU,                 Tu,               0, 31,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_STREAM_ID,          StreamId,         1,  0, 64) \
+    X(prefix, type, AVTP_RVF_FIELD_AVTP_TIMESTAMP,     AvtpTimestamp,    3,  0, 32) \
+    X(prefix, type, AVTP_RVF_FIELD_ACTIVE_PIXELS,      ActivePixels,     4,  0, 16) \
+    X(prefix, type, AVTP_RVF_FIELD_TOTAL_LINES,        TotalLines,       4, 16, 16) \
+    X(prefix, type, AVTP_RVF_FIELD_STREAM_DATA_LENGTH, StreamDataLength, 5,  0, 16) \
+    X(prefix, type, AVTP_RVF_FIELD_AP,                 Ap,               5, 16,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_RESERVED_3,         Reserved3,        5, 17,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_F,                  F,                5, 18,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_EF,                 Ef,               5, 19,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_EVT,                Evt,              5, 20,  4) \
+    X(prefix, type, AVTP_RVF_FIELD_PD,                 Pd,               5, 24,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_I,                  I,                5, 25,  1) \
+    X(prefix, type, AVTP_RVF_FIELD_RESERVED_4,         Reserved4,        5, 26,  6) \
+    X(prefix, type, AVTP_RVF_FIELD_RESERVED_5,         Reserved5,        6,  0,  8) \
+    X(prefix, type, AVTP_RVF_FIELD_PIXEL_DEPTH,        PixelDepth,       6,  8,  4) \
+    X(prefix, type, AVTP_RVF_FIELD_PIXEL_FORMAT,       PixelFormat,      6, 12,  4) \
+    X(prefix, type, AVTP_RVF_FIELD_FRAME_RATE,         FrameRate,        6, 16,  8) \
+    X(prefix, type, AVTP_RVF_FIELD_COLORSPACE,         Colorspace,       6, 24,  4) \
+    X(prefix, type, AVTP_RVF_FIELD_NUM_LINES,          NumLines,         6, 28,  4) \
+    X(prefix, type, AVTP_RVF_FIELD_RESERVED_6,         Reserved6,        7,  0,  8) \
+    X(prefix, type, AVTP_RVF_FIELD_I_SEQ_NUM,          ISeqNum,          7,  8,  8) \
+    X(prefix, type, AVTP_RVF_FIELD_LINE_NUMBER,        LineNumber,       7, 16, 16)
+
+/**
+ * Specialized accessors for each RVF header field, e.g.
+ * Avtp_Rvf_GetLineNumber() and Avtp_Rvf_SetLineNumber().
+ */
+AVTP_RVF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Rvf, Avtp_Rvf_t)
+
+/**
+ * Host byte-order representation of all RVF header fields. Reserved bits are
+ * not represented and are cleared by Avtp_Rvf_Pack().
+ */
+typedef struct {
+    uint8_t  subtype;
+    uint8_t  sv;
+    uint8_t  version;
+    uint8_t  mr;
+    uint8_t  tv;
+    uint8_t  sequence_num;
+    uint8_t  tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    uint16_t active_pixels;
+    uint16_t total_lines;
+    uint16_t stream_data_length;
+    uint8_t  ap;
+    uint8_t  f;
+    uint8_t  ef;
+    uint8_t  evt;
+    uint8_t  pd;
+    uint8_t  i;
+    uint8_t  pixel_depth;
+    uint8_t  pixel_format;
+    uint8_t  frame_rate;
+    uint8_t  colorspace;
+    uint8_t  num_lines;
+    uint8_t  i_seq_num;
+    uint16_t line_number;
+} Avtp_RvfHeader_t;
+
 typedef enum Avtp_RvfPixelDepth {
     AVTP_RVF_PIXEL_DEPTH_8              = 0x01,
     AVTP_RVF_PIXEL_DEPTH_10             = 0x02,
@@ -146,6 +223,62 @@ int Avtp_Rvf_GetField(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t* value);
 
 int Avtp_Rvf_SetField(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t value);
 
+/**
+ * Same as Avtp_Rvf_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Rvf_GetField_Unchecked(const Avtp_Rvf_t* pdu, Avtp_RvfField_t field);
+
+/**
+ * Same as Avtp_Rvf_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Rvf_SetField_Unchecked(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t value);
+
+/**
+ * Decodes all header fields of a RVF PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of a 1722 RVF PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_Rvf_Unpack(const Avtp_Rvf_t* pdu, Avtp_RvfHeader_t* header);
+
+/**
+ * Encodes all header fields of a RVF PDU in a single pass. This is the
+ * counterpart of Avtp_Rvf_Unpack().
+ *
+ * @param pdu Pointer to the first bit of a 1722 RVF PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_Rvf_Pack(Avtp_Rvf_t* pdu, const Avtp_RvfHeader_t* header);
+
+/**
+ * Creates a view of a received RVF PDU. Checks that the buffer holds the
+ * complete RVF header, that the subtype matches and that the payload announced
+ * by stream_data_length fits into the buffer. The RVF header following the
+ * stream header is part of the stream data, so stream_data_length must at least
+ * cover it. On success the view covers the header and the payload, which can
+ * then be accessed without further checks.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the received RVF PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete RVF PDU.
+ */
+int Avtp_Rvf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Per-stream header templates. The complete, network byte-order header of a
+ * stream is built once and each outgoing PDU is then emitted by copying the
+ * template and storing only the fields that change from packet to packet
+ * (sequence number, AVTP timestamp and data length) at precomputed offsets.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "avtp/Defines.h"
+#include "avtp/Byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Largest header a stream template can hold. This covers the biggest stream
+ * header (RVF) as well as stream headers followed by a format specific header
+ * such as CVF H.264.
+ */
+#define AVTP_STREAM_TEMPLATE_MAX_LEN        (8 * AVTP_QUADLET_SIZE)
+
+/**
+ * Prebuilt header of a single stream. The fields of this struct are set up by
+ * Avtp_StreamTemplate_Init() and must not be modified directly.
+ */
+typedef struct {
+    uint8_t header[AVTP_STREAM_TEMPLATE_MAX_LEN];
+    uint8_t headerLen;
+    uint8_t seqNumOffset;
+    int8_t timestampOffset;
+    uint8_t lengthOffset;
+    uint16_t lengthMask;
+    uint16_t lengthBase;
+} Avtp_StreamTemplate_t;
+
+/**
+ * Initializes a stream template from a fully configured header. The header is
+ * typically prepared once with the Init() and SetField() or Pack() functions
+ * of the respective format. The offsets of the per-packet fields are derived
+ * from the subtype in the header. Supported subtypes are AAF, CVF, CRF, TSCF,
+ * RVF and NTSCF.
+ *
+ * @param tmpl Pointer to the template to initialize.
+ * @param header Pointer to the first bit of the prebuilt 1722 header.
+ * @param headerLen Number of header bytes to copy into each PDU. Must cover
+ * the stream header of the format and not exceed AVTP_STREAM_TEMPLATE_MAX_LEN.
+ * @returns This function returns 0 if the template was successfully
+ * initialized and -EINVAL otherwise.
+ */
+int Avtp_StreamTemplate_Init(Avtp_StreamTemplate_t* tmpl, const uint8_t* header,
+                            uint16_t headerLen);
+
+/**
+ * Writes the header of the next PDU of a stream. The template is copied to the
+ * PDU and the sequence number, AVTP timestamp and data length are stored
+ * directly at their precomputed offsets. The timestamp is ignored for formats
+ * whose stream header has no avtp_timestamp field (CRF and NTSCF).
+ *
+ * @param tmpl Pointer to an initialized template.
+ * @param pdu Pointer to the first bit of the PDU to write. Must provide room
+ * for at least tmpl->headerLen bytes.
+ * @param seqNum Sequence number of the PDU.
+ * @param timestamp AVTP timestamp of the PDU.
+ * @param length Value of the data length field of the PDU.
+ */
+static inline void Avtp_StreamTemplate_Emit(const Avtp_StreamTemplate_t* tmpl,
+                            uint8_t* pdu, uint8_t seqNum, uint32_t timestamp,
+                            uint16_t length)
+{
+    memcpy(pdu, tmpl->header, tmpl->headerLen);
+
+    pdu[tmpl->seqNumOffset] = seqNum;
+
+    if (tmpl->timestampOffset >= 0) {
+        Avtp_StoreBe32(pdu + tmpl->timestampOffset, timestamp);
+    }
+
+    Avtp_StoreBe16(pdu + tmpl->lengthOffset, tmpl->lengthBase | (length & tmpl->lengthMask));
+}
+
+#ifdef __cplusplus
+}
+#endif
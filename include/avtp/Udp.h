@@ -38,6 +38,7 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/Utils.h"
 
 #define AVTP_UDP_HEADER_LEN               (1 * AVTP_QUADLET_SIZE)
 
@@ -55,6 +56,19 @@ typedef enum {
     AVTP_UDP_FIELD_MAX
 } Avtp_UDPFields_t;
 
+/**
+ * Position of all AVTP UDP header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_UDP_FIELD_LIST(X, prefix, type)                                            \
+    X(prefix, type, AVTP_UDP_FIELD_ENCAPSULATION_SEQ_NO, EncapsulationSeqNo, 0,  0, 32)
+
+/**
+ * Specialized accessors for each AVTP UDP header field, e.g.
+ * Avtp_UDP_GetEncapsulationSeqNo() and Avtp_UDP_SetEncapsulationSeqNo().
+ */
+AVTP_UDP_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_UDP, Avtp_UDP_t)
+
 /**
  * Initializes a UDP PDU as specified in the IEEE 1722-2016 Specification.
  *
@@ -84,3 +98,24 @@ int Avtp_UDP_GetField(Avtp_UDP_t* pdu, Avtp_UDPFields_t field, uint64_t* value);
  */
 int Avtp_UDP_SetField(Avtp_UDP_t* pdu, Avtp_UDPFields_t field, uint64_t value);
 
+/**
+ * Same as Avtp_UDP_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_UDP_GetField_Unchecked(const Avtp_UDP_t* pdu, Avtp_UDPFields_t field);
+
+/**
+ * Same as Avtp_UDP_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_UDP_SetField_Unchecked(Avtp_UDP_t* pdu, Avtp_UDPFields_t field, uint64_t value);
+
@@ -67,6 +67,251 @@ int Avtp_GetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFie
  * @returns This function returns 0 if the data field was successfully read from
  *      the 1722 PDU.
  */
-int Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields, uint8_t* pdu, 
+int Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields, uint8_t* pdu,
                             uint8_t field, uint64_t value);
 
+/**
+ * Extracts a data field from a 1722 frame like Avtp_GetField() but without any
+ * argument checks. The arguments are only asserted in debug builds (NDEBUG
+ * not defined), so callers must make sure that pdu is valid and field is
+ * within the descriptor table, e.g. by validating the stream once at setup.
+ *
+ * @param pdu Pointer to the first bit of an 1722 PDU.
+ * @param field Specifies the position of the data field to be read
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_GetField_Unchecked(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            const uint8_t* pdu, uint8_t field);
+
+/**
+ * Sets a data field in a 1722 frame like Avtp_SetField() but without any
+ * argument checks. The arguments are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param field Specifies the position of the data field to be written
+ * @param value The value to set.
+ */
+void Avtp_SetField_Unchecked(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            uint8_t* pdu, uint8_t field, uint64_t value);
+
+/**
+ * Extracts several data fields from a 1722 frame. Each quadlet touched by the
+ * requested fields is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 PDU.
+ * @param fieldValues List of data fields to read. The value member of each
+ * entry is set to the value read from the PDU.
+ * @param numValues Number of entries in fieldValues.
+ * @returns This function returns 0 if all data fields were successfully read
+ * from the 1722 PDU.
+ */
+int Avtp_GetFields(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields, uint8_t* pdu,
+                            Avtp_FieldValue_t* fieldValues, uint8_t numValues);
+
+/**
+ * Sets several data fields in a 1722 frame. The updates are grouped by quadlet
+ * so that every affected quadlet is read, modified and written back only once.
+ * All fields are validated before the PDU is modified, so either all or none
+ * of the fields are written.
+ *
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param fieldValues List of data fields and the values to set.
+ * @param numValues Number of entries in fieldValues.
+ * @returns This function returns 0 if all data fields were successfully set in
+ *      the 1722 PDU.
+ */
+int Avtp_SetFields(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields, uint8_t* pdu,
+                            const Avtp_FieldValue_t* fieldValues, uint8_t numValues);
+
+/**
+ * Extracts a data field at a fixed position from a 1722 PDU. This function is
+ * meant to be called with constant position parameters so that the compiler
+ * can reduce the access to a single load, byte-swap and shift. No argument or
+ * bounds checks are performed.
+ *
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param quadlet Quadlet that contains the first bit of the data field.
+ * @param offset Bit position of the data field within the first quadlet.
+ * @param bits Size of the data field in bits (1 to 64).
+ * @returns The value of the data field in host byte-order.
+ */
+static inline uint64_t Avtp_GetFieldInline(const uint8_t* pdu, uint8_t quadlet,
+                            uint8_t offset, uint8_t bits)
+{
+    const uint8_t* quadletPtr = pdu + quadlet * AVTP_QUADLET_SIZE;
+
+    if (offset + bits <= 32) {
+        uint32_t quadletHostOrder = Avtp_LoadBe32(quadletPtr);
+        return (uint32_t)(quadletHostOrder << offset) >> (32 - bits);
+    } else {
+        uint64_t value = Avtp_LoadBe64(quadletPtr);
+        value <<= offset;
+        if (offset + bits > 64) {
+            value |= Avtp_LoadBe32(quadletPtr + 2 * AVTP_QUADLET_SIZE) >> (32 - offset);
+        }
+        return value >> (64 - bits);
+    }
+}
+
+/**
+ * Writes a data field at a fixed position into a 1722 PDU. This is the
+ * counterpart of Avtp_GetFieldInline() and has the same requirements. Bits of
+ * the value that do not fit into the data field are discarded.
+ *
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param quadlet Quadlet that contains the first bit of the data field.
+ * @param offset Bit position of the data field within the first quadlet.
+ * @param bits Size of the data field in bits (1 to 64).
+ * @param value The value to set in host byte-order.
+ */
+static inline void Avtp_SetFieldInline(uint8_t* pdu, uint8_t quadlet,
+                            uint8_t offset, uint8_t bits, uint64_t value)
+{
+    uint8_t* quadletPtr = pdu + quadlet * AVTP_QUADLET_SIZE;
+
+    if (offset + bits <= 32) {
+        uint8_t shift = 32 - offset - bits;
+        uint32_t mask = (0xFFFFFFFFu >> (32 - bits)) << shift;
+        uint32_t quadletHostOrder = Avtp_LoadBe32(quadletPtr);
+        quadletHostOrder = (quadletHostOrder & ~mask) | (((uint32_t)value << shift) & mask);
+        Avtp_StoreBe32(quadletPtr, quadletHostOrder);
+    } else if (offset + bits <= 64) {
+        uint8_t shift = 64 - offset - bits;
+        uint64_t mask = (0xFFFFFFFFFFFFFFFFull >> (64 - bits)) << shift;
+        uint64_t hostOrder = Avtp_LoadBe64(quadletPtr);
+        hostOrder = (hostOrder & ~mask) | ((value << shift) & mask);
+        Avtp_StoreBe64(quadletPtr, hostOrder);
+    } else {
+        uint8_t remainingBits = offset + bits - 64;
+        Avtp_SetFieldInline(pdu, quadlet, offset, 64 - offset, value >> remainingBits);
+        Avtp_SetFieldInline(pdu, quadlet + 2, 0, remainingBits, value);
+    }
+}
+
+/**
+ * Loads the header quadlets of a 1722 PDU and converts them to host
+ * byte-order. Used together with Avtp_ExtractField() to decode a whole header
+ * with a single load per quadlet.
+ *
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param quadlets Array to store the host byte-order quadlets in.
+ * @param numQuadlets Number of quadlets to load.
+ */
+static inline void Avtp_LoadQuadlets(const uint8_t* pdu, uint32_t* quadlets,
+                            uint8_t numQuadlets)
+{
+    for (uint8_t i = 0; i < numQuadlets; i++) {
+        quadlets[i] = Avtp_LoadBe32(pdu + i * AVTP_QUADLET_SIZE);
+    }
+}
+
+/**
+ * Converts host byte-order quadlets to network byte-order and stores them in a
+ * 1722 PDU. This is the counterpart of Avtp_LoadQuadlets().
+ *
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param quadlets Array of host byte-order quadlets.
+ * @param numQuadlets Number of quadlets to store.
+ */
+static inline void Avtp_StoreQuadlets(uint8_t* pdu, const uint32_t* quadlets,
+                            uint8_t numQuadlets)
+{
+    for (uint8_t i = 0; i < numQuadlets; i++) {
+        Avtp_StoreBe32(pdu + i * AVTP_QUADLET_SIZE, quadlets[i]);
+    }
+}
+
+/**
+ * Extracts a data field from header quadlets that were already converted to
+ * host byte-order by Avtp_LoadQuadlets(). No bounds checks are performed.
+ *
+ * @param quadlets Host byte-order quadlets of the header.
+ * @param fieldDescriptor Position of the data field.
+ * @returns The value of the data field.
+ */
+static inline uint64_t Avtp_ExtractField(const uint32_t* quadlets,
+                            const Avtp_FieldDescriptor_t* fieldDescriptor)
+{
+    uint8_t quadlet = fieldDescriptor->quadlet;
+    uint8_t offset = fieldDescriptor->offset;
+    uint8_t bits = fieldDescriptor->bits;
+
+    if (offset + bits <= 32) {
+        return (uint32_t)(quadlets[quadlet] << offset) >> (32 - bits);
+    } else {
+        uint64_t value = ((uint64_t)quadlets[quadlet] << 32) | quadlets[quadlet + 1];
+        value <<= offset;
+        if (offset + bits > 64) {
+            value |= quadlets[quadlet + 2] >> (32 - offset);
+        }
+        return value >> (64 - bits);
+    }
+}
+
+/**
+ * Inserts a data field into host byte-order header quadlets which are later
+ * written to a PDU with Avtp_StoreQuadlets(). No bounds checks are performed
+ * and bits of the value that do not fit into the data field are discarded.
+ *
+ * @param quadlets Host byte-order quadlets of the header.
+ * @param fieldDescriptor Position of the data field.
+ * @param value The value to set.
+ */
+static inline void Avtp_InsertField(uint32_t* quadlets,
+                            const Avtp_FieldDescriptor_t* fieldDescriptor, uint64_t value)
+{
+    uint8_t quadlet = fieldDescriptor->quadlet;
+    uint8_t offset = fieldDescriptor->offset;
+    uint8_t bits = fieldDescriptor->bits;
+
+    if (offset + bits <= 32) {
+        uint8_t shift = 32 - offset - bits;
+        uint32_t mask = (0xFFFFFFFFu >> (32 - bits)) << shift;
+        quadlets[quadlet] = (quadlets[quadlet] & ~mask) | (((uint32_t)value << shift) & mask);
+    } else if (offset + bits <= 64) {
+        uint8_t shift = 64 - offset - bits;
+        uint64_t mask = (0xFFFFFFFFFFFFFFFFull >> (64 - bits)) << shift;
+        uint64_t hostOrder = ((uint64_t)quadlets[quadlet] << 32) | quadlets[quadlet + 1];
+        hostOrder = (hostOrder & ~mask) | ((value << shift) & mask);
+        quadlets[quadlet] = (uint32_t)(hostOrder >> 32);
+        quadlets[quadlet + 1] = (uint32_t)hostOrder;
+    } else {
+        uint8_t remainingBits = offset + bits - 64;
+        Avtp_FieldDescriptor_t head = { .quadlet = quadlet, .offset = offset, .bits = 64 - offset };
+        Avtp_FieldDescriptor_t tail = { .quadlet = quadlet + 2, .offset = 0, .bits = remainingBits };
+        Avtp_InsertField(quadlets, &head, value >> remainingBits);
+        Avtp_InsertField(quadlets, &tail, value);
+    }
+}
+
+/**
+ * The header of each PDU format provides a field list macro (e.g.
+ * AVTP_CAN_FIELD_LIST) that holds the position of every data field exactly
+ * once. The list invokes X(prefix, type, field, name, quadlet, offset, bits)
+ * for each field. The macros below are used as X to generate the field
+ * descriptor table of a format and its specialized field accessors.
+ */
+
+/**
+ * Expands a field list entry into an initializer of an Avtp_FieldDescriptor_t
+ * table.
+ */
+#define AVTP_FIELD_DESCRIPTOR(prefix, type, field, name, q, o, b) \
+    [field] = { .quadlet = (q), .offset = (o), .bits = (b) },
+
+/**
+ * Expands a field list entry into the static inline accessors
+ * <prefix>_Get<name>(const type* pdu) and <prefix>_Set<name>(type* pdu, value).
+ * As the position of the data field is a compile-time constant, every access
+ * compiles down to a load, byte-swap and mask without any argument checks.
+ */
+#define AVTP_FIELD_ACCESSORS(prefix, type, field, name, q, o, b)            \
+    static inline uint64_t prefix##_Get##name(const type* pdu)              \
+    {                                                                       \
+        return Avtp_GetFieldInline((const uint8_t*)pdu, (q), (o), (b));     \
+    }                                                                       \
+    static inline void prefix##_Set##name(type* pdu, uint64_t value)        \
+    {                                                                       \
+        Avtp_SetFieldInline((uint8_t*)pdu, (q), (o), (b), value);           \
+    }
+
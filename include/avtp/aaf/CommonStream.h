@@ -38,6 +38,7 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/Utils.h"
 
 #define AVTP_AAF_COMMON_STREAM_HEADER_LEN              (6 * AVTP_QUADLET_SIZE)
 
@@ -66,6 +67,34 @@ typedef enum {
     AVTP_AAF_COMMON_STREAM_FIELD_MAX
 } Avtp_AafCommonStreamFields_t;
 
+/**
+ * Position of all AAF common stream header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_AAF_COMMON_STREAM_FIELD_LIST(X, prefix, type)                                                      \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_SUBTYPE,                    Subtype,                0,  0,  8) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_SV,                         Sv,                     0,  8,  1) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_VERSION,                    Version,                0,  9,  3) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_MR,                         Mr,                     0, 12,  1) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_TV,                         Tv,                     0, 15,  1) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_SEQUENCE_NUM,               SequenceNum,            0, 16,  8) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_TU,                         Tu,                     0, 31,  1) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_STREAM_ID,                  StreamId,               1,  0, 64) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_AVTP_TIMESTAMP,             AvtpTimestamp,          3,  0, 32) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_FORMAT,                     Format,                 4,  0,  8) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_AAF_FORMAT_SPECIFIC_DATA_1, AafFormatSpecificData1, 4,  8, 24) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_STREAM_DATA_LENGTH,         StreamDataLength,       5,  0, 16) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_AFSD,                       Afsd,                   5, 16,  3) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_SP,                         Sp,                     5, 19,  1) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_EVT,                        Evt,                    5, 20,  4) \
+    X(prefix, type, AVTP_AAF_COMMON_STREAM_FIELD_AAF_FORMAT_SPECIFIC_DATA_2, AafFormatSpecificData2, 5, 24,  8)
+
+/**
+ * Specialized accessors for each AAF common stream header field, e.g.
+ * Avtp_AafCommonStream_GetStreamDataLength() and Avtp_AafCommonStream_SetStreamDataLength().
+ */
+AVTP_AAF_COMMON_STREAM_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_AafCommonStream, Avtp_AafCommonStream_t)
+
 /**
  * Returns the value of an an AVTP AAF common stream field as specified in the IEEE 1722 Specification.
  *
@@ -86,4 +115,25 @@ int Avtp_AafCommonStream_GetField(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStr
  * @returns This function returns 0 if the data field was successfully set in
  * the 1722 AVTP PDU.
  */
-int Avtp_AafCommonStream_SetField(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field, uint64_t value);
\ No newline at end of file
+int Avtp_AafCommonStream_SetField(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field, uint64_t value);
+
+/**
+ * Same as Avtp_AafCommonStream_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_AafCommonStream_GetField_Unchecked(const Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field);
+
+/**
+ * Same as Avtp_AafCommonStream_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_AafCommonStream_SetField_Unchecked(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field, uint64_t value);
\ No newline at end of file
@@ -33,6 +33,8 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/PduView.h"
+#include "avtp/Utils.h"
 
 #define AVTP_AAF_PCM_STREAM_HEADER_LEN              (6 * AVTP_QUADLET_SIZE)
 
@@ -61,6 +63,57 @@ typedef enum {
     AVTP_AAF_PCM_STREAM_FIELD_MAX
 } Avtp_AafPcmStreamFields_t;
 
+/**
+ * Position of all AAF PCM stream header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_AAF_PCM_STREAM_FIELD_LIST(X, prefix, type)                                        \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_SUBTYPE,            Subtype,          0,  0,  8) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_SV,                 Sv,               0,  8,  1) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_VERSION,            Version,          0,  9,  3) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_MR,                 Mr,               0, 12,  1) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_TV,                 Tv,               0, 15,  1) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_SEQUENCE_NUM,       SequenceNum,      0, 16,  8) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_TU,                 Tu,               0, 31,  1) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_STREAM_ID,          StreamId,         1,  0, 64) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_AVTP_TIMESTAMP,     AvtpTimestamp,    3,  0, 32) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_FORMAT,             Format,           4,  0,  8) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_NSR,                Nsr,              4,  8,  4) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_CHANNELS_PER_FRAME, ChannelsPerFrame, 4, 14, 10) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_BIT_DEPTH,          BitDepth,         4, 24,  8) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_STREAM_DATA_LENGTH, StreamDataLength, 5,  0, 16) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_SP,                 Sp,               5, 19,  1) \
+    X(prefix, type, AVTP_AAF_PCM_STREAM_FIELD_EVT,                Evt,              5, 20,  4)
+
+/**
+ * Specialized accessors for each AAF PCM stream header field, e.g.
+ * Avtp_AafPcmStream_GetChannelsPerFrame() and Avtp_AafPcmStream_SetChannelsPerFrame().
+ */
+AVTP_AAF_PCM_STREAM_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_AafPcmStream, Avtp_AafPcmStream_t)
+
+/**
+ * Host byte-order representation of all AAF PCM stream header fields. Reserved bits are
+ * not represented and are cleared by Avtp_AafPcmStream_Pack().
+ */
+typedef struct {
+    uint8_t  subtype;
+    uint8_t  sv;
+    uint8_t  version;
+    uint8_t  mr;
+    uint8_t  tv;
+    uint8_t  sequence_num;
+    uint8_t  tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    uint8_t  format;
+    uint8_t  nsr;
+    uint16_t channels_per_frame;
+    uint8_t  bit_depth;
+    uint16_t stream_data_length;
+    uint8_t  sp;
+    uint8_t  evt;
+} Avtp_AafPcmStreamHeader_t;
+
 // AAF 'format' field values
 typedef enum {
     AVTP_AAF_FORMAT_USER = 0,
@@ -120,6 +173,61 @@ int Avtp_AafPcmStream_GetField(Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields
  */
 int Avtp_AafPcmStream_SetField(Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields_t field, uint64_t value);
 
+/**
+ * Same as Avtp_AafPcmStream_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_AafPcmStream_GetField_Unchecked(const Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields_t field);
+
+/**
+ * Same as Avtp_AafPcmStream_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_AafPcmStream_SetField_Unchecked(Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields_t field, uint64_t value);
+
+/**
+ * Decodes all header fields of a AAF PCM stream PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of a 1722 AAF PCM stream PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_AafPcmStream_Unpack(const Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamHeader_t* header);
+
+/**
+ * Encodes all header fields of a AAF PCM stream PDU in a single pass. This is the
+ * counterpart of Avtp_AafPcmStream_Unpack().
+ *
+ * @param pdu Pointer to the first bit of a 1722 AAF PCM stream PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_AafPcmStream_Pack(Avtp_AafPcmStream_t* pdu, const Avtp_AafPcmStreamHeader_t* header);
+
+/**
+ * Creates a view of a received AAF PCM PDU. Checks that the buffer holds the
+ * complete AAF PCM header, that the subtype matches and that the payload
+ * announced by stream_data_length fits into the buffer. On success the view
+ * covers the header and the payload, which can then be accessed without further
+ * checks.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the received AAF PCM PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete AAF PCM PDU.
+ */
+int Avtp_AafPcmStream_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
@@ -38,6 +38,8 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/PduView.h"
+#include "avtp/Utils.h"
 #include "avtp/acf/Common.h"
 
 #define AVTP_CAN_HEADER_LEN         (4 * AVTP_QUADLET_SIZE)
@@ -74,6 +76,51 @@ typedef enum  {
     AVTP_CAN_FIELD_MAX
 } Avtp_CanFields_t;
 
+/**
+ * Position of all ACF CAN header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_CAN_FIELD_LIST(X, prefix, type)                                       \
+    /* ACF common header fields */                                                 \
+    X(prefix, type, AVTP_CAN_FIELD_ACF_MSG_TYPE,      AcfMsgType,       0,  0,  7) \
+    X(prefix, type, AVTP_CAN_FIELD_ACF_MSG_LENGTH,    AcfMsgLength,     0,  7,  9) \
+    /* ACF CAN header fields */                                                    \
+    X(prefix, type, AVTP_CAN_FIELD_PAD,               Pad,              0, 16,  2) \
+    X(prefix, type, AVTP_CAN_FIELD_MTV,               Mtv,              0, 18,  1) \
+    X(prefix, type, AVTP_CAN_FIELD_RTR,               Rtr,              0, 19,  1) \
+    X(prefix, type, AVTP_CAN_FIELD_EFF,               Eff,              0, 20,  1) \
+    X(prefix, type, AVTP_CAN_FIELD_BRS,               Brs,              0, 21,  1) \
+    X(prefix, type, AVTP_CAN_FIELD_FDF,               Fdf,              0, 22,  1) \
+    X(prefix, type, AVTP_CAN_FIELD_ESI,               Esi,              0, 23,  1) \
+    X(prefix, type, AVTP_CAN_FIELD_CAN_BUS_ID,        CanBusId,         0, 27,  5) \
+    X(prefix, type, AVTP_CAN_FIELD_MESSAGE_TIMESTAMP, MessageTimestamp, 1,  0, 64) \
+    X(prefix, type, AVTP_CAN_FIELD_CAN_IDENTIFIER,    CanIdentifier,    3,  3, 29)
+
+/**
+ * Specialized accessors for each ACF CAN header field, e.g.
+ * Avtp_Can_GetCanIdentifier() and Avtp_Can_SetCanIdentifier().
+ */
+AVTP_CAN_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Can, Avtp_Can_t)
+
+/**
+ * Host byte-order representation of all ACF CAN header fields. Reserved bits are
+ * not represented and are cleared by Avtp_Can_Pack().
+ */
+typedef struct {
+    uint8_t  acf_msg_type;
+    uint16_t acf_msg_length;
+    uint8_t  pad;
+    uint8_t  mtv;
+    uint8_t  rtr;
+    uint8_t  eff;
+    uint8_t  brs;
+    uint8_t  fdf;
+    uint8_t  esi;
+    uint8_t  can_bus_id;
+    uint64_t message_timestamp;
+    uint32_t can_identifier;
+} Avtp_CanHeader_t;
+
 /**
  * Initializes an ACF CAN PDU header as specified in the IEEE 1722 Specification.
  *
@@ -103,6 +150,77 @@ int Avtp_Can_GetField(Avtp_Can_t* can_pdu, Avtp_CanFields_t field, uint64_t* val
  */
 int Avtp_Can_SetField(Avtp_Can_t* can_pdu, Avtp_CanFields_t field, uint64_t value);
 
+/**
+ * Same as Avtp_Can_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param can_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Can_GetField_Unchecked(const Avtp_Can_t* can_pdu, Avtp_CanFields_t field);
+
+/**
+ * Same as Avtp_Can_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param can_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Can_SetField_Unchecked(Avtp_Can_t* can_pdu, Avtp_CanFields_t field, uint64_t value);
+
+/**
+ * Decodes all header fields of an ACF CAN PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param can_pdu Pointer to the first bit of a 1722 ACF CAN PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_Can_Unpack(const Avtp_Can_t* can_pdu, Avtp_CanHeader_t* header);
+
+/**
+ * Encodes all header fields of an ACF CAN PDU in a single pass. This is the
+ * counterpart of Avtp_Can_Unpack().
+ *
+ * @param can_pdu Pointer to the first bit of a 1722 ACF CAN PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_Can_Pack(Avtp_Can_t* can_pdu, const Avtp_CanHeader_t* header);
+
+/**
+ * Creates a view of a received ACF CAN message. Checks that the buffer holds
+ * the complete header, that the message type matches, that acf_msg_length fits
+ * into the buffer and that the padding fits into the message. On success the
+ * view covers exactly one message, so view->len is the offset of the next
+ * message within the enclosing control format PDU.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the ACF CAN message.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete ACF CAN message.
+ */
+int Avtp_Can_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
+/**
+ * Returns the payload of an ACF CAN message whose view was created by
+ * Avtp_Can_InitView(). As the message was already validated, no checks are
+ * performed and the payload is not copied.
+ *
+ * @param view Pointer to the view of the ACF CAN message.
+ * @param payload_length Pointer to store the payload length (without padding) in.
+ * @returns Pointer to the first byte of the payload.
+ */
+static inline const uint8_t* Avtp_Can_GetViewPayload(const Avtp_PduView_t* view,
+                            uint16_t* payload_length)
+{
+    *payload_length = view->len - AVTP_CAN_HEADER_LEN - Avtp_Can_GetPad((const Avtp_Can_t*)view->base);
+    return view->base + AVTP_CAN_HEADER_LEN;
+}
+
 /**
  * Copies the payload data into the ACF CAN frame. This function will also set the
  * length and pad fields while inserting the padded bytes. 
@@ -38,6 +38,8 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/PduView.h"
+#include "avtp/Utils.h"
 #include "avtp/acf/Common.h"
 #include "avtp/acf/Can.h"
 
@@ -69,6 +71,31 @@ typedef enum {
     AVTP_CAN_BRIEF_FIELD_MAX
 } Avtp_CanBriefFields_t;
 
+/**
+ * Position of all ACF Abbreviated CAN header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_CAN_BRIEF_FIELD_LIST(X, prefix, type)                                 \
+    /* ACF common header fields */                                                 \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_ACF_MSG_TYPE,   AcfMsgType,    0,  0,  7) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, AcfMsgLength,  0,  7,  9) \
+    /* ACF Abbreviated CAN header fields */                                        \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_PAD,            Pad,           0, 16,  2) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_MTV,            Mtv,           0, 18,  1) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_RTR,            Rtr,           0, 19,  1) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_EFF,            Eff,           0, 20,  1) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_BRS,            Brs,           0, 21,  1) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_FDF,            Fdf,           0, 22,  1) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_ESI,            Esi,           0, 23,  1) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_CAN_BUS_ID,     CanBusId,      0, 27,  5) \
+    X(prefix, type, AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER, CanIdentifier, 1,  3, 29)
+
+/**
+ * Specialized accessors for each ACF Abbreviated CAN header field, e.g.
+ * Avtp_CanBrief_GetCanIdentifier() and Avtp_CanBrief_SetCanIdentifier().
+ */
+AVTP_CAN_BRIEF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_CanBrief, Avtp_CanBrief_t)
+
 /**
  * Initializes an ACF Abbreviated CAN PDU header as specified in the IEEE 1722 Specification.
  *
@@ -98,6 +125,57 @@ int Avtp_CanBrief_GetField(Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field
  */
 int Avtp_CanBrief_SetField(Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field, uint64_t value);
 
+/**
+ * Same as Avtp_CanBrief_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param can_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_CanBrief_GetField_Unchecked(const Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field);
+
+/**
+ * Same as Avtp_CanBrief_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param can_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_CanBrief_SetField_Unchecked(Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field, uint64_t value);
+
+/**
+ * Creates a view of a received ACF CAN Brief message. Checks that the buffer
+ * holds the complete header, that the message type matches, that acf_msg_length
+ * fits into the buffer and that the padding fits into the message. On success
+ * the view covers exactly one message, so view->len is the offset of the next
+ * message within the enclosing control format PDU.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the ACF CAN Brief message.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete ACF CAN Brief message.
+ */
+int Avtp_CanBrief_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
+/**
+ * Returns the payload of an ACF CAN Brief message whose view was created by
+ * Avtp_CanBrief_InitView(). As the message was already validated, no checks are
+ * performed and the payload is not copied.
+ *
+ * @param view Pointer to the view of the ACF CAN Brief message.
+ * @param payload_length Pointer to store the payload length (without padding) in.
+ * @returns Pointer to the first byte of the payload.
+ */
+static inline const uint8_t* Avtp_CanBrief_GetViewPayload(const Avtp_PduView_t* view,
+                            uint16_t* payload_length)
+{
+    *payload_length = view->len - AVTP_CAN_BRIEF_HEADER_LEN - Avtp_CanBrief_GetPad((const Avtp_CanBrief_t*)view->base);
+    return view->base + AVTP_CAN_BRIEF_HEADER_LEN;
+}
+
 /**
  * Copies the payload data into the ACF CAN Brief frame. This function will also set the
  * length and pad fields while inserting the padded bytes. 
@@ -112,6 +190,17 @@ int Avtp_CanBrief_SetField(Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field
 int Avtp_CanBrief_SetPayload(Avtp_CanBrief_t* can_pdu, uint32_t frame_id , uint8_t* payload, 
                         uint16_t payload_length, Can_Variant_t can_variant);
 
+/**
+ * Returns pointer to payload of an ACF CAN Brief frame.
+ *
+ * @param can_pdu Pointer to the first bit of an 1722 ACF CAN Brief PDU.
+ * @param payload_length payload length set by the function (if not NULL)
+ * @param pdu_length total pdu length set by the function (if not NULL)
+ * @return Pointer to ACF CAN Brief frame payload
+ */
+uint8_t* Avtp_CanBrief_GetPayload(Avtp_CanBrief_t* can_pdu, uint16_t* payload_length,
+                                  uint16_t *pdu_length);
+
 /**
  * Finalizes the ACF CAN Brief frame. This function will set the
  * length and pad fields while inserting the padded bytes. 
@@ -36,6 +36,8 @@
 
 #include <stdint.h>
 #include "avtp/Defines.h"
+#include "avtp/PduView.h"
+#include "avtp/Utils.h"
 
 #define AVTP_ACF_COMMON_HEADER_LEN         (1 * AVTP_QUADLET_SIZE)
 
@@ -74,6 +76,21 @@ typedef enum {
     AVTP_ACF_COMMON_FIELD_MAX
 } Avtp_AcfCommonFields_t;
 
+/**
+ * Position of all ACF common header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_ACF_COMMON_FIELD_LIST(X, prefix, type)                         \
+    /* ACF common header */                                                 \
+    X(prefix, type, AVTP_ACF_FIELD_ACF_MSG_TYPE,   AcfMsgType,   0,  0,  7) \
+    X(prefix, type, AVTP_ACF_FIELD_ACF_MSG_LENGTH, AcfMsgLength, 0,  7,  9)
+
+/**
+ * Specialized accessors for each ACF common header field, e.g.
+ * Avtp_AcfCommon_GetAcfMsgLength() and Avtp_AcfCommon_SetAcfMsgLength().
+ */
+AVTP_ACF_COMMON_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_AcfCommon, Avtp_AcfCommon_t)
+
 /**
  * Returns the value of an an ACF common header field as specified in the IEEE 1722 Specification.
  *
@@ -94,4 +111,38 @@ int Avtp_AcfCommon_GetField(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t fi
  * @returns This function returns 0 if the data field was successfully set in
  * the 1722 ACF PDU.
  */
-int Avtp_AcfCommon_SetField(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field, uint64_t value);
\ No newline at end of file
+int Avtp_AcfCommon_SetField(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field, uint64_t value);
+
+/**
+ * Same as Avtp_AcfCommon_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param acf_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_AcfCommon_GetField_Unchecked(const Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field);
+
+/**
+ * Same as Avtp_AcfCommon_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param acf_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_AcfCommon_SetField_Unchecked(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field, uint64_t value);
+
+/**
+ * Creates a view of a received ACF message. Checks that the buffer holds the
+ * complete header and that acf_msg_length fits into the buffer. On success the
+ * view covers exactly one message, so view->len is the offset of the next
+ * message within the enclosing control format PDU.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the ACF message.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete ACF message.
+ */
+int Avtp_AcfCommon_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
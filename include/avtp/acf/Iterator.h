@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Iterator over the ACF messages carried by an NTSCF or TSCF PDU.
+ *
+ * The iterator yields every ACF message regardless of its type. Each message
+ * is bounds-checked against the control format data length before it is
+ * returned and only its first header quadlet is read, so consumers can
+ * dispatch on the message type and then decode the message in place.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp/Byteorder.h"
+#include "avtp/Defines.h"
+#include "avtp/acf/Common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * ACF message returned by Avtp_AcfIter_Next().
+ */
+typedef struct Avtp_AcfMsg {
+    /** ACF message type, see Avtp_AcfMsgType_t. */
+    uint8_t msg_type;
+    /** Pointer to the first byte of the ACF message header. */
+    const uint8_t* msg_ptr;
+    /** Length of the whole message (header, payload and padding) in bytes. */
+    uint16_t msg_len;
+} Avtp_AcfMsg_t;
+
+typedef struct Avtp_AcfIter {
+    const uint8_t* pos;
+    const uint8_t* end;
+} Avtp_AcfIter_t;
+
+/**
+ * Initializes an iterator over the ACF messages of an NTSCF or TSCF PDU. The
+ * control format header is validated with Avtp_Ntscf_InitView() or
+ * Avtp_Tscf_InitView() respectively.
+ *
+ * @param iter Pointer to the iterator.
+ * @param cf_pdu Pointer to the first byte of the NTSCF or TSCF PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the control format PDU is valid.
+ */
+int Avtp_AcfIter_Init(Avtp_AcfIter_t* iter, const uint8_t* cf_pdu, size_t len);
+
+/**
+ * Initializes an iterator over a sequence of ACF messages without a control
+ * format header, e.g. the payload of a control format PDU that was already
+ * validated.
+ *
+ * @param iter Pointer to the iterator.
+ * @param msgs Pointer to the first byte of the first ACF message.
+ * @param len Length of the message sequence in bytes.
+ * @returns This function returns 0 if the iterator was successfully
+ * initialized.
+ */
+int Avtp_AcfIter_InitMessages(Avtp_AcfIter_t* iter, const uint8_t* msgs, size_t len);
+
+/**
+ * Returns the next ACF message. The message is guaranteed to hold at least
+ * the ACF common header and to lie completely within the control format data.
+ * If a message is malformed, the iteration stops.
+ *
+ * @param iter Pointer to the iterator.
+ * @param msg Pointer to store the next message in.
+ * @returns 1 if a message was returned, 0 if all messages were processed or
+ * -EINVAL if the next message is malformed.
+ */
+static inline int Avtp_AcfIter_Next(Avtp_AcfIter_t* iter, Avtp_AcfMsg_t* msg)
+{
+    size_t remaining = iter->end - iter->pos;
+
+    if (remaining == 0) {
+        return 0;
+    }
+
+    if (remaining < AVTP_ACF_COMMON_HEADER_LEN) {
+        iter->pos = iter->end;
+        return -EINVAL;
+    }
+
+    // acf_msg_type (7 bits) and acf_msg_length (9 bits) share the first 16 bits
+    uint16_t header = Avtp_LoadBe16(iter->pos);
+    size_t msgLen = (size_t)(header & 0x1FF) * AVTP_QUADLET_SIZE;
+
+    if (msgLen < AVTP_ACF_COMMON_HEADER_LEN || msgLen > remaining) {
+        iter->pos = iter->end;
+        return -EINVAL;
+    }
+
+    msg->msg_type = header >> 9;
+    msg->msg_ptr = iter->pos;
+    msg->msg_len = msgLen;
+    iter->pos += msgLen;
+
+    return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
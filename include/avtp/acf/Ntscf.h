@@ -38,6 +38,8 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/PduView.h"
+#include "avtp/Utils.h"
 
 #define AVTP_NTSCF_HEADER_LEN              (3 * AVTP_QUADLET_SIZE)
 
@@ -58,6 +60,39 @@ typedef enum {
     AVTP_NTSCF_FIELD_MAX
 } Avtp_NtscfFields_t;
 
+/**
+ * Position of all NTSCF header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_NTSCF_FIELD_LIST(X, prefix, type)                                      \
+    /* Common AVTP header */                                                        \
+    X(prefix, type, AVTP_NTSCF_FIELD_SUBTYPE,           Subtype,         0,  0,  8) \
+    X(prefix, type, AVTP_NTSCF_FIELD_SV,                Sv,              0,  8,  1) \
+    X(prefix, type, AVTP_NTSCF_FIELD_VERSION,           Version,         0,  9,  3) \
+    /* NTSCF header */                                                              \
+    X(prefix, type, AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, NtscfDataLength, 0, 13, 11) \
+    X(prefix, type, AVTP_NTSCF_FIELD_SEQUENCE_NUM,      SequenceNum,     0, 24,  8) \
+    X(prefix, type, AVTP_NTSCF_FIELD_STREAM_ID,         StreamId,        1,  0, 64)
+
+/**
+ * Specialized accessors for each NTSCF header field, e.g.
+ * Avtp_Ntscf_GetNtscfDataLength() and Avtp_Ntscf_SetNtscfDataLength().
+ */
+AVTP_NTSCF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Ntscf, Avtp_Ntscf_t)
+
+/**
+ * Host byte-order representation of all NTSCF header fields. Reserved bits are
+ * not represented and are cleared by Avtp_Ntscf_Pack().
+ */
+typedef struct {
+    uint8_t  subtype;
+    uint8_t  sv;
+    uint8_t  version;
+    uint16_t ntscf_data_length;
+    uint8_t  sequence_num;
+    uint64_t stream_id;
+} Avtp_NtscfHeader_t;
+
 /**
  * Initializes a NTSCF PDU as specified in the IEEE 1722-2016 Specification.
  *
@@ -86,4 +121,59 @@ int Avtp_Ntscf_GetField(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t* v
  * @returns This function returns 0 if the data field was successfully set in
  * the 1722 AVTP PDU.
  */
-int Avtp_Ntscf_SetField(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t value);
\ No newline at end of file
+int Avtp_Ntscf_SetField(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t value);
+
+/**
+ * Same as Avtp_Ntscf_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Ntscf_GetField_Unchecked(const Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field);
+
+/**
+ * Same as Avtp_Ntscf_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Ntscf_SetField_Unchecked(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t value);
+
+/**
+ * Decodes all header fields of a NTSCF PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of a 1722 NTSCF PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_Ntscf_Unpack(const Avtp_Ntscf_t* pdu, Avtp_NtscfHeader_t* header);
+
+/**
+ * Encodes all header fields of a NTSCF PDU in a single pass. This is the
+ * counterpart of Avtp_Ntscf_Unpack().
+ *
+ * @param pdu Pointer to the first bit of a 1722 NTSCF PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_Ntscf_Pack(Avtp_Ntscf_t* pdu, const Avtp_NtscfHeader_t* header);
+
+/**
+ * Creates a view of a received NTSCF PDU. Checks that the buffer holds the
+ * complete NTSCF header, that the subtype matches and that the payload
+ * announced by ntscf_data_length fits into the buffer. On success the view
+ * covers the header and the payload, which can then be accessed without further
+ * checks.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the received NTSCF PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete NTSCF PDU.
+ */
+int Avtp_Ntscf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Packs ACF messages into NTSCF or TSCF PDUs.
+ *
+ * The packer appends ACF messages behind the header of a control format PDU
+ * and tells the caller when the PDU has to be sent. A PDU is flushed when
+ * the next message would exceed the configured maximum PDU length (e.g. the
+ * MTU), when a maximum number of messages is reached or when the oldest
+ * message in the PDU has waited for the configured latency. The packer never
+ * reads a clock, the current time is always passed in by the caller so that
+ * any time base can be used.
+ *
+ * A typical sending loop looks like this:
+ *
+ *     msg = Avtp_AcfPacker_Reserve(&packer, maxMsgLen);
+ *     if (msg == NULL) { send(Avtp_AcfPacker_Finalize(&packer)); reset; retry }
+ *     len = <write ACF message to msg>;
+ *     if (Avtp_AcfPacker_Commit(&packer, len, now)) { send; reset; }
+ *     ...
+ *     if (Avtp_AcfPacker_IsDue(&packer, now)) { send; reset; }
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Value returned by Avtp_AcfPacker_GetDeadline() if no flush is pending. */
+#define AVTP_ACF_PACKER_NO_DEADLINE        UINT64_MAX
+
+typedef struct Avtp_AcfPacker {
+    uint8_t* cf_pdu;
+    uint16_t headerLen;
+    uint16_t maxLen;
+    uint16_t len;
+    uint16_t numMsgs;
+    uint16_t maxMsgs;
+    uint64_t latency;
+    uint64_t deadline;
+} Avtp_AcfPacker_t;
+
+/**
+ * Initializes a packer for a control format PDU. The header of the PDU must
+ * already be initialized as NTSCF or TSCF (e.g. with Avtp_Ntscf_Init()); the
+ * packer only maintains the data length field of the header.
+ *
+ * @param packer Pointer to the packer.
+ * @param cf_pdu Pointer to the first byte of the NTSCF or TSCF PDU.
+ * @param maxLen Maximum length of the PDU (header and messages) in bytes. It
+ * is limited to what the data length field of the format can express.
+ * @param maxMsgs Maximum number of messages per PDU, 0 for no limit.
+ * @param latency Maximum time the first message of a PDU may wait before the
+ * PDU is flushed, in the unit of the timestamps passed to the packer. 0
+ * disables the deadline.
+ * @returns This function returns 0 if the packer was successfully initialized.
+ */
+int Avtp_AcfPacker_Init(Avtp_AcfPacker_t* packer, uint8_t* cf_pdu, uint16_t maxLen,
+                            uint16_t maxMsgs, uint64_t latency);
+
+/**
+ * Reserves room for the next ACF message.
+ *
+ * @param packer Pointer to the packer.
+ * @param maxMsgLen Maximum length of the message to be written in bytes.
+ * @returns Pointer to write the message at, or NULL if the message does not
+ * fit into the current PDU. In that case the PDU has to be flushed first.
+ */
+uint8_t* Avtp_AcfPacker_Reserve(Avtp_AcfPacker_t* packer, uint16_t maxMsgLen);
+
+/**
+ * Appends the message written to the pointer returned by
+ * Avtp_AcfPacker_Reserve() to the PDU. The deadline of the PDU is started
+ * with the first message.
+ *
+ * @param packer Pointer to the packer.
+ * @param msgLen Length of the message in bytes as returned by e.g.
+ * Avtp_Can_SetPayload().
+ * @param now Current time.
+ * @returns 1 if the PDU is full (maximum number of messages reached or no
+ * room for a further message header) and must be flushed, 0 if more messages
+ * can be appended, or a negative value if msgLen is invalid.
+ */
+int Avtp_AcfPacker_Commit(Avtp_AcfPacker_t* packer, uint16_t msgLen, uint64_t now);
+
+/**
+ * Checks whether the latency deadline of a non-empty PDU has expired.
+ *
+ * @param packer Pointer to the packer.
+ * @param now Current time.
+ * @returns 1 if the PDU must be flushed, 0 otherwise.
+ */
+int Avtp_AcfPacker_IsDue(const Avtp_AcfPacker_t* packer, uint64_t now);
+
+/**
+ * Returns the time at which the current PDU must be flushed, e.g. to compute
+ * a poll() timeout.
+ *
+ * @param packer Pointer to the packer.
+ * @returns The deadline, or AVTP_ACF_PACKER_NO_DEADLINE if the PDU is empty
+ * or no latency is configured.
+ */
+uint64_t Avtp_AcfPacker_GetDeadline(const Avtp_AcfPacker_t* packer);
+
+/**
+ * Returns the number of messages in the current PDU.
+ *
+ * @param packer Pointer to the packer.
+ * @returns The number of messages.
+ */
+uint16_t Avtp_AcfPacker_GetNumMsgs(const Avtp_AcfPacker_t* packer);
+
+/**
+ * Writes the data length of the current PDU into its header.
+ *
+ * @param packer Pointer to the packer.
+ * @returns The length of the PDU (header and messages) in bytes, or 0 if the
+ * PDU holds no messages.
+ */
+uint16_t Avtp_AcfPacker_Finalize(Avtp_AcfPacker_t* packer);
+
+/**
+ * Starts a new, empty PDU after the current one was sent. The header is kept,
+ * so the caller only has to update fields like the sequence number.
+ *
+ * @param packer Pointer to the packer.
+ */
+void Avtp_AcfPacker_Reset(Avtp_AcfPacker_t* packer);
+
+#ifdef __cplusplus
+}
+#endif
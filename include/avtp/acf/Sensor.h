@@ -35,9 +35,11 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/Utils.h"
 #include "avtp/acf/Common.h"
 
 #define AVTP_SENSOR_HEADER_LEN         (3 * AVTP_QUADLET_SIZE)
@@ -64,6 +66,54 @@ typedef enum {
     AVTP_SENSOR_FIELD_MAX
 } Avtp_SensorFields_t;
 
+/**
+ * Size of each sensor data item as encoded in the sz field.
+ */
+typedef enum {
+    AVTP_SENSOR_SZ_64BIT = 0,
+    AVTP_SENSOR_SZ_32BIT = 1,
+    AVTP_SENSOR_SZ_16BIT = 2,
+    AVTP_SENSOR_SZ_8BIT  = 3,
+} Avtp_SensorSz_t;
+
+/**
+ * Maximum number of sensor data items in one message, limited by the 7 bit
+ * num_sensor field.
+ */
+#define AVTP_SENSOR_MAX_SAMPLES        127
+
+/**
+ * Returns the size in bytes of each sensor data item for a sz field value.
+ *
+ * @param sz Value of the sz field.
+ * @returns Size of one sensor data item in bytes (1, 2, 4 or 8).
+ */
+static inline size_t Avtp_Sensor_GetSampleSize(Avtp_SensorSz_t sz)
+{
+    return (size_t)8 >> (sz & 0x3);
+}
+
+/**
+ * Position of all ACF Sensor header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_SENSOR_FIELD_LIST(X, prefix, type)                                       \
+    /* ACF common header fields */                                                    \
+    X(prefix, type, AVTP_SENSOR_FIELD_ACF_MSG_TYPE,      AcfMsgType,       0,  0,  7) \
+    X(prefix, type, AVTP_SENSOR_FIELD_ACF_MSG_LENGTH,    AcfMsgLength,     0,  7,  9) \
+    /* ACF Sensor header fields */                                                    \
+    X(prefix, type, AVTP_SENSOR_FIELD_MTV,               Mtv,              0, 16,  1) \
+    X(prefix, type, AVTP_SENSOR_FIELD_NUM_SENSOR,        NumSensor,        0, 17,  7) \
+    X(prefix, type, AVTP_SENSOR_FIELD_SZ,                Sz,               0, 24,  2) \
+    X(prefix, type, AVTP_SENSOR_FIELD_SENSOR_GROUP,      SensorGroup,      0, 26,  6) \
+    X(prefix, type, AVTP_SENSOR_FIELD_MESSAGE_TIMESTAMP, MessageTimestamp, 1,  0, 64)
+
+/**
+ * Specialized accessors for each ACF Sensor header field, e.g.
+ * Avtp_Sensor_GetNumSensor() and Avtp_Sensor_SetNumSensor().
+ */
+AVTP_SENSOR_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Sensor, Avtp_Sensor_t)
+
 /**
  * Initializes an ACF Sensor PDU header as specified in the IEEE 1722 Specification.
  *
@@ -91,4 +141,85 @@ int Avtp_Sensor_GetField(Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field, u
  * @returns This function returns 0 if the data field was successfully set in
  * the 1722 ACF Sensor PDU.
  */
-int Avtp_Sensor_SetField(Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field, uint64_t value);
\ No newline at end of file
+int Avtp_Sensor_SetField(Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field, uint64_t value);
+
+/**
+ * Same as Avtp_Sensor_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param sensor_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Sensor_GetField_Unchecked(const Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field);
+
+/**
+ * Same as Avtp_Sensor_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param sensor_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Sensor_SetField_Unchecked(Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field, uint64_t value);
+
+/**
+ * Copies an array of sensor data items in host byte-order into the payload of
+ * an ACF Sensor message. The items are converted to network byte-order in bulk
+ * and the payload is zero padded to the next quadlet. This function also sets
+ * the num_sensor, sz and acf_msg_length fields.
+ *
+ * @param sensor_pdu Pointer to the first bit of an 1722 ACF Sensor PDU.
+ * @param samples Pointer to an array of uint8_t, uint16_t, uint32_t or
+ * uint64_t (or same sized types) matching sz.
+ * @param num_samples Number of sensor data items (at most AVTP_SENSOR_MAX_SAMPLES).
+ * @param sz Size of each sensor data item.
+ * @returns Returns number of processed bytes (header + payload + padding) or
+ * -EINVAL if the arguments are invalid.
+ */
+int Avtp_Sensor_PackSamples(Avtp_Sensor_t* sensor_pdu, const void* samples,
+                            uint8_t num_samples, Avtp_SensorSz_t sz);
+
+/**
+ * Copies the sensor data items of an ACF Sensor message into an array in host
+ * byte-order. The size of each item is given by the sz field, see
+ * Avtp_Sensor_GetSampleSize().
+ *
+ * @param sensor_pdu Pointer to the first bit of an 1722 ACF Sensor PDU.
+ * @param samples Pointer to the destination array.
+ * @param max_samples Capacity of the destination array in items.
+ * @returns Returns the number of sensor data items copied or -EINVAL if the
+ * arguments are invalid, the acf_msg_length field is too short for num_sensor
+ * items or the destination array is too small.
+ */
+int Avtp_Sensor_UnpackSamples(const Avtp_Sensor_t* sensor_pdu, void* samples,
+                              uint8_t max_samples);
+
+/**
+ * Converts sensor data items from host to network byte-order into a payload
+ * and zero pads it to the next quadlet. This is the common part of
+ * Avtp_Sensor_PackSamples() and Avtp_SensorBrief_PackSamples(), which should be
+ * used instead.
+ *
+ * @param payload Pointer to the payload of an ACF Sensor or Sensor Brief PDU.
+ * @param samples Pointer to the sensor data items in host byte-order.
+ * @param num_samples Number of sensor data items.
+ * @param sz Size of each sensor data item.
+ * @returns Number of payload bytes written including padding.
+ */
+size_t Avtp_Sensor_EncodeSamples(uint8_t* payload, const void* samples,
+                                 uint8_t num_samples, Avtp_SensorSz_t sz);
+
+/**
+ * Converts sensor data items of a payload from network to host byte-order.
+ * This is the common part of Avtp_Sensor_UnpackSamples() and
+ * Avtp_SensorBrief_UnpackSamples(), which should be used instead.
+ *
+ * @param samples Pointer to the destination array.
+ * @param payload Pointer to the payload of an ACF Sensor or Sensor Brief PDU.
+ * @param num_samples Number of sensor data items.
+ * @param sz Size of each sensor data item.
+ */
+void Avtp_Sensor_DecodeSamples(void* samples, const uint8_t* payload,
+                               uint8_t num_samples, Avtp_SensorSz_t sz);
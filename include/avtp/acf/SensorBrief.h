@@ -38,12 +38,14 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/Utils.h"
 #include "avtp/acf/Common.h"
+#include "avtp/acf/Sensor.h"
 
-#define AVTP_SENSOR_HEADER_LEN         (1 * AVTP_QUADLET_SIZE)
+#define AVTP_SENSOR_BRIEF_HEADER_LEN   (1 * AVTP_QUADLET_SIZE)
 
 typedef struct {
-    uint8_t header[AVTP_SENSOR_HEADER_LEN];
+    uint8_t header[AVTP_SENSOR_BRIEF_HEADER_LEN];
     uint8_t payload[0];
 } Avtp_SensorBrief_t;
 
@@ -57,9 +59,29 @@ typedef enum {
     AVTP_SENSOR_BRIEF_FIELD_SZ,
     AVTP_SENSOR_BRIEF_FIELD_SENSOR_GROUP,        
     /* Count number of fields for bound checks */
-    AVTP_SENSOR_FIELD_MAX
+    AVTP_SENSOR_BRIEF_FIELD_MAX
 } Avtp_SensorBriefFields_t;
 
+/**
+ * Position of all ACF Abbreviated Sensor header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_SENSOR_BRIEF_FIELD_LIST(X, prefix, type)                                \
+    /* ACF common header fields */                                                   \
+    X(prefix, type, AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_TYPE,   AcfMsgType,   0,  0,  7) \
+    X(prefix, type, AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_LENGTH, AcfMsgLength, 0,  7,  9) \
+    /* ACF Abbreviated Sensor header fields */                                       \
+    X(prefix, type, AVTP_SENSOR_BRIEF_FIELD_MTV,            Mtv,          0, 16,  1) \
+    X(prefix, type, AVTP_SENSOR_BRIEF_FIELD_NUM_SENSOR,     NumSensor,    0, 17,  7) \
+    X(prefix, type, AVTP_SENSOR_BRIEF_FIELD_SZ,             Sz,           0, 24,  2) \
+    X(prefix, type, AVTP_SENSOR_BRIEF_FIELD_SENSOR_GROUP,   SensorGroup,  0, 26,  6)
+
+/**
+ * Specialized accessors for each ACF Abbreviated Sensor header field, e.g.
+ * Avtp_SensorBrief_GetSensorGroup() and Avtp_SensorBrief_SetSensorGroup().
+ */
+AVTP_SENSOR_BRIEF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_SensorBrief, Avtp_SensorBrief_t)
+
 /**
  * Initializes an ACF Abbreviated Sensor PDU header as specified in the IEEE 1722 Specification.
  *
@@ -88,3 +110,50 @@ int Avtp_SensorBrief_GetField(Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFi
  * the 1722 ACF Abbreviated Sensor PDU.
  */
 int Avtp_SensorBrief_SetField(Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field, uint64_t value);
+
+/**
+ * Same as Avtp_SensorBrief_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param sensor_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_SensorBrief_GetField_Unchecked(const Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field);
+
+/**
+ * Same as Avtp_SensorBrief_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param sensor_pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_SensorBrief_SetField_Unchecked(Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field, uint64_t value);
+
+/**
+ * Copies an array of sensor data items in host byte-order into the payload of
+ * an ACF Abbreviated Sensor message. See Avtp_Sensor_PackSamples().
+ *
+ * @param sensor_pdu Pointer to the first bit of an 1722 ACF Abbreviated Sensor PDU.
+ * @param samples Pointer to an array of items matching sz.
+ * @param num_samples Number of sensor data items (at most AVTP_SENSOR_MAX_SAMPLES).
+ * @param sz Size of each sensor data item.
+ * @returns Returns number of processed bytes (header + payload + padding) or
+ * -EINVAL if the arguments are invalid.
+ */
+int Avtp_SensorBrief_PackSamples(Avtp_SensorBrief_t* sensor_pdu, const void* samples,
+                                 uint8_t num_samples, Avtp_SensorSz_t sz);
+
+/**
+ * Copies the sensor data items of an ACF Abbreviated Sensor message into an
+ * array in host byte-order. See Avtp_Sensor_UnpackSamples().
+ *
+ * @param sensor_pdu Pointer to the first bit of an 1722 ACF Abbreviated Sensor PDU.
+ * @param samples Pointer to the destination array.
+ * @param max_samples Capacity of the destination array in items.
+ * @returns Returns the number of sensor data items copied or -EINVAL.
+ */
+int Avtp_SensorBrief_UnpackSamples(const Avtp_SensorBrief_t* sensor_pdu, void* samples,
+                                   uint8_t max_samples);
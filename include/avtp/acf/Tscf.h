@@ -38,6 +38,8 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/PduView.h"
+#include "avtp/Utils.h"
 
 #define AVTP_TSCF_HEADER_LEN               (6 * AVTP_QUADLET_SIZE)
 
@@ -66,6 +68,47 @@ typedef enum {
     AVTP_TSCF_FIELD_MAX
 } Avtp_TscfFields_t;
 
+/**
+ * Position of all TSCF header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_TSCF_FIELD_LIST(X, prefix, type)                                        \
+    /* Common AVTP header */                                                         \
+    X(prefix, type, AVTP_TSCF_FIELD_SUBTYPE,            Subtype,          0,  0,  8) \
+    X(prefix, type, AVTP_TSCF_FIELD_SV,                 Sv,               0,  8,  1) \
+    X(prefix, type, AVTP_TSCF_FIELD_VERSION,            Version,          0,  9,  3) \
+    /* TSCF header*/                                                                 \
+    X(prefix, type, AVTP_TSCF_FIELD_MR,                 Mr,               0, 12,  1) \
+    X(prefix, type, AVTP_TSCF_FIELD_TV,                 Tv,               0, 15,  1) \
+    X(prefix, type, AVTP_TSCF_FIELD_SEQUENCE_NUM,       SequenceNum,      0, 16,  8) \
+    X(prefix, type, AVTP_TSCF_FIELD_TU,                 Tu,               0, 31,  1) \
+    X(prefix, type, AVTP_TSCF_FIELD_STREAM_ID,          StreamId,         1,  0, 64) \
+    X(prefix, type, AVTP_TSCF_FIELD_AVTP_TIMESTAMP,     AvtpTimestamp,    3,  0, 32) \
+    X(prefix, type, AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, StreamDataLength, 5,  0, 16)
+
+/**
+ * Specialized accessors for each TSCF header field, e.g.
+ * Avtp_Tscf_GetAvtpTimestamp() and Avtp_Tscf_SetAvtpTimestamp().
+ */
+AVTP_TSCF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Tscf, Avtp_Tscf_t)
+
+/**
+ * Host byte-order representation of all TSCF header fields. Reserved bits are
+ * not represented and are cleared by Avtp_Tscf_Pack().
+ */
+typedef struct {
+    uint8_t  subtype;
+    uint8_t  sv;
+    uint8_t  version;
+    uint8_t  mr;
+    uint8_t  tv;
+    uint8_t  sequence_num;
+    uint8_t  tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    uint16_t stream_data_length;
+} Avtp_TscfHeader_t;
+
 
 /**
  * Initializes a TSCF PDU as specified in the IEEE 1722-2016 Specification.
@@ -95,4 +138,57 @@ int Avtp_Tscf_GetField(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t* valu
  * @returns This function returns 0 if the data field was successfully set in
  * the 1722 AVTP PDU.
  */
-int Avtp_Tscf_SetField(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t value);
\ No newline at end of file
+int Avtp_Tscf_SetField(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t value);
+
+/**
+ * Same as Avtp_Tscf_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Tscf_GetField_Unchecked(const Avtp_Tscf_t* pdu, Avtp_TscfFields_t field);
+
+/**
+ * Same as Avtp_Tscf_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Tscf_SetField_Unchecked(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t value);
+/**
+ * Decodes all header fields of a TSCF PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of a 1722 TSCF PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_Tscf_Unpack(const Avtp_Tscf_t* pdu, Avtp_TscfHeader_t* header);
+
+/**
+ * Encodes all header fields of a TSCF PDU in a single pass. This is the
+ * counterpart of Avtp_Tscf_Unpack().
+ *
+ * @param pdu Pointer to the first bit of a 1722 TSCF PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_Tscf_Pack(Avtp_Tscf_t* pdu, const Avtp_TscfHeader_t* header);
+
+/**
+ * Creates a view of a received TSCF PDU. Checks that the buffer holds the
+ * complete TSCF header, that the subtype matches and that the payload announced
+ * by stream_data_length fits into the buffer. On success the view covers the
+ * header and the payload, which can then be accessed without further checks.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the received TSCF PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete TSCF PDU.
+ */
+int Avtp_Tscf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
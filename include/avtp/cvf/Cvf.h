@@ -31,6 +31,7 @@
 
 #include <stdint.h>
 
+#include "avtp/PduView.h"
 #include "avtp/Utils.h"
 
 #define AVTP_CVF_HEADER_LEN (6 * AVTP_QUADLET_SIZE)
@@ -66,6 +67,60 @@ typedef enum Avtp_CvfField {
     AVTP_CVF_FIELD_MAX
 } Avtp_CvfField_t;
 
+/**
+ * Position of all CVF header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_CVF_FIELD_LIST(X, prefix, type)                                        \
+    X(prefix, type, AVTP_CVF_FIELD_SUBTYPE,            Subtype,          0,  0,  8) \
+    X(prefix, type, AVTP_CVF_FIELD_SV,                 Sv,               0,  8,  1) \
+    X(prefix, type, AVTP_CVF_FIELD_VERSION,            Version,          0,  9,  3) \
+    X(prefix, type, AVTP_CVF_FIELD_MR,                 Mr,               0, 12,  1) \
+    X(prefix, type, AVTP_CVF_FIELD_RESERVED,           Reserved,         0, 13,  2) \
+    X(prefix, type, AVTP_CVF_FIELD_TV,                 Tv,               0, 15,  1) \
+    X(prefix, type, AVTP_CVF_FIELD_SEQUENCE_NUM,       SequenceNum,      0, 16,  8) \
+    X(prefix, type, AVTP_CVF_FIELD_RESERVED_2,         Reserved2,        0, 24,  7) \
+    X(prefix, type, AVTP_CVF_FIELD_TU,                 Tu,               0, 31,  1) \
+    X(prefix, type, AVTP_CVF_FIELD_STREAM_ID,          StreamId,         1,  0, 64) \
+    X(prefix, type, AVTP_CVF_FIELD_AVTP_TIMESTAMP,     AvtpTimestamp,    3,  0, 32) \
+    X(prefix, type, AVTP_CVF_FIELD_FORMAT,             Format,           4,  0,  8) \
+    X(prefix, type, AVTP_CVF_FIELD_FORMAT_SUBTYPE,     FormatSubtype,    4,  8,  8) \
+    X(prefix, type, AVTP_CVF_FIELD_RESERVED_3,         Reserved3,        4, 16, 16) \
+    X(prefix, type, AVTP_CVF_FIELD_STREAM_DATA_LENGTH, StreamDataLength, 5,  0, 16) \
+    X(prefix, type, AVTP_CVF_FIELD_RESERVED_4,         Reserved4,        5, 16,  2) \
+    X(prefix, type, AVTP_CVF_FIELD_PTV,                Ptv,              5, 18,  1) \
+    X(prefix, type, AVTP_CVF_FIELD_M,                  M,                5, 19,  1) \
+    X(prefix, type, AVTP_CVF_FIELD_EVT,                Evt,              5, 20,  4) \
+    X(prefix, type, AVTP_CVF_FIELD_RESERVED_5,         Reserved5,        5, 24,  8)
+
+/**
+ * Specialized accessors for each CVF header field, e.g.
+ * Avtp_Cvf_GetFormatSubtype() and Avtp_Cvf_SetFormatSubtype().
+ */
+AVTP_CVF_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Cvf, Avtp_Cvf_t)
+
+/**
+ * Host byte-order representation of all CVF header fields. Reserved bits are
+ * not represented and are cleared by Avtp_Cvf_Pack().
+ */
+typedef struct {
+    uint8_t  subtype;
+    uint8_t  sv;
+    uint8_t  version;
+    uint8_t  mr;
+    uint8_t  tv;
+    uint8_t  sequence_num;
+    uint8_t  tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    uint8_t  format;
+    uint8_t  format_subtype;
+    uint16_t stream_data_length;
+    uint8_t  ptv;
+    uint8_t  m;
+    uint8_t  evt;
+} Avtp_CvfHeader_t;
+
 typedef enum Avtp_CvfFormat {
     AVTP_CVF_FORMAT_RFC                 = 0x2
 } Avtp_CvfFormat_t;
@@ -82,6 +137,60 @@ int Avtp_Cvf_GetField(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t* value);
 
 int Avtp_Cvf_SetField(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t value);
 
+/**
+ * Same as Avtp_Cvf_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Cvf_GetField_Unchecked(const Avtp_Cvf_t* pdu, Avtp_CvfField_t field);
+
+/**
+ * Same as Avtp_Cvf_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Cvf_SetField_Unchecked(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t value);
+
+/**
+ * Decodes all header fields of a CVF PDU in a single pass. Each header quadlet
+ * is loaded and byte-swapped only once.
+ *
+ * @param pdu Pointer to the first bit of a 1722 CVF PDU.
+ * @param header Pointer to the struct the header fields are stored in.
+ * @returns This function returns 0 if the header was successfully decoded.
+ */
+int Avtp_Cvf_Unpack(const Avtp_Cvf_t* pdu, Avtp_CvfHeader_t* header);
+
+/**
+ * Encodes all header fields of a CVF PDU in a single pass. This is the
+ * counterpart of Avtp_Cvf_Unpack().
+ *
+ * @param pdu Pointer to the first bit of a 1722 CVF PDU.
+ * @param header Pointer to the struct holding the header fields.
+ * @returns This function returns 0 if the header was successfully encoded.
+ */
+int Avtp_Cvf_Pack(Avtp_Cvf_t* pdu, const Avtp_CvfHeader_t* header);
+
+/**
+ * Creates a view of a received CVF PDU. Checks that the buffer holds the
+ * complete CVF header, that the subtype matches and that the payload announced
+ * by stream_data_length fits into the buffer. On success the view covers the
+ * header and the payload, which can then be accessed without further checks.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param buf Pointer to the first byte of the received CVF PDU.
+ * @param len Number of valid bytes in the buffer.
+ * @returns This function returns 0 if the buffer holds a complete CVF PDU.
+ */
+int Avtp_Cvf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len);
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
@@ -47,8 +47,42 @@ typedef enum Avtp_H264Field {
     AVTP_H264_FIELD_MAX,
 } Avtp_H264Field_t;
 
+/**
+ * Position of all CVF H.264 header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_H264_FIELD_LIST(X, prefix, type)                        \
+    X(prefix, type, AVTP_H264_FIELD_TIMESTAMP, Timestamp, 0,  0, 32)
+
+/**
+ * Specialized accessors for each CVF H.264 header field, e.g.
+ * Avtp_H264_GetTimestamp() and Avtp_H264_SetTimestamp().
+ */
+AVTP_H264_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_H264, Avtp_H264_t)
+
 int Avtp_H264_Init(Avtp_H264_t* pdu);
 
 int Avtp_H264_GetField(Avtp_H264_t* pdu, Avtp_H264Field_t field, uint64_t* value);
 
 int Avtp_H264_SetField(Avtp_H264_t* pdu, Avtp_H264Field_t field, uint64_t value);
+
+/**
+ * Same as Avtp_H264_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_H264_GetField_Unchecked(const Avtp_H264_t* pdu, Avtp_H264Field_t field);
+
+/**
+ * Same as Avtp_H264_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_H264_SetField_Unchecked(Avtp_H264_t* pdu, Avtp_H264Field_t field, uint64_t value);
@@ -54,8 +54,49 @@ typedef enum Avtp_Jpeg2000Field {
     AVTP_JPEG2000_FIELD_MAX
 } Avtp_Jpeg2000Field_t;
 
+/**
+ * Position of all CVF JPEG2000 header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_JPEG2000_FIELD_LIST(X, prefix, type)                                   \
+    X(prefix, type, AVTP_JPEG2000_FIELD_TP,              Tp,             0,  0,  2) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_MHF,             Mhf,            0,  2,  2) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_MH_ID,           MhId,           0,  4,  3) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_T,               T,              0,  7,  1) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_PRIORITY,        Priority,       0,  8,  8) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_TILE_NUMBER,     TileNumber,     0, 16, 16) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_RESERVED,        Reserved,       1,  0,  8) \
+    X(prefix, type, AVTP_JPEG2000_FIELD_FRAGMENT_OFFSET, FragmentOffset, 1,  8, 24)
+
+/**
+ * Specialized accessors for each CVF JPEG2000 header field, e.g.
+ * Avtp_Jpeg2000_GetFragmentOffset() and Avtp_Jpeg2000_SetFragmentOffset().
+ */
+AVTP_JPEG2000_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Jpeg2000, Avtp_Jpeg2000_t)
+
 int Avtp_Jpeg2000_Init(Avtp_Jpeg2000_t* pdu);
 
 int Avtp_Jpeg2000_GetField(Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field, uint64_t* value);
 
 int Avtp_Jpeg2000_SetField(Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field, uint64_t value);
+
+/**
+ * Same as Avtp_Jpeg2000_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Jpeg2000_GetField_Unchecked(const Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field);
+
+/**
+ * Same as Avtp_Jpeg2000_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Jpeg2000_SetField_Unchecked(Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field, uint64_t value);
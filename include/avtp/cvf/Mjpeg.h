@@ -52,8 +52,47 @@ typedef enum Avtp_MjpegField {
     AVTP_MJPEG_FIELD_MAX
 } Avtp_MjpegField_t;
 
+/**
+ * Position of all CVF MJPEG header fields. See AVTP_FIELD_DESCRIPTOR and
+ * AVTP_FIELD_ACCESSORS in avtp/Utils.h for how this list is expanded.
+ */
+#define AVTP_MJPEG_FIELD_LIST(X, prefix, type)                                   \
+    X(prefix, type, AVTP_MJPEG_FIELD_TYPE_SPECIFIC,   TypeSpecific,   0,  0,  8) \
+    X(prefix, type, AVTP_MJPEG_FIELD_FRAGMENT_OFFSET, FragmentOffset, 0,  8, 24) \
+    X(prefix, type, AVTP_MJPEG_FIELD_TYPE,            Type,           1,  0,  8) \
+    X(prefix, type, AVTP_MJPEG_FIELD_Q,               Q,              1,  8,  8) \
+    X(prefix, type, AVTP_MJPEG_FIELD_WIDTH,           Width,          1, 16,  8) \
+    X(prefix, type, AVTP_MJPEG_FIELD_HEIGHT,          Height,         1, 24,  8)
+
+/**
+ * Specialized accessors for each CVF MJPEG header field, e.g.
+ * Avtp_Mjpeg_GetWidth() and Avtp_Mjpeg_SetWidth().
+ */
+AVTP_MJPEG_FIELD_LIST(AVTP_FIELD_ACCESSORS, Avtp_Mjpeg, Avtp_Mjpeg_t)
+
 int Avtp_Mjpeg_Init(Avtp_Mjpeg_t* pdu);
 
 int Avtp_Mjpeg_GetField(Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field, uint64_t* value);
 
 int Avtp_Mjpeg_SetField(Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field, uint64_t value);
+
+/**
+ * Same as Avtp_Mjpeg_GetField() but without any argument checks, for use on
+ * fast paths once the stream has been set up. The arguments are only
+ * asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be read.
+ * @returns The value of the data field.
+ */
+uint64_t Avtp_Mjpeg_GetField_Unchecked(const Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field);
+
+/**
+ * Same as Avtp_Mjpeg_SetField() but without any argument checks. The arguments
+ * are only asserted in debug builds.
+ *
+ * @param pdu Pointer to the first bit of the 1722 PDU.
+ * @param field Specifies the position of the data field to be written.
+ * @param value The value to set.
+ */
+void Avtp_Mjpeg_SetField_Unchecked(Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field, uint64_t value);
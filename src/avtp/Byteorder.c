@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "avtp/Byteorder.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AVTP_BSWAP_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define AVTP_BSWAP_NEON
+#include <arm_neon.h>
+#endif
+
+typedef void (*BswapArrayFn_t)(void* dst, const void* src, size_t n);
+
+/******************************************************************************
+ * Scalar kernels
+ *****************************************************************************/
+
+static void BswapArray16_Scalar(void* dst, const void* src, size_t n)
+{
+    uint8_t* d = dst;
+    const uint8_t* s = src;
+    for (size_t i = 0; i < n; i++) {
+        uint16_t x;
+        memcpy(&x, s + i * sizeof(x), sizeof(x));
+        x = Avtp_Bswap16(x);
+        memcpy(d + i * sizeof(x), &x, sizeof(x));
+    }
+}
+
+static void BswapArray32_Scalar(void* dst, const void* src, size_t n)
+{
+    uint8_t* d = dst;
+    const uint8_t* s = src;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t x;
+        memcpy(&x, s + i * sizeof(x), sizeof(x));
+        x = Avtp_Bswap32(x);
+        memcpy(d + i * sizeof(x), &x, sizeof(x));
+    }
+}
+
+static void BswapArray64_Scalar(void* dst, const void* src, size_t n)
+{
+    uint8_t* d = dst;
+    const uint8_t* s = src;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x;
+        memcpy(&x, s + i * sizeof(x), sizeof(x));
+        x = Avtp_Bswap64(x);
+        memcpy(d + i * sizeof(x), &x, sizeof(x));
+    }
+}
+
+/******************************************************************************
+ * x86 kernels (SSSE3 and AVX2)
+ *
+ * Both use a byte shuffle with a mask that reverses the bytes within each
+ * element. Loads and stores are unaligned, the remaining elements that do not
+ * fill a whole vector are handled by the scalar kernels.
+ *****************************************************************************/
+
+#ifdef AVTP_BSWAP_X86
+
+#define BSWAP16_MASK 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+#define BSWAP32_MASK 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+#define BSWAP64_MASK 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7
+
+#define DEFINE_BSWAP_ARRAY_SSSE3(bits)                                          \
+    __attribute__((target("ssse3")))                                          \
+    static void BswapArray##bits##_Ssse3(void* dst, const void* src, size_t n) \
+    {                                                                           \
+        const size_t perVector = 16 / (bits / 8);                               \
+        const __m128i mask = _mm_set_epi8(BSWAP##bits##_MASK);                  \
+        uint8_t* d = dst;                                                       \
+        const uint8_t* s = src;                                                 \
+        size_t i = 0;                                                           \
+        for (; i + perVector <= n; i += perVector) {                            \
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i * (bits / 8)));  \
+            v = _mm_shuffle_epi8(v, mask);                                      \
+            _mm_storeu_si128((__m128i*)(d + i * (bits / 8)), v);                \
+        }                                                                       \
+        BswapArray##bits##_Scalar(d + i * (bits / 8), s + i * (bits / 8), n - i); \
+    }
+
+#define DEFINE_BSWAP_ARRAY_AVX2(bits)                                           \
+    __attribute__((target("avx2")))                                           \
+    static void BswapArray##bits##_Avx2(void* dst, const void* src, size_t n)  \
+    {                                                                           \
+        const size_t perVector = 32 / (bits / 8);                               \
+        const __m256i mask = _mm256_set_epi8(BSWAP##bits##_MASK,                \
+                                             BSWAP##bits##_MASK);               \
+        uint8_t* d = dst;                                                       \
+        const uint8_t* s = src;                                                 \
+        size_t i = 0;                                                           \
+        for (; i + perVector <= n; i += perVector) {                            \
+            __m256i v = _mm256_loadu_si256((const __m256i*)(s + i * (bits / 8))); \
+            v = _mm256_shuffle_epi8(v, mask);                                   \
+            _mm256_storeu_si256((__m256i*)(d + i * (bits / 8)), v);             \
+        }                                                                       \
+        BswapArray##bits##_Scalar(d + i * (bits / 8), s + i * (bits / 8), n - i); \
+    }
+
+DEFINE_BSWAP_ARRAY_SSSE3(16)
+DEFINE_BSWAP_ARRAY_SSSE3(32)
+DEFINE_BSWAP_ARRAY_SSSE3(64)
+DEFINE_BSWAP_ARRAY_AVX2(16)
+DEFINE_BSWAP_ARRAY_AVX2(32)
+DEFINE_BSWAP_ARRAY_AVX2(64)
+
+#endif
+
+/******************************************************************************
+ * ARM kernels (NEON)
+ *
+ * NEON is part of the AArch64 baseline, so these are selected at compile time
+ * whenever the compiler targets NEON.
+ *****************************************************************************/
+
+#ifdef AVTP_BSWAP_NEON
+
+#define DEFINE_BSWAP_ARRAY_NEON(bits, rev)                                      \
+    static void BswapArray##bits##_Neon(void* dst, const void* src, size_t n)  \
+    {                                                                           \
+        const size_t perVector = 16 / (bits / 8);                               \
+        uint8_t* d = dst;                                                       \
+        const uint8_t* s = src;                                                 \
+        size_t i = 0;                                                           \
+        for (; i + perVector <= n; i += perVector) {                            \
+            uint8x16_t v = vld1q_u8(s + i * (bits / 8));                        \
+            vst1q_u8(d + i * (bits / 8), rev(v));                               \
+        }                                                                       \
+        BswapArray##bits##_Scalar(d + i * (bits / 8), s + i * (bits / 8), n - i); \
+    }
+
+DEFINE_BSWAP_ARRAY_NEON(16, vrev16q_u8)
+DEFINE_BSWAP_ARRAY_NEON(32, vrev32q_u8)
+DEFINE_BSWAP_ARRAY_NEON(64, vrev64q_u8)
+
+#endif
+
+/******************************************************************************
+ * Run-time dispatch
+ *****************************************************************************/
+
+#if defined(AVTP_BSWAP_NEON)
+static BswapArrayFn_t bswapArray16 = BswapArray16_Neon;
+static BswapArrayFn_t bswapArray32 = BswapArray32_Neon;
+static BswapArrayFn_t bswapArray64 = BswapArray64_Neon;
+#else
+static BswapArrayFn_t bswapArray16 = BswapArray16_Scalar;
+static BswapArrayFn_t bswapArray32 = BswapArray32_Scalar;
+static BswapArrayFn_t bswapArray64 = BswapArray64_Scalar;
+#endif
+
+#ifdef AVTP_BSWAP_X86
+/**
+ * Selects the widest kernels supported by the CPU. Runs once when the library
+ * is loaded, so the function pointers are never written concurrently.
+ */
+__attribute__((constructor))
+static void SelectBswapArrayKernels(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        bswapArray16 = BswapArray16_Avx2;
+        bswapArray32 = BswapArray32_Avx2;
+        bswapArray64 = BswapArray64_Avx2;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        bswapArray16 = BswapArray16_Ssse3;
+        bswapArray32 = BswapArray32_Ssse3;
+        bswapArray64 = BswapArray64_Ssse3;
+    }
+}
+#endif
+
+void Avtp_BswapArray16(void* dst, const void* src, size_t n)
+{
+    bswapArray16(dst, src, n);
+}
+
+void Avtp_BswapArray32(void* dst, const void* src, size_t n)
+{
+    bswapArray32(dst, src, n);
+}
+
+void Avtp_BswapArray64(void* dst, const void* src, size_t n)
+{
+    bswapArray64(dst, src, n);
+}
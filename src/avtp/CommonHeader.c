@@ -37,10 +37,7 @@
  * This table maps all IEEE 1722 common header fields to a descriptor.
  */
 static const Avtp_FieldDescriptor_t Avtp_CommonHeaderFieldDesc[AVTP_COMMON_HEADER_FIELD_MAX] = {
-    /* Common AVTP header */
-    [AVTP_COMMON_HEADER_FIELD_SUBTYPE]            = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_COMMON_HEADER_FIELD_H]                  = { .quadlet = 0, .offset = 8, .bits = 1 },
-    [AVTP_COMMON_HEADER_FIELD_VERSION]            = { .quadlet = 0, .offset = 9, .bits = 3 },
+    AVTP_COMMON_HEADER_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_CommonHeader, Avtp_CommonHeader_t)
 };
 
 int Avtp_CommonHeader_GetField(Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderField_t field, uint64_t* value)
@@ -53,6 +50,16 @@ int Avtp_CommonHeader_SetField(Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderF
     return Avtp_SetField(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (uint8_t*)avtp_pdu, (uint8_t)field, value);        
 }
 
+uint64_t Avtp_CommonHeader_GetField_Unchecked(const Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderField_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (const uint8_t*)avtp_pdu, (uint8_t)field);
+}
+
+void Avtp_CommonHeader_SetField_Unchecked(Avtp_CommonHeader_t* avtp_pdu, Avtp_CommonHeaderField_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (uint8_t*)avtp_pdu, (uint8_t)field, value);
+}
+
 /******************************************************************************
  * Legacy API
  *****************************************************************************/
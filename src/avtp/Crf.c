@@ -41,20 +41,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_MAX] =
 {
-    [AVTP_CRF_FIELD_SUBTYPE]                = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_CRF_FIELD_SV]                     = { .quadlet = 0, .offset = 8, .bits = 1 },
-    [AVTP_CRF_FIELD_VERSION]                = { .quadlet = 0, .offset = 9, .bits = 3 },
-    [AVTP_CRF_FIELD_MR]                     = { .quadlet = 0, .offset = 12, .bits = 1 },
-    [AVTP_CRF_FIELD_RESERVED]               = { .quadlet = 0, .offset = 13, .bits = 1 },
-    [AVTP_CRF_FIELD_FS]                     = { .quadlet = 0, .offset = 14, .bits = 1 },
-    [AVTP_CRF_FIELD_TU]                     = { .quadlet = 0, .offset = 15, .bits = 1 },
-    [AVTP_CRF_FIELD_SEQUENCE_NUM]           = { .quadlet = 0, .offset = 16, .bits = 8 },
-    [AVTP_CRF_FIELD_TYPE]                   = { .quadlet = 0, .offset = 24, .bits = 8 },
-    [AVTP_CRF_FIELD_STREAM_ID]              = { .quadlet = 1, .offset = 0, .bits = 64 },
-    [AVTP_CRF_FIELD_PULL]                   = { .quadlet = 3, .offset = 0, .bits = 3 },
-    [AVTP_CRF_FIELD_BASE_FREQUENCY]         = { .quadlet = 3, .offset = 3, .bits = 29 },
-    [AVTP_CRF_FIELD_CRF_DATA_LENGTH]        = { .quadlet = 4, .offset = 0, .bits = 16 },
-    [AVTP_CRF_FIELD_TIMESTAMP_INTERVAL]     = { .quadlet = 4, .offset = 16, .bits = 16 },
+    AVTP_CRF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Crf, Avtp_Crf_t)
 };
 
 int Avtp_Crf_Init(Avtp_Crf_t* pdu) {
@@ -63,11 +50,15 @@ int Avtp_Crf_Init(Avtp_Crf_t* pdu) {
         return -EINVAL;
     }
 
+    const Avtp_FieldValue_t initValues[] = {
+        { AVTP_CRF_FIELD_SUBTYPE, AVTP_SUBTYPE_CRF },
+        { AVTP_CRF_FIELD_SV, 1 },
+    };
+
     memset(pdu, 0, sizeof(Avtp_Crf_t));
-    Avtp_Crf_SetField(pdu, AVTP_CRF_FIELD_SUBTYPE, AVTP_SUBTYPE_CRF);
-    Avtp_Crf_SetField(pdu, AVTP_CRF_FIELD_SV, 1);
 
-    return 0;
+    return Avtp_SetFields(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu,
+                          initValues, sizeof(initValues) / sizeof(initValues[0]));
 
 }
 
@@ -79,6 +70,90 @@ int Avtp_Crf_SetField(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t value) {
     return Avtp_SetField(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu, field, value);
 }
 
+uint64_t Avtp_Crf_GetField_Unchecked(const Avtp_Crf_t* pdu, Avtp_CrfField_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Crf_SetField_Unchecked(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
+
+int Avtp_Crf_Unpack(const Avtp_Crf_t* pdu, Avtp_CrfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CRF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_CRF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SUBTYPE]);
+    header->sv = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SV]);
+    header->version = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_VERSION]);
+    header->mr = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_MR]);
+    header->fs = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_FS]);
+    header->tu = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_TU]);
+    header->sequence_num = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SEQUENCE_NUM]);
+    header->type = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_TYPE]);
+    header->stream_id = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_STREAM_ID]);
+    header->pull = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_PULL]);
+    header->base_frequency = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_BASE_FREQUENCY]);
+    header->crf_data_length = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_CRF_DATA_LENGTH]);
+    header->timestamp_interval = Avtp_ExtractField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_TIMESTAMP_INTERVAL]);
+
+    return 0;
+}
+
+int Avtp_Crf_Pack(Avtp_Crf_t* pdu, const Avtp_CrfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CRF_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SUBTYPE], header->subtype);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SV], header->sv);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_VERSION], header->version);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_MR], header->mr);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_FS], header->fs);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_TU], header->tu);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SEQUENCE_NUM], header->sequence_num);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_TYPE], header->type);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_STREAM_ID], header->stream_id);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_PULL], header->pull);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_BASE_FREQUENCY], header->base_frequency);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_CRF_DATA_LENGTH], header->crf_data_length);
+    Avtp_InsertField(quadlets, &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_TIMESTAMP_INTERVAL], header->timestamp_interval);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_CRF_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_Crf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_CRF_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_Crf_t* pdu = (const Avtp_Crf_t*)buf;
+    if (Avtp_Crf_GetSubtype(pdu) != AVTP_SUBTYPE_CRF) {
+        return -EINVAL;
+    }
+
+    size_t pduLength = AVTP_CRF_HEADER_LEN + Avtp_Crf_GetCrfDataLength(pdu);
+    if (pduLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = pduLength;
+
+    return 0;
+}
+
 /******************************************************************************
  * Legacy API
  *****************************************************************************/
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/Dispatcher.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/Rvf.h"
+#include "avtp/aaf/PcmStream.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/cvf/Cvf.h"
+
+/**
+ * View constructor of each subtype that has one.
+ */
+static Avtp_DispatchInitView_t GetInitView(uint8_t subtype)
+{
+    switch (subtype) {
+    case AVTP_SUBTYPE_AAF:
+        return Avtp_AafPcmStream_InitView;
+    case AVTP_SUBTYPE_CVF:
+        return Avtp_Cvf_InitView;
+    case AVTP_SUBTYPE_RVF:
+        return Avtp_Rvf_InitView;
+    case AVTP_SUBTYPE_CRF:
+        return Avtp_Crf_InitView;
+    case AVTP_SUBTYPE_TSCF:
+        return Avtp_Tscf_InitView;
+    case AVTP_SUBTYPE_NTSCF:
+        return Avtp_Ntscf_InitView;
+    default:
+        return NULL;
+    }
+}
+
+int Avtp_Dispatcher_Init(Avtp_Dispatcher_t* dispatcher)
+{
+    if (dispatcher == NULL) {
+        return -EINVAL;
+    }
+
+    memset(dispatcher, 0, sizeof(*dispatcher));
+
+    return 0;
+}
+
+int Avtp_Dispatcher_Register(Avtp_Dispatcher_t* dispatcher, uint8_t subtype,
+                            Avtp_DispatchHandler_t handler, void* ctx)
+{
+    if (dispatcher == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_DispatchEntry_t* entry = &dispatcher->entries[subtype];
+    entry->initView = GetInitView(subtype);
+    entry->handler = handler;
+    entry->ctx = ctx;
+
+    return 0;
+}
+
+int Avtp_Dispatcher_SetDefault(Avtp_Dispatcher_t* dispatcher,
+                            Avtp_DispatchHandler_t handler, void* ctx)
+{
+    if (dispatcher == NULL) {
+        return -EINVAL;
+    }
+
+    dispatcher->fallback.initView = NULL;
+    dispatcher->fallback.handler = handler;
+    dispatcher->fallback.ctx = ctx;
+
+    return 0;
+}
@@ -42,37 +42,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_MAX] =
 {
-    [AVTP_RVF_FIELD_SUBTYPE]               = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_RVF_FIELD_SV]                    = { .quadlet = 0, .offset = 8, .bits = 1 },
-    [AVTP_RVF_FIELD_VERSION]               = { .quadlet = 0, .offset = 9, .bits = 3 },
-    [AVTP_RVF_FIELD_MR]                    = { .quadlet = 0, .offset = 12, .bits = 1 },
-    [AVTP_RVF_FIELD_RESERVED]              = { .quadlet = 0, .offset = 13, .bits = 2 },
-    [AVTP_RVF_FIELD_TV]                    = { .quadlet = 0, .offset = 15, .bits = 1 },
-    [AVTP_RVF_FIELD_SEQUENCE_NUM]          = { .quadlet = 0, .offset = 16, .bits = 8 },
-    [AVTP_RVF_FIELD_RESERVED_2]            = { .quadlet = 0, .offset = 24, .bits = 7 },
-    [AVTP_RVF_FIELD_TU]                    = { .quadlet = 0, .offset = 31, .bits = 1 },
-    [AVTP_RVF_FIELD_STREAM_ID]             = { .quadlet = 1, .offset = 0, .bits = 64 },
-    [AVTP_RVF_FIELD_AVTP_TIMESTAMP]        = { .quadlet = 3, .offset = 0, .bits = 32 },
-    [AVTP_RVF_FIELD_ACTIVE_PIXELS]         = { .quadlet = 4, .offset = 0, .bits = 16 },
-    [AVTP_RVF_FIELD_TOTAL_LINES]           = { .quadlet = 4, .offset = 16, .bits = 16 },
-    [AVTP_RVF_FIELD_STREAM_DATA_LENGTH]    = { .quadlet = 5, .offset = 0, .bits = 16 },
-    [AVTP_RVF_FIELD_AP]                    = { .quadlet = 5, .offset = 16, .bits = 1 },
-    [AVTP_RVF_FIELD_RESERVED_3]            = { .quadlet = 5, .offset = 17, .bits = 1 },
-    [AVTP_RVF_FIELD_F]                     = { .quadlet = 5, .offset = 18, .bits = 1 },
-    [AVTP_RVF_FIELD_EF]                    = { .quadlet = 5, .offset = 19, .bits = 1 },
-    [AVTP_RVF_FIELD_EVT]                   = { .quadlet = 5, .offset = 20, .bits = 4 },
-    [AVTP_RVF_FIELD_PD]                    = { .quadlet = 5, .offset = 24, .bits = 1 },
-    [AVTP_RVF_FIELD_I]                     = { .quadlet = 5, .offset = 25, .bits = 1 },
-    [AVTP_RVF_FIELD_RESERVED_4]            = { .quadlet = 5, .offset = 26, .bits = 6 },
-    [AVTP_RVF_FIELD_RESERVED_5]            = { .quadlet = 6, .offset = 0, .bits = 8 },
-    [AVTP_RVF_FIELD_PIXEL_DEPTH]           = { .quadlet = 6, .offset = 8, .bits = 4 },
-    [AVTP_RVF_FIELD_PIXEL_FORMAT]          = { .quadlet = 6, .offset = 12, .bits = 4 },
-    [AVTP_RVF_FIELD_FRAME_RATE]            = { .quadlet = 6, .offset = 16, .bits = 8 },
-    [AVTP_RVF_FIELD_COLORSPACE]            = { .quadlet = 6, .offset = 24, .bits = 4 },
-    [AVTP_RVF_FIELD_NUM_LINES]             = { .quadlet = 6, .offset = 28, .bits = 4 },
-    [AVTP_RVF_FIELD_RESERVED_6]            = { .quadlet = 7, .offset = 0, .bits = 8 },
-    [AVTP_RVF_FIELD_I_SEQ_NUM]             = { .quadlet = 7, .offset = 8, .bits = 8 },
-    [AVTP_RVF_FIELD_LINE_NUMBER]           = { .quadlet = 7, .offset = 16, .bits = 16 },
+    AVTP_RVF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Rvf, Avtp_Rvf_t)
 };
 
 int Avtp_Rvf_Init(Avtp_Rvf_t* pdu)
@@ -81,11 +51,15 @@ int Avtp_Rvf_Init(Avtp_Rvf_t* pdu)
         return -EINVAL;
     }
 
+    const Avtp_FieldValue_t initValues[] = {
+        { AVTP_RVF_FIELD_SUBTYPE, AVTP_SUBTYPE_RVF },
+        { AVTP_RVF_FIELD_SV, 1 },
+    };
+
     memset(pdu, 0, sizeof(Avtp_Rvf_t));
-    Avtp_Rvf_SetField(pdu, AVTP_RVF_FIELD_SUBTYPE, AVTP_SUBTYPE_RVF);
-    Avtp_Rvf_SetField(pdu, AVTP_RVF_FIELD_SV, 1);
 
-    return 0;
+    return Avtp_SetFields(Avtp_RvfFieldDescriptors, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu,
+                          initValues, sizeof(initValues) / sizeof(initValues[0]));
 }
 
 int Avtp_Rvf_GetField(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t* value)
@@ -98,6 +72,115 @@ int Avtp_Rvf_SetField(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t value)
     return Avtp_SetField(Avtp_RvfFieldDescriptors, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu, field, value);
 }
 
+uint64_t Avtp_Rvf_GetField_Unchecked(const Avtp_Rvf_t* pdu, Avtp_RvfField_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_RvfFieldDescriptors, AVTP_RVF_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Rvf_SetField_Unchecked(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_RvfFieldDescriptors, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
+
+int Avtp_Rvf_Unpack(const Avtp_Rvf_t* pdu, Avtp_RvfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_RVF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_RVF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_SUBTYPE]);
+    header->sv = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_SV]);
+    header->version = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_VERSION]);
+    header->mr = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_MR]);
+    header->tv = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_TV]);
+    header->sequence_num = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_SEQUENCE_NUM]);
+    header->tu = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_TU]);
+    header->stream_id = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_STREAM_ID]);
+    header->avtp_timestamp = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_AVTP_TIMESTAMP]);
+    header->active_pixels = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_ACTIVE_PIXELS]);
+    header->total_lines = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_TOTAL_LINES]);
+    header->stream_data_length = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_STREAM_DATA_LENGTH]);
+    header->ap = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_AP]);
+    header->f = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_F]);
+    header->ef = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_EF]);
+    header->evt = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_EVT]);
+    header->pd = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_PD]);
+    header->i = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_I]);
+    header->pixel_depth = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_PIXEL_DEPTH]);
+    header->pixel_format = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_PIXEL_FORMAT]);
+    header->frame_rate = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_FRAME_RATE]);
+    header->colorspace = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_COLORSPACE]);
+    header->num_lines = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_NUM_LINES]);
+    header->i_seq_num = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_I_SEQ_NUM]);
+    header->line_number = Avtp_ExtractField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_LINE_NUMBER]);
+
+    return 0;
+}
+
+int Avtp_Rvf_Pack(Avtp_Rvf_t* pdu, const Avtp_RvfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_RVF_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_SUBTYPE], header->subtype);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_SV], header->sv);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_VERSION], header->version);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_MR], header->mr);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_TV], header->tv);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_SEQUENCE_NUM], header->sequence_num);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_TU], header->tu);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_STREAM_ID], header->stream_id);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_AVTP_TIMESTAMP], header->avtp_timestamp);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_ACTIVE_PIXELS], header->active_pixels);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_TOTAL_LINES], header->total_lines);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_STREAM_DATA_LENGTH], header->stream_data_length);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_AP], header->ap);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_F], header->f);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_EF], header->ef);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_EVT], header->evt);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_PD], header->pd);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_I], header->i);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_PIXEL_DEPTH], header->pixel_depth);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_PIXEL_FORMAT], header->pixel_format);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_FRAME_RATE], header->frame_rate);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_COLORSPACE], header->colorspace);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_NUM_LINES], header->num_lines);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_I_SEQ_NUM], header->i_seq_num);
+    Avtp_InsertField(quadlets, &Avtp_RvfFieldDescriptors[AVTP_RVF_FIELD_LINE_NUMBER], header->line_number);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_RVF_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_Rvf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_RVF_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_Rvf_t* pdu = (const Avtp_Rvf_t*)buf;
+    if (Avtp_Rvf_GetSubtype(pdu) != AVTP_SUBTYPE_RVF) {
+        return -EINVAL;
+    }
+
+    size_t streamDataLength = Avtp_Rvf_GetStreamDataLength(pdu);
+    size_t pduLength = AVTP_RVF_HEADER_LEN - AVTP_RVF_RAW_HEADER_LEN + streamDataLength;
+    if (streamDataLength < AVTP_RVF_RAW_HEADER_LEN || pduLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = pduLength;
+
+    return 0;
+}
+
 /******************************************************************************
  * Legacy API
  *****************************************************************************/
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/StreamTemplate.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/Rvf.h"
+#include "avtp/aaf/PcmStream.h"
+#include "avtp/acf/Ntscf.h"
+
+/* Byte offsets of the per-packet fields shared by most stream headers. */
+#define STREAM_SEQ_NUM_OFFSET           2
+#define STREAM_TIMESTAMP_OFFSET         (3 * AVTP_QUADLET_SIZE)
+#define STREAM_DATA_LENGTH_OFFSET       (5 * AVTP_QUADLET_SIZE)
+
+/* CRF carries its timestamps in the payload and has a crf_data_length field. */
+#define CRF_DATA_LENGTH_OFFSET          (4 * AVTP_QUADLET_SIZE)
+
+/* NTSCF packs its 11 bit data length into the first quadlet. */
+#define NTSCF_SEQ_NUM_OFFSET            3
+#define NTSCF_DATA_LENGTH_OFFSET        1
+#define NTSCF_DATA_LENGTH_MASK          0x07FF
+
+int Avtp_StreamTemplate_Init(Avtp_StreamTemplate_t* tmpl, const uint8_t* header,
+                            uint16_t headerLen)
+{
+    uint16_t minHeaderLen;
+
+    if (tmpl == NULL || header == NULL || headerLen > AVTP_STREAM_TEMPLATE_MAX_LEN) {
+        return -EINVAL;
+    }
+
+    switch (header[0]) {
+    case AVTP_SUBTYPE_AAF:
+    case AVTP_SUBTYPE_CVF:
+    case AVTP_SUBTYPE_TSCF:
+    case AVTP_SUBTYPE_RVF:
+        minHeaderLen = (header[0] == AVTP_SUBTYPE_RVF) ?
+                AVTP_RVF_HEADER_LEN : AVTP_AAF_PCM_STREAM_HEADER_LEN;
+        tmpl->seqNumOffset = STREAM_SEQ_NUM_OFFSET;
+        tmpl->timestampOffset = STREAM_TIMESTAMP_OFFSET;
+        tmpl->lengthOffset = STREAM_DATA_LENGTH_OFFSET;
+        tmpl->lengthMask = 0xFFFF;
+        break;
+    case AVTP_SUBTYPE_CRF:
+        minHeaderLen = AVTP_CRF_HEADER_LEN;
+        tmpl->seqNumOffset = STREAM_SEQ_NUM_OFFSET;
+        tmpl->timestampOffset = -1;
+        tmpl->lengthOffset = CRF_DATA_LENGTH_OFFSET;
+        tmpl->lengthMask = 0xFFFF;
+        break;
+    case AVTP_SUBTYPE_NTSCF:
+        minHeaderLen = AVTP_NTSCF_HEADER_LEN;
+        tmpl->seqNumOffset = NTSCF_SEQ_NUM_OFFSET;
+        tmpl->timestampOffset = -1;
+        tmpl->lengthOffset = NTSCF_DATA_LENGTH_OFFSET;
+        tmpl->lengthMask = NTSCF_DATA_LENGTH_MASK;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    if (headerLen < minHeaderLen) {
+        return -EINVAL;
+    }
+
+    memset(tmpl->header, 0, sizeof(tmpl->header));
+    memcpy(tmpl->header, header, headerLen);
+    tmpl->headerLen = headerLen;
+
+    tmpl->lengthBase = Avtp_LoadBe16(header + tmpl->lengthOffset) & ~tmpl->lengthMask;
+
+    return 0;
+}
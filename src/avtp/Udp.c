@@ -37,8 +37,7 @@
  * This table maps all IEEE 1722 UDP-specific header fields to a descriptor.
  */
 static const Avtp_FieldDescriptor_t Avtp_UDPFieldDesc[AVTP_UDP_FIELD_MAX] = {
-
-    [AVTP_UDP_FIELD_ENCAPSULATION_SEQ_NO]       = { .quadlet = 0, .offset = 0, .bits = 32 },
+    AVTP_UDP_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_UDP, Avtp_UDP_t)
 };
 
 int Avtp_UDP_Init(Avtp_UDP_t* pdu) {
@@ -64,4 +63,14 @@ int Avtp_UDP_GetField(Avtp_UDP_t* pdu,
 int Avtp_UDP_SetField(Avtp_UDP_t* pdu, 
                             Avtp_UDPFields_t field, uint64_t value) {
     return Avtp_SetField(Avtp_UDPFieldDesc, AVTP_UDP_FIELD_MAX, (uint8_t*) pdu, (uint8_t) field, value); 
+}
+
+uint64_t Avtp_UDP_GetField_Unchecked(const Avtp_UDP_t* pdu, Avtp_UDPFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_UDPFieldDesc, AVTP_UDP_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_UDP_SetField_Unchecked(Avtp_UDP_t* pdu, Avtp_UDPFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_UDPFieldDesc, AVTP_UDP_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
 }
\ No newline at end of file
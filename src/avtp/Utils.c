@@ -27,6 +27,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <assert.h>
 #include <errno.h>
 #include <stdio.h>
 
@@ -37,21 +38,36 @@
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
+/**
+ * Number of distinct quadlets that Avtp_GetFields() and Avtp_SetFields() keep
+ * track of at once. This covers the headers of all supported formats.
+ */
+#define MAX_BATCHED_QUADLETS 16
+
+/**
+ * Pending update of a single quadlet collected by Avtp_SetFields().
+ */
+typedef struct {
+    uint8_t quadletId;
+    uint32_t mask;
+    uint32_t value;
+} QuadletUpdate_t;
+
 int IsFieldDescriptorValid(const Avtp_FieldDescriptor_t* fieldDescriptor)
 {
     return fieldDescriptor->bits <= 64 && fieldDescriptor->offset <= 31;
 }
 
-int Avtp_GetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
-                            uint8_t* pdu, uint8_t field, uint64_t* value)
+uint64_t Avtp_GetField_Unchecked(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            const uint8_t* pdu, uint8_t field)
 {
-    if (pdu == NULL || value == NULL || field >= numFields || !IsFieldDescriptorValid(&fieldDescriptors[field])) {
-        return -EINVAL;
-    }
+    assert(pdu != NULL);
+    assert(field < numFields);
+    assert(IsFieldDescriptorValid(&fieldDescriptors[field]));
 
     const Avtp_FieldDescriptor_t* fieldDescriptor = &fieldDescriptors[field];
 
-    *value = 0;
+    uint64_t value = 0;
     uint8_t quadletOffset = 0;
     uint8_t processedBits = 0;
     while (processedBits < fieldDescriptor->bits) {
@@ -66,26 +82,36 @@ int Avtp_GetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFie
             quadletShift = 32 - quadletBits;
         }
         uint32_t quadletMask = ((1ULL << quadletBits) - 1ULL) << quadletShift;
-        uint32_t* quadletPtr = (uint32_t*)(pdu + quadletId * 4);
-        uint32_t quadletHostOrder = Avtp_BeToCpu32(*quadletPtr);
+        uint32_t quadletHostOrder = Avtp_LoadBe32(pdu + quadletId * 4);
         uint32_t partialValue = (quadletHostOrder & quadletMask) >> quadletShift;
-        *value |= (uint64_t)(partialValue) << (fieldDescriptor->bits - processedBits - quadletBits);
+        value |= (uint64_t)(partialValue) << (fieldDescriptor->bits - processedBits - quadletBits);
 
         quadletOffset += 1;
         processedBits += quadletBits;
     }
 
-    return 0;
+    return value;
 }
 
-
-int Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields, 
-                            uint8_t* pdu, uint8_t field, uint64_t value)
+int Avtp_GetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            uint8_t* pdu, uint8_t field, uint64_t* value)
 {
-    if (pdu == NULL || field >= numFields || !IsFieldDescriptorValid(&fieldDescriptors[field])) {
+    if (pdu == NULL || value == NULL || field >= numFields || !IsFieldDescriptorValid(&fieldDescriptors[field])) {
         return -EINVAL;
     }
 
+    *value = Avtp_GetField_Unchecked(fieldDescriptors, numFields, pdu, field);
+
+    return 0;
+}
+
+void Avtp_SetField_Unchecked(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            uint8_t* pdu, uint8_t field, uint64_t value)
+{
+    assert(pdu != NULL);
+    assert(field < numFields);
+    assert(IsFieldDescriptorValid(&fieldDescriptors[field]));
+
     const Avtp_FieldDescriptor_t* fieldDescriptor = &fieldDescriptors[field];
 
     uint8_t quadletOffset = 0;
@@ -103,15 +129,168 @@ int Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFie
         }
         uint32_t partialValue = value >> (fieldDescriptor->bits - processedBits - quadletBits);
         uint32_t quadletMask = ((1ULL << quadletBits) - 1ULL) << quadletShift;
-        uint32_t* quadletPtr = (uint32_t*)(pdu + quadletId * 4);
-        uint32_t quadletHostOrder = Avtp_BeToCpu32(*quadletPtr);
+        uint8_t* quadletPtr = pdu + quadletId * 4;
+        uint32_t quadletHostOrder = Avtp_LoadBe32(quadletPtr);
         quadletHostOrder = (quadletHostOrder & ~quadletMask) | ((partialValue << quadletShift) & quadletMask);
-        *quadletPtr = Avtp_CpuToBe32(quadletHostOrder);
+        Avtp_StoreBe32(quadletPtr, quadletHostOrder);
 
         quadletOffset += 1;
         processedBits += quadletBits;
     }
+}
+
+int Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields, 
+                            uint8_t* pdu, uint8_t field, uint64_t value)
+{
+    if (pdu == NULL || field >= numFields || !IsFieldDescriptorValid(&fieldDescriptors[field])) {
+        return -EINVAL;
+    }
+
+    Avtp_SetField_Unchecked(fieldDescriptors, numFields, pdu, field, value);
 
     return 0;
 }
 
+static int AreFieldValuesValid(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            const Avtp_FieldValue_t* fieldValues, uint8_t numValues)
+{
+    if (fieldValues == NULL && numValues > 0) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < numValues; i++) {
+        if (fieldValues[i].field >= numFields
+                || !IsFieldDescriptorValid(&fieldDescriptors[fieldValues[i].field])) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static void ApplyQuadletUpdates(uint8_t* pdu, const QuadletUpdate_t* updates, uint8_t numUpdates)
+{
+    for (uint8_t i = 0; i < numUpdates; i++) {
+        uint8_t* quadletPtr = pdu + updates[i].quadletId * 4;
+        uint32_t quadletHostOrder = Avtp_LoadBe32(quadletPtr);
+        quadletHostOrder = (quadletHostOrder & ~updates[i].mask) | updates[i].value;
+        Avtp_StoreBe32(quadletPtr, quadletHostOrder);
+    }
+}
+
+int Avtp_GetFields(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            uint8_t* pdu, Avtp_FieldValue_t* fieldValues, uint8_t numValues)
+{
+    uint8_t cachedIds[MAX_BATCHED_QUADLETS];
+    uint32_t cachedQuadlets[MAX_BATCHED_QUADLETS];
+    uint8_t numCached = 0;
+
+    if (pdu == NULL || !AreFieldValuesValid(fieldDescriptors, numFields, fieldValues, numValues)) {
+        return -EINVAL;
+    }
+
+    for (uint8_t i = 0; i < numValues; i++) {
+        const Avtp_FieldDescriptor_t* fieldDescriptor = &fieldDescriptors[fieldValues[i].field];
+
+        uint64_t value = 0;
+        uint8_t quadletOffset = 0;
+        uint8_t processedBits = 0;
+        while (processedBits < fieldDescriptor->bits) {
+            uint8_t quadletId = fieldDescriptor->quadlet + quadletOffset;
+            uint8_t quadletBits;
+            uint8_t quadletShift;
+            if (processedBits == 0) {
+                quadletBits = MIN(32 - fieldDescriptor->offset, fieldDescriptor->bits - processedBits);
+                quadletShift = 32 - quadletBits - fieldDescriptor->offset;
+            } else {
+                quadletBits = MIN(32, fieldDescriptor->bits - processedBits);
+                quadletShift = 32 - quadletBits;
+            }
+
+            uint32_t quadletHostOrder;
+            uint8_t j = 0;
+            while (j < numCached && cachedIds[j] != quadletId) {
+                j++;
+            }
+            if (j < numCached) {
+                quadletHostOrder = cachedQuadlets[j];
+            } else {
+                quadletHostOrder = Avtp_LoadBe32(pdu + quadletId * 4);
+                if (numCached < MAX_BATCHED_QUADLETS) {
+                    cachedIds[numCached] = quadletId;
+                    cachedQuadlets[numCached] = quadletHostOrder;
+                    numCached++;
+                }
+            }
+
+            uint32_t quadletMask = ((1ULL << quadletBits) - 1ULL) << quadletShift;
+            uint32_t partialValue = (quadletHostOrder & quadletMask) >> quadletShift;
+            value |= (uint64_t)(partialValue) << (fieldDescriptor->bits - processedBits - quadletBits);
+
+            quadletOffset += 1;
+            processedBits += quadletBits;
+        }
+
+        fieldValues[i].value = value;
+    }
+
+    return 0;
+}
+
+int Avtp_SetFields(const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+                            uint8_t* pdu, const Avtp_FieldValue_t* fieldValues, uint8_t numValues)
+{
+    QuadletUpdate_t updates[MAX_BATCHED_QUADLETS];
+    uint8_t numUpdates = 0;
+
+    if (pdu == NULL || !AreFieldValuesValid(fieldDescriptors, numFields, fieldValues, numValues)) {
+        return -EINVAL;
+    }
+
+    for (uint8_t i = 0; i < numValues; i++) {
+        const Avtp_FieldDescriptor_t* fieldDescriptor = &fieldDescriptors[fieldValues[i].field];
+        uint64_t value = fieldValues[i].value;
+
+        uint8_t quadletOffset = 0;
+        uint8_t processedBits = 0;
+        while (processedBits < fieldDescriptor->bits) {
+            uint8_t quadletId = fieldDescriptor->quadlet + quadletOffset;
+            uint8_t quadletBits;
+            uint8_t quadletShift;
+            if (processedBits == 0) {
+                quadletBits = MIN(32 - fieldDescriptor->offset, fieldDescriptor->bits - processedBits);
+                quadletShift = 32 - quadletBits - fieldDescriptor->offset;
+            } else {
+                quadletBits = MIN(32, fieldDescriptor->bits - processedBits);
+                quadletShift = 32 - quadletBits;
+            }
+            uint32_t partialValue = value >> (fieldDescriptor->bits - processedBits - quadletBits);
+            uint32_t quadletMask = ((1ULL << quadletBits) - 1ULL) << quadletShift;
+
+            uint8_t j = 0;
+            while (j < numUpdates && updates[j].quadletId != quadletId) {
+                j++;
+            }
+            if (j == numUpdates) {
+                if (numUpdates == MAX_BATCHED_QUADLETS) {
+                    ApplyQuadletUpdates(pdu, updates, numUpdates);
+                    numUpdates = 0;
+                    j = 0;
+                }
+                updates[j].quadletId = quadletId;
+                updates[j].mask = 0;
+                updates[j].value = 0;
+                numUpdates++;
+            }
+            updates[j].mask |= quadletMask;
+            updates[j].value = (updates[j].value & ~quadletMask) | ((partialValue << quadletShift) & quadletMask);
+
+            quadletOffset += 1;
+            processedBits += quadletBits;
+        }
+    }
+
+    ApplyQuadletUpdates(pdu, updates, numUpdates);
+
+    return 0;
+}
@@ -35,22 +35,7 @@
 
 static const Avtp_FieldDescriptor_t Avtp_AafCommonStreamFieldDesc[AVTP_AAF_COMMON_STREAM_FIELD_MAX] =
 {
-    [AVTP_AAF_COMMON_STREAM_FIELD_SUBTYPE]                      = { .quadlet = 0, .offset =  0, .bits =  8 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_SV]                           = { .quadlet = 0, .offset =  8, .bits =  1 }, 
-    [AVTP_AAF_COMMON_STREAM_FIELD_VERSION]                      = { .quadlet = 0, .offset =  9, .bits =  3 }, 
-    [AVTP_AAF_COMMON_STREAM_FIELD_MR]                           = { .quadlet = 0, .offset = 12, .bits =  1 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_TV]                           = { .quadlet = 0, .offset = 15, .bits =  1 }, 
-    [AVTP_AAF_COMMON_STREAM_FIELD_SEQUENCE_NUM]                 = { .quadlet = 0, .offset = 16, .bits =  8 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_TU]                           = { .quadlet = 0, .offset = 31, .bits =  1 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_STREAM_ID]                    = { .quadlet = 1, .offset =  0, .bits = 64 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_AVTP_TIMESTAMP]               = { .quadlet = 3, .offset =  0, .bits = 32 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_FORMAT]                       = { .quadlet = 4, .offset =  0, .bits =  8 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_AAF_FORMAT_SPECIFIC_DATA_1]   = { .quadlet = 4, .offset =  8, .bits = 24 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_STREAM_DATA_LENGTH]           = { .quadlet = 5, .offset =  0, .bits = 16 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_AFSD]                         = { .quadlet = 5, .offset = 16, .bits =  3 },
-    [AVTP_AAF_COMMON_STREAM_FIELD_SP]                           = { .quadlet = 5, .offset = 19, .bits =  1 }, 
-    [AVTP_AAF_COMMON_STREAM_FIELD_EVT]                          = { .quadlet = 5, .offset = 20, .bits =  4 }, 
-    [AVTP_AAF_COMMON_STREAM_FIELD_AAF_FORMAT_SPECIFIC_DATA_2]   = { .quadlet = 5, .offset = 24, .bits =  8 },    
+    AVTP_AAF_COMMON_STREAM_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_AafCommonStream, Avtp_AafCommonStream_t)
 };
 
 int Avtp_AafCommonStream_GetField(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field, uint64_t* value)
@@ -61,4 +46,14 @@ int Avtp_AafCommonStream_GetField(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStr
 int Avtp_AafCommonStream_SetField(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field, uint64_t value)
 {
     return Avtp_SetField(Avtp_AafCommonStreamFieldDesc, AVTP_AAF_COMMON_STREAM_FIELD_MAX, (uint8_t*)pdu, (uint8_t) field, value); 
+}
+
+uint64_t Avtp_AafCommonStream_GetField_Unchecked(const Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_AafCommonStreamFieldDesc, AVTP_AAF_COMMON_STREAM_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_AafCommonStream_SetField_Unchecked(Avtp_AafCommonStream_t* pdu, Avtp_AafCommonStreamFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_AafCommonStreamFieldDesc, AVTP_AAF_COMMON_STREAM_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
 }
\ No newline at end of file
@@ -37,40 +37,24 @@
 
 static const Avtp_FieldDescriptor_t Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_MAX] =
 {
-    [AVTP_AAF_PCM_STREAM_FIELD_SUBTYPE] 				= { .quadlet = 0, .offset =  0, .bits =  8 },
-    [AVTP_AAF_PCM_STREAM_FIELD_SV] 						= { .quadlet = 0, .offset =  8, .bits =  1 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_VERSION] 				= { .quadlet = 0, .offset =  9, .bits =  3 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_MR] 						= { .quadlet = 0, .offset = 12, .bits =  1 },	 
-    [AVTP_AAF_PCM_STREAM_FIELD_TV] 						= { .quadlet = 0, .offset = 15, .bits =  1 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_SEQUENCE_NUM] 			= { .quadlet = 0, .offset = 16, .bits =  8 },
-    [AVTP_AAF_PCM_STREAM_FIELD_TU] 						= { .quadlet = 0, .offset = 31, .bits =  1 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_STREAM_ID] 				= { .quadlet = 1, .offset =  0, .bits = 64 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_AVTP_TIMESTAMP] 			= { .quadlet = 3, .offset =  0, .bits = 32 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_FORMAT] 					= { .quadlet = 4, .offset =  0, .bits =  8 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_NSR] 					= { .quadlet = 4, .offset =  8, .bits =  4 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_CHANNELS_PER_FRAME]		= { .quadlet = 4, .offset = 14, .bits = 10 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_BIT_DEPTH] 				= { .quadlet = 4, .offset = 24, .bits =  8 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_STREAM_DATA_LENGTH] 		= { .quadlet = 5, .offset =  0, .bits = 16 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_SP] 						= { .quadlet = 5, .offset = 19, .bits =  1 }, 
-    [AVTP_AAF_PCM_STREAM_FIELD_EVT] 					= { .quadlet = 5, .offset = 20, .bits =  4 }, 
+    AVTP_AAF_PCM_STREAM_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_AafPcmStream, Avtp_AafPcmStream_t)
 };
 
 int Avtp_AafPcmStream_Init(Avtp_AafPcmStream_t* pdu)
 {
-    int res;
+    const Avtp_FieldValue_t initValues[] = {
+        { AVTP_AAF_PCM_STREAM_FIELD_SUBTYPE, AVTP_SUBTYPE_AAF },
+        { AVTP_AAF_PCM_STREAM_FIELD_SV, 1 },
+    };
 
     if (!pdu) {
         return -EINVAL;
     }
 
     memset(pdu, 0, sizeof(Avtp_AafPcmStream_t));
-    res = Avtp_AafPcmStream_SetField(pdu, AVTP_AAF_PCM_STREAM_FIELD_SUBTYPE, AVTP_SUBTYPE_AAF);
-    if (res < 0) return res;
-
-    res = Avtp_AafPcmStream_SetField(pdu, AVTP_AAF_PCM_STREAM_FIELD_SV, 1);
-    if (res < 0) return res;
 
-    return 0;
+    return Avtp_SetFields(Avtp_AafPcmStreamFieldDesc, AVTP_AAF_PCM_STREAM_FIELD_MAX, (uint8_t*)pdu,
+                          initValues, sizeof(initValues) / sizeof(initValues[0]));
 }
 
 int Avtp_AafPcmStream_GetField(Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields_t field, uint64_t* value)
@@ -83,6 +67,96 @@ int Avtp_AafPcmStream_SetField(Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields
     return Avtp_SetField(Avtp_AafPcmStreamFieldDesc, AVTP_AAF_PCM_STREAM_FIELD_MAX, (uint8_t*)pdu, (uint8_t) field, value); 
 }
 
+uint64_t Avtp_AafPcmStream_GetField_Unchecked(const Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_AafPcmStreamFieldDesc, AVTP_AAF_PCM_STREAM_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_AafPcmStream_SetField_Unchecked(Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_AafPcmStreamFieldDesc, AVTP_AAF_PCM_STREAM_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
+
+int Avtp_AafPcmStream_Unpack(const Avtp_AafPcmStream_t* pdu, Avtp_AafPcmStreamHeader_t* header)
+{
+    uint32_t quadlets[AVTP_AAF_PCM_STREAM_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_AAF_PCM_STREAM_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SUBTYPE]);
+    header->sv = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SV]);
+    header->version = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_VERSION]);
+    header->mr = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_MR]);
+    header->tv = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_TV]);
+    header->sequence_num = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SEQUENCE_NUM]);
+    header->tu = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_TU]);
+    header->stream_id = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_STREAM_ID]);
+    header->avtp_timestamp = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_AVTP_TIMESTAMP]);
+    header->format = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_FORMAT]);
+    header->nsr = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_NSR]);
+    header->channels_per_frame = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_CHANNELS_PER_FRAME]);
+    header->bit_depth = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_BIT_DEPTH]);
+    header->stream_data_length = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_STREAM_DATA_LENGTH]);
+    header->sp = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SP]);
+    header->evt = Avtp_ExtractField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_EVT]);
+
+    return 0;
+}
+
+int Avtp_AafPcmStream_Pack(Avtp_AafPcmStream_t* pdu, const Avtp_AafPcmStreamHeader_t* header)
+{
+    uint32_t quadlets[AVTP_AAF_PCM_STREAM_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SUBTYPE], header->subtype);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SV], header->sv);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_VERSION], header->version);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_MR], header->mr);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_TV], header->tv);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SEQUENCE_NUM], header->sequence_num);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_TU], header->tu);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_STREAM_ID], header->stream_id);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_AVTP_TIMESTAMP], header->avtp_timestamp);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_FORMAT], header->format);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_NSR], header->nsr);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_CHANNELS_PER_FRAME], header->channels_per_frame);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_BIT_DEPTH], header->bit_depth);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_STREAM_DATA_LENGTH], header->stream_data_length);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_SP], header->sp);
+    Avtp_InsertField(quadlets, &Avtp_AafPcmStreamFieldDesc[AVTP_AAF_PCM_STREAM_FIELD_EVT], header->evt);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_AAF_PCM_STREAM_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_AafPcmStream_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_AAF_PCM_STREAM_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_AafPcmStream_t* pdu = (const Avtp_AafPcmStream_t*)buf;
+    if (Avtp_AafPcmStream_GetSubtype(pdu) != AVTP_SUBTYPE_AAF) {
+        return -EINVAL;
+    }
+
+    size_t pduLength = AVTP_AAF_PCM_STREAM_HEADER_LEN + Avtp_AafPcmStream_GetStreamDataLength(pdu);
+    if (pduLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = pduLength;
+
+    return 0;
+}
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
@@ -40,20 +40,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_CanFieldDesc[AVTP_CAN_FIELD_MAX] =
 {
-    /* ACF common header fields */
-    [AVTP_CAN_FIELD_ACF_MSG_TYPE]       = { .quadlet = 0, .offset =  0, .bits = 7 },
-    [AVTP_CAN_FIELD_ACF_MSG_LENGTH]     = { .quadlet = 0, .offset =  7, .bits = 9 },  
-    /* ACF CAN header fields */
-    [AVTP_CAN_FIELD_PAD]                = { .quadlet = 0, .offset = 16, .bits =  2 },
-    [AVTP_CAN_FIELD_MTV]                = { .quadlet = 0, .offset = 18, .bits =  1 },
-    [AVTP_CAN_FIELD_RTR]                = { .quadlet = 0, .offset = 19, .bits =  1 },
-    [AVTP_CAN_FIELD_EFF]                = { .quadlet = 0, .offset = 20, .bits =  1 },
-    [AVTP_CAN_FIELD_BRS]                = { .quadlet = 0, .offset = 21, .bits =  1 },
-    [AVTP_CAN_FIELD_FDF]                = { .quadlet = 0, .offset = 22, .bits =  1 },
-    [AVTP_CAN_FIELD_ESI]                = { .quadlet = 0, .offset = 23, .bits =  1 },
-    [AVTP_CAN_FIELD_CAN_BUS_ID]         = { .quadlet = 0, .offset = 27, .bits =  5 },
-    [AVTP_CAN_FIELD_MESSAGE_TIMESTAMP]  = { .quadlet = 1, .offset =  0, .bits = 64 },
-    [AVTP_CAN_FIELD_CAN_IDENTIFIER]     = { .quadlet = 3, .offset =  3, .bits = 29 },    
+    AVTP_CAN_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Can, Avtp_Can_t)
 };
 
 int Avtp_Can_Init(Avtp_Can_t* can_pdu)
@@ -80,28 +67,129 @@ int Avtp_Can_SetField(Avtp_Can_t* can_pdu,
     return Avtp_SetField(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t *) can_pdu, (uint8_t) field, value);
 }
 
+uint64_t Avtp_Can_GetField_Unchecked(const Avtp_Can_t* can_pdu, Avtp_CanFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (const uint8_t*)can_pdu, (uint8_t)field);
+}
+
+void Avtp_Can_SetField_Unchecked(Avtp_Can_t* can_pdu, Avtp_CanFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t*)can_pdu, (uint8_t)field, value);
+}
+
+int Avtp_Can_Unpack(const Avtp_Can_t* can_pdu, Avtp_CanHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (can_pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)can_pdu, quadlets, AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->acf_msg_type = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_ACF_MSG_TYPE]);
+    header->acf_msg_length = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_ACF_MSG_LENGTH]);
+    header->pad = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_PAD]);
+    header->mtv = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_MTV]);
+    header->rtr = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_RTR]);
+    header->eff = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_EFF]);
+    header->brs = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_BRS]);
+    header->fdf = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_FDF]);
+    header->esi = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_ESI]);
+    header->can_bus_id = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_CAN_BUS_ID]);
+    header->message_timestamp = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_MESSAGE_TIMESTAMP]);
+    header->can_identifier = Avtp_ExtractField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_CAN_IDENTIFIER]);
+
+    return 0;
+}
+
+int Avtp_Can_Pack(Avtp_Can_t* can_pdu, const Avtp_CanHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (can_pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_ACF_MSG_TYPE], header->acf_msg_type);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_ACF_MSG_LENGTH], header->acf_msg_length);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_PAD], header->pad);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_MTV], header->mtv);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_RTR], header->rtr);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_EFF], header->eff);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_BRS], header->brs);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_FDF], header->fdf);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_ESI], header->esi);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_CAN_BUS_ID], header->can_bus_id);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_MESSAGE_TIMESTAMP], header->message_timestamp);
+    Avtp_InsertField(quadlets, &Avtp_CanFieldDesc[AVTP_CAN_FIELD_CAN_IDENTIFIER], header->can_identifier);
+    Avtp_StoreQuadlets((uint8_t*)can_pdu, quadlets, AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_Can_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_CAN_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_Can_t* pdu = (const Avtp_Can_t*)buf;
+    if (Avtp_Can_GetAcfMsgType(pdu) != AVTP_ACF_TYPE_CAN) {
+        return -EINVAL;
+    }
+
+    size_t msgLength = Avtp_Can_GetAcfMsgLength(pdu) * AVTP_QUADLET_SIZE;
+    if (msgLength < AVTP_CAN_HEADER_LEN + Avtp_Can_GetPad(pdu) || msgLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = msgLength;
+
+    return 0;
+}
+
+/**
+ * Zeroes the padding bytes behind the payload of an ACF CAN frame.
+ *
+ * @param can_pdu Pointer to the first bit of a 1722 ACF CAN PDU.
+ * @param payload_length Length of the payload in bytes.
+ * @param pad_size Pointer to store the number of padding bytes at.
+ * @returns The length of the ACF CAN frame in quadlets.
+ */
+static uint16_t Avtp_Can_PadPayload(Avtp_Can_t* can_pdu, uint16_t payload_length,
+                                    uint8_t* pad_size)
+{
+    *pad_size = (AVTP_QUADLET_SIZE - (payload_length % AVTP_QUADLET_SIZE)) % AVTP_QUADLET_SIZE;
+    memset(can_pdu->payload + payload_length, 0, *pad_size);
+
+    return (AVTP_CAN_HEADER_LEN + payload_length + *pad_size) / AVTP_QUADLET_SIZE;
+}
+
 int Avtp_Can_SetPayload(Avtp_Can_t* can_pdu, uint32_t frame_id , uint8_t* payload, 
                         uint16_t payload_length, Can_Variant_t can_variant) {
 
     int ret = 0;
-    int eff;
+    uint8_t padSize;
+    uint16_t msgLength;
 
     // Copy the payload into the CAN PDU
     memcpy(can_pdu->payload, payload, payload_length);
-
-    // Set the Frame ID and CAN variant
-    eff = frame_id > 0x7ff? 1 : 0;
-    ret = Avtp_Can_SetField(can_pdu, AVTP_CAN_FIELD_EFF, eff);
-    if (ret) return ret;
-    ret = Avtp_Can_SetField(can_pdu, AVTP_CAN_FIELD_CAN_IDENTIFIER, frame_id);
-    if (ret) return ret;
-    ret = Avtp_Can_SetField(can_pdu, AVTP_CAN_FIELD_FDF, (uint8_t) can_variant);
+    msgLength = Avtp_Can_PadPayload(can_pdu, payload_length, &padSize);
+
+    // Set the Frame ID, CAN variant, length and padding in one pass
+    const Avtp_FieldValue_t fields[] = {
+        { AVTP_CAN_FIELD_ACF_MSG_LENGTH, msgLength },
+        { AVTP_CAN_FIELD_PAD, padSize },
+        { AVTP_CAN_FIELD_EFF, frame_id > 0x7ff ? 1 : 0 },
+        { AVTP_CAN_FIELD_FDF, (uint8_t) can_variant },
+        { AVTP_CAN_FIELD_CAN_IDENTIFIER, frame_id },
+    };
+    ret = Avtp_SetFields(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t *) can_pdu,
+                         fields, sizeof(fields) / sizeof(fields[0]));
     if (ret) return ret;
 
-    // Finalize the AVTP CAN Frame
-    ret = Avtp_Can_Finalize(can_pdu, payload_length);
-
-    return ret;
+    return msgLength * AVTP_QUADLET_SIZE;
 
 }
 
@@ -109,40 +197,37 @@ int Avtp_Can_Finalize(Avtp_Can_t* can_pdu, uint16_t payload_length) {
 
     int ret = 0;
     uint8_t padSize;
-    uint32_t avtpCanLength = AVTP_CAN_HEADER_LEN + payload_length;
+    uint16_t msgLength;
 
-    // Check if padding is required
-    padSize = AVTP_QUADLET_SIZE - (payload_length % AVTP_QUADLET_SIZE);
-    if (payload_length % AVTP_QUADLET_SIZE) {
-        memset(can_pdu->payload + payload_length, 0, padSize);
-        avtpCanLength += padSize;
-    }
+    msgLength = Avtp_Can_PadPayload(can_pdu, payload_length, &padSize);
 
     // Set the length and padding fields
-    ret = Avtp_Can_SetField(can_pdu, AVTP_CAN_FIELD_ACF_MSG_LENGTH, 
-                        (uint64_t) avtpCanLength/AVTP_QUADLET_SIZE);
-    if (ret) return ret;
-    ret = Avtp_Can_SetField(can_pdu, AVTP_CAN_FIELD_PAD, padSize);
+    const Avtp_FieldValue_t fields[] = {
+        { AVTP_CAN_FIELD_ACF_MSG_LENGTH, msgLength },
+        { AVTP_CAN_FIELD_PAD, padSize },
+    };
+    ret = Avtp_SetFields(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t *) can_pdu,
+                         fields, sizeof(fields) / sizeof(fields[0]));
     if (ret) return ret;
 
-    return avtpCanLength;
+    return msgLength * AVTP_QUADLET_SIZE;
 }
 
 uint8_t* Avtp_Can_GetPayload(Avtp_Can_t* can_pdu, uint16_t* payload_length, uint16_t *pdu_length)
 {
-    uint64_t pad_len, pdu_len;
-    int res = Avtp_Can_GetField((Avtp_Can_t*)can_pdu, AVTP_ACF_FIELD_ACF_MSG_LENGTH, 
-                                    &pdu_len);
-    if (res < 0) {    
+    Avtp_FieldValue_t fields[] = {
+        { AVTP_CAN_FIELD_ACF_MSG_LENGTH, 0 },
+        { AVTP_CAN_FIELD_PAD, 0 },
+    };
+    int res = Avtp_GetFields(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t *) can_pdu,
+                             fields, sizeof(fields) / sizeof(fields[0]));
+    if (res < 0) {
         return 0;
     }
 
-    res = Avtp_Can_GetField((Avtp_Can_t*)can_pdu, AVTP_CAN_FIELD_PAD, 
-                                &pad_len);
-    if (res < 0) {        
-        return 0;
-    }
-    
+    uint64_t pdu_len = fields[0].value;
+    uint64_t pad_len = fields[1].value;
+
     if(payload_length != NULL){
         *payload_length = pdu_len*4-AVTP_CAN_HEADER_LEN-pad_len;
     }
@@ -152,4 +237,4 @@ uint8_t* Avtp_Can_GetPayload(Avtp_Can_t* can_pdu, uint16_t* payload_length, uint
     }
 
     return can_pdu->payload;
-}
\ No newline at end of file
+}
@@ -40,19 +40,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_CanBriefFieldDesc[AVTP_CAN_BRIEF_FIELD_MAX] =
 {
-    /* ACF common header fields */
-    [AVTP_CAN_BRIEF_FIELD_ACF_MSG_TYPE]           = { .quadlet = 0, .offset =  0, .bits = 7 },
-    [AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH]         = { .quadlet = 0, .offset =  7, .bits = 9 },  
-    /* ACF Abbreviated CAN header fields */    
-    [AVTP_CAN_BRIEF_FIELD_PAD]                   = { .quadlet = 0, .offset = 16, .bits =  2 },
-    [AVTP_CAN_BRIEF_FIELD_MTV]                   = { .quadlet = 0, .offset = 18, .bits =  1 },
-    [AVTP_CAN_BRIEF_FIELD_RTR]                   = { .quadlet = 0, .offset = 19, .bits =  1 },
-    [AVTP_CAN_BRIEF_FIELD_EFF]                   = { .quadlet = 0, .offset = 20, .bits =  1 },
-    [AVTP_CAN_BRIEF_FIELD_BRS]                   = { .quadlet = 0, .offset = 21, .bits =  1 },
-    [AVTP_CAN_BRIEF_FIELD_FDF]                   = { .quadlet = 0, .offset = 22, .bits =  1 },
-    [AVTP_CAN_BRIEF_FIELD_ESI]                   = { .quadlet = 0, .offset = 23, .bits =  1 },
-    [AVTP_CAN_BRIEF_FIELD_CAN_BUS_ID]            = { .quadlet = 0, .offset = 27, .bits =  5 },    
-    [AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER]        = { .quadlet = 1, .offset =  3, .bits = 29 },    
+    AVTP_CAN_BRIEF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_CanBrief, Avtp_CanBrief_t)
 };
 
 int Avtp_CanBrief_Init(Avtp_CanBrief_t* can_pdu)
@@ -77,50 +65,118 @@ int Avtp_CanBrief_SetField(Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field
     return Avtp_SetField(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t *) can_pdu, (uint8_t) field, value);
 }
 
-int Avtp_CanBrief_SetPayload(Avtp_CanBrief_t* can_pdu, uint32_t frame_id , uint8_t* payload, 
+uint64_t Avtp_CanBrief_GetField_Unchecked(const Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (const uint8_t*)can_pdu, (uint8_t)field);
+}
+
+void Avtp_CanBrief_SetField_Unchecked(Avtp_CanBrief_t* can_pdu, Avtp_CanBriefFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t*)can_pdu, (uint8_t)field, value);
+}
+
+int Avtp_CanBrief_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_CAN_BRIEF_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_CanBrief_t* pdu = (const Avtp_CanBrief_t*)buf;
+    if (Avtp_CanBrief_GetAcfMsgType(pdu) != AVTP_ACF_TYPE_CAN_BRIEF) {
+        return -EINVAL;
+    }
+
+    size_t msgLength = Avtp_CanBrief_GetAcfMsgLength(pdu) * AVTP_QUADLET_SIZE;
+    if (msgLength < AVTP_CAN_BRIEF_HEADER_LEN + Avtp_CanBrief_GetPad(pdu) || msgLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = msgLength;
+
+    return 0;
+}
+
+static uint16_t Avtp_CanBrief_PadPayload(Avtp_CanBrief_t* can_pdu, uint16_t payload_length,
+                                         uint8_t* pad_size)
+{
+    *pad_size = (AVTP_QUADLET_SIZE - (payload_length % AVTP_QUADLET_SIZE)) % AVTP_QUADLET_SIZE;
+    memset(can_pdu->payload + payload_length, 0, *pad_size);
+
+    return (AVTP_CAN_BRIEF_HEADER_LEN + payload_length + *pad_size) / AVTP_QUADLET_SIZE;
+}
+
+int Avtp_CanBrief_SetPayload(Avtp_CanBrief_t* can_pdu, uint32_t frame_id , uint8_t* payload,
                         uint16_t payload_length, Can_Variant_t can_variant) {
 
     int ret = 0;
-    int eff;
+    uint8_t padSize;
+    uint16_t msgLength;
 
     // Copy the payload into the CAN PDU
     memcpy(can_pdu->payload, payload, payload_length);
 
-    // Set the Frame ID and CAN variant
-    eff = frame_id > 0x7ff? 1 : 0;
-    ret = Avtp_CanBrief_SetField(can_pdu, AVTP_CAN_BRIEF_FIELD_EFF, eff);
-    if (ret) return ret;
-    ret = Avtp_CanBrief_SetField(can_pdu, AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER, frame_id);
-    if (ret) return ret;
-    ret = Avtp_CanBrief_SetField(can_pdu, AVTP_CAN_BRIEF_FIELD_FDF, (uint8_t) can_variant);
+    msgLength = Avtp_CanBrief_PadPayload(can_pdu, payload_length, &padSize);
+
+    // Set the Frame ID, CAN variant, length and padding in one pass
+    const Avtp_FieldValue_t fields[] = {
+        { AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, msgLength },
+        { AVTP_CAN_BRIEF_FIELD_PAD, padSize },
+        { AVTP_CAN_BRIEF_FIELD_EFF, frame_id > 0x7ff ? 1 : 0 },
+        { AVTP_CAN_BRIEF_FIELD_FDF, (uint8_t) can_variant },
+        { AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER, frame_id },
+    };
+    ret = Avtp_SetFields(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t *) can_pdu,
+                         fields, sizeof(fields) / sizeof(fields[0]));
     if (ret) return ret;
 
-    // Finalize the AVTP CAN Frame
-    ret = Avtp_CanBrief_Finalize(can_pdu, payload_length);
+    return msgLength * AVTP_QUADLET_SIZE;
+
+}
+
+uint8_t* Avtp_CanBrief_GetPayload(Avtp_CanBrief_t* can_pdu, uint16_t* payload_length,
+                                  uint16_t *pdu_length)
+{
+    Avtp_FieldValue_t fields[] = {
+        { AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, 0 },
+        { AVTP_CAN_BRIEF_FIELD_PAD, 0 },
+    };
+    int res = Avtp_GetFields(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t *) can_pdu,
+                             fields, sizeof(fields) / sizeof(fields[0]));
+    if (res < 0) {
+        return 0;
+    }
 
-    return ret;
+    uint64_t pdu_len = fields[0].value;
+    uint64_t pad_len = fields[1].value;
+
+    if(payload_length != NULL){
+        *payload_length = pdu_len*4-AVTP_CAN_BRIEF_HEADER_LEN-pad_len;
+    }
 
+    if(pdu_length != NULL){
+        *pdu_length = pdu_len;
+    }
+
+    return can_pdu->payload;
 }
 
 int Avtp_CanBrief_Finalize(Avtp_CanBrief_t* can_pdu, uint16_t payload_length) {
 
     int ret = 0;
     uint8_t padSize;
-    uint32_t avtpCanLength = AVTP_CAN_BRIEF_HEADER_LEN + payload_length;
+    uint16_t msgLength;
 
-    // Check if padding is required
-    padSize = AVTP_QUADLET_SIZE - (payload_length % AVTP_QUADLET_SIZE);
-    if (payload_length % AVTP_QUADLET_SIZE) {
-        memset(can_pdu->payload + payload_length, 0, padSize);
-        avtpCanLength += padSize;
-    }
+    msgLength = Avtp_CanBrief_PadPayload(can_pdu, payload_length, &padSize);
 
     // Set the length and padding fields
-    ret = Avtp_CanBrief_SetField(can_pdu, AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, 
-                        (uint64_t) avtpCanLength/AVTP_QUADLET_SIZE);
-    if (ret) return ret;
-    ret = Avtp_CanBrief_SetField(can_pdu, AVTP_CAN_BRIEF_FIELD_PAD, padSize);
+    const Avtp_FieldValue_t fields[] = {
+        { AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, msgLength },
+        { AVTP_CAN_BRIEF_FIELD_PAD, padSize },
+    };
+    ret = Avtp_SetFields(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t *) can_pdu,
+                         fields, sizeof(fields) / sizeof(fields[0]));
     if (ret) return ret;
 
-    return avtpCanLength;
+    return msgLength * AVTP_QUADLET_SIZE;
 }
@@ -39,9 +39,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_AcfCommonFieldDesc[AVTP_ACF_COMMON_FIELD_MAX] =
 {
-    /* ACF common header */
-    [AVTP_ACF_FIELD_ACF_MSG_TYPE]            = { .quadlet = 0, .offset = 0, .bits = 7 },
-    [AVTP_ACF_FIELD_ACF_MSG_LENGTH]          = { .quadlet = 0, .offset = 7, .bits = 9 },
+    AVTP_ACF_COMMON_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_AcfCommon, Avtp_AcfCommon_t)
 };
 
 int Avtp_AcfCommon_GetField(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field, uint64_t* value)
@@ -53,3 +51,32 @@ int Avtp_AcfCommon_SetField(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t fi
 {
     return Avtp_SetField(Avtp_AcfCommonFieldDesc, AVTP_ACF_COMMON_FIELD_MAX, (uint8_t*)acf_pdu, (uint8_t)field, value);        
 }
+
+uint64_t Avtp_AcfCommon_GetField_Unchecked(const Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_AcfCommonFieldDesc, AVTP_ACF_COMMON_FIELD_MAX, (const uint8_t*)acf_pdu, (uint8_t)field);
+}
+
+void Avtp_AcfCommon_SetField_Unchecked(Avtp_AcfCommon_t* acf_pdu, Avtp_AcfCommonFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_AcfCommonFieldDesc, AVTP_ACF_COMMON_FIELD_MAX, (uint8_t*)acf_pdu, (uint8_t)field, value);
+}
+
+int Avtp_AcfCommon_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_ACF_COMMON_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_AcfCommon_t* pdu = (const Avtp_AcfCommon_t*)buf;
+
+    size_t msgLength = Avtp_AcfCommon_GetAcfMsgLength(pdu) * AVTP_QUADLET_SIZE;
+    if (msgLength < AVTP_ACF_COMMON_HEADER_LEN || msgLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = msgLength;
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+
+#include "avtp/acf/Iterator.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/PduView.h"
+
+int Avtp_AcfIter_Init(Avtp_AcfIter_t* iter, const uint8_t* cf_pdu, size_t len)
+{
+    Avtp_PduView_t view;
+    size_t headerLen;
+    int res;
+
+    if (iter == NULL || cf_pdu == NULL || len < AVTP_COMMON_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    switch (cf_pdu[0]) {
+    case AVTP_SUBTYPE_NTSCF:
+        res = Avtp_Ntscf_InitView(&view, cf_pdu, len);
+        headerLen = AVTP_NTSCF_HEADER_LEN;
+        break;
+    case AVTP_SUBTYPE_TSCF:
+        res = Avtp_Tscf_InitView(&view, cf_pdu, len);
+        headerLen = AVTP_TSCF_HEADER_LEN;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    if (res < 0) {
+        return res;
+    }
+
+    iter->pos = view.base + headerLen;
+    iter->end = view.base + view.len;
+
+    return 0;
+}
+
+int Avtp_AcfIter_InitMessages(Avtp_AcfIter_t* iter, const uint8_t* msgs, size_t len)
+{
+    if (iter == NULL || (msgs == NULL && len > 0)) {
+        return -EINVAL;
+    }
+
+    iter->pos = msgs;
+    iter->end = msgs + len;
+
+    return 0;
+}
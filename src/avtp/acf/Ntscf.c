@@ -39,15 +39,8 @@
  * This table maps all IEEE 1722 NTSCF-specific header fields to a descriptor.
  */
 static const Avtp_FieldDescriptor_t Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_MAX] =
-{    
-    /* Common AVTP header */
-    [AVTP_NTSCF_FIELD_SUBTYPE]              = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_NTSCF_FIELD_SV]                   = { .quadlet = 0, .offset = 8, .bits = 1 },
-    [AVTP_NTSCF_FIELD_VERSION]              = { .quadlet = 0, .offset = 9, .bits = 3 },
-    /* NTSCF header */    
-    [AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH]    = { .quadlet = 0, .offset = 13, .bits = 11 },
-    [AVTP_NTSCF_FIELD_SEQUENCE_NUM]         = { .quadlet = 0, .offset = 24, .bits = 8 },
-    [AVTP_NTSCF_FIELD_STREAM_ID]            = { .quadlet = 1, .offset = 0, .bits = 64 },
+{
+    AVTP_NTSCF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Ntscf, Avtp_Ntscf_t)
 };
 
 int Avtp_Ntscf_Init(Avtp_Ntscf_t* pdu)
@@ -56,11 +49,15 @@ int Avtp_Ntscf_Init(Avtp_Ntscf_t* pdu)
         return -EINVAL;
     }
 
+    const Avtp_FieldValue_t initValues[] = {
+        { AVTP_NTSCF_FIELD_SUBTYPE, AVTP_SUBTYPE_NTSCF },
+        { AVTP_NTSCF_FIELD_SV, 1 },
+    };
+
     memset(pdu, 0, sizeof(Avtp_Ntscf_t));
-    Avtp_Ntscf_SetField(pdu, AVTP_NTSCF_FIELD_SUBTYPE, AVTP_SUBTYPE_NTSCF);
-    Avtp_Ntscf_SetField(pdu, AVTP_NTSCF_FIELD_SV, 1);
 
-    return 0;
+    return Avtp_SetFields(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu,
+                          initValues, sizeof(initValues) / sizeof(initValues[0]));
 }
 
 int Avtp_Ntscf_GetField(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t* value)
@@ -72,3 +69,73 @@ int Avtp_Ntscf_SetField(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t va
 {
     return Avtp_SetField(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu, (uint8_t) field, value); 
 }
+
+uint64_t Avtp_Ntscf_GetField_Unchecked(const Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Ntscf_SetField_Unchecked(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
+
+int Avtp_Ntscf_Unpack(const Avtp_Ntscf_t* pdu, Avtp_NtscfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = Avtp_ExtractField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SUBTYPE]);
+    header->sv = Avtp_ExtractField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SV]);
+    header->version = Avtp_ExtractField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_VERSION]);
+    header->ntscf_data_length = Avtp_ExtractField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH]);
+    header->sequence_num = Avtp_ExtractField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SEQUENCE_NUM]);
+    header->stream_id = Avtp_ExtractField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_STREAM_ID]);
+
+    return 0;
+}
+
+int Avtp_Ntscf_Pack(Avtp_Ntscf_t* pdu, const Avtp_NtscfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SUBTYPE], header->subtype);
+    Avtp_InsertField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SV], header->sv);
+    Avtp_InsertField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_VERSION], header->version);
+    Avtp_InsertField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH], header->ntscf_data_length);
+    Avtp_InsertField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SEQUENCE_NUM], header->sequence_num);
+    Avtp_InsertField(quadlets, &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_STREAM_ID], header->stream_id);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_Ntscf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_NTSCF_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_Ntscf_t* pdu = (const Avtp_Ntscf_t*)buf;
+    if (Avtp_Ntscf_GetSubtype(pdu) != AVTP_SUBTYPE_NTSCF) {
+        return -EINVAL;
+    }
+
+    size_t pduLength = AVTP_NTSCF_HEADER_LEN + Avtp_Ntscf_GetNtscfDataLength(pdu);
+    if (pduLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = pduLength;
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stddef.h>
+
+#include "avtp/acf/Packer.h"
+#include "avtp/acf/Common.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/CommonHeader.h"
+
+/* Largest values of the NTSCF (11 bit) and TSCF (16 bit) data length fields */
+#define NTSCF_MAX_DATA_LEN      0x7FF
+#define TSCF_MAX_DATA_LEN       0xFFFF
+
+int Avtp_AcfPacker_Init(Avtp_AcfPacker_t* packer, uint8_t* cf_pdu, uint16_t maxLen,
+                            uint16_t maxMsgs, uint64_t latency)
+{
+    uint32_t maxDataLen;
+
+    if (packer == NULL || cf_pdu == NULL) {
+        return -EINVAL;
+    }
+
+    switch (cf_pdu[0]) {
+    case AVTP_SUBTYPE_NTSCF:
+        packer->headerLen = AVTP_NTSCF_HEADER_LEN;
+        maxDataLen = NTSCF_MAX_DATA_LEN;
+        break;
+    case AVTP_SUBTYPE_TSCF:
+        packer->headerLen = AVTP_TSCF_HEADER_LEN;
+        maxDataLen = TSCF_MAX_DATA_LEN;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    if (maxLen < packer->headerLen + AVTP_ACF_COMMON_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    if (maxLen > packer->headerLen + maxDataLen) {
+        maxLen = packer->headerLen + maxDataLen;
+    }
+
+    packer->cf_pdu = cf_pdu;
+    packer->maxLen = maxLen;
+    packer->maxMsgs = maxMsgs;
+    packer->latency = latency;
+    Avtp_AcfPacker_Reset(packer);
+
+    return 0;
+}
+
+uint8_t* Avtp_AcfPacker_Reserve(Avtp_AcfPacker_t* packer, uint16_t maxMsgLen)
+{
+    if ((uint32_t)packer->len + maxMsgLen > packer->maxLen) {
+        return NULL;
+    }
+
+    return packer->cf_pdu + packer->len;
+}
+
+int Avtp_AcfPacker_Commit(Avtp_AcfPacker_t* packer, uint16_t msgLen, uint64_t now)
+{
+    if (msgLen < AVTP_ACF_COMMON_HEADER_LEN || msgLen % AVTP_QUADLET_SIZE != 0
+            || (uint32_t)packer->len + msgLen > packer->maxLen) {
+        return -EINVAL;
+    }
+
+    if (packer->numMsgs == 0 && packer->latency != 0) {
+        packer->deadline = now + packer->latency;
+    }
+
+    packer->len += msgLen;
+    packer->numMsgs++;
+
+    if (packer->maxMsgs != 0 && packer->numMsgs >= packer->maxMsgs) {
+        return 1;
+    }
+
+    if (packer->len + AVTP_ACF_COMMON_HEADER_LEN > packer->maxLen) {
+        return 1;
+    }
+
+    return 0;
+}
+
+int Avtp_AcfPacker_IsDue(const Avtp_AcfPacker_t* packer, uint64_t now)
+{
+    return packer->numMsgs > 0 && packer->latency != 0 && now >= packer->deadline;
+}
+
+uint64_t Avtp_AcfPacker_GetDeadline(const Avtp_AcfPacker_t* packer)
+{
+    if (packer->numMsgs == 0 || packer->latency == 0) {
+        return AVTP_ACF_PACKER_NO_DEADLINE;
+    }
+
+    return packer->deadline;
+}
+
+uint16_t Avtp_AcfPacker_GetNumMsgs(const Avtp_AcfPacker_t* packer)
+{
+    return packer->numMsgs;
+}
+
+uint16_t Avtp_AcfPacker_Finalize(Avtp_AcfPacker_t* packer)
+{
+    uint16_t dataLen = packer->len - packer->headerLen;
+
+    if (packer->numMsgs == 0) {
+        return 0;
+    }
+
+    if (packer->headerLen == AVTP_NTSCF_HEADER_LEN) {
+        Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)packer->cf_pdu, dataLen);
+    } else {
+        Avtp_Tscf_SetStreamDataLength((Avtp_Tscf_t*)packer->cf_pdu, dataLen);
+    }
+
+    return packer->len;
+}
+
+void Avtp_AcfPacker_Reset(Avtp_AcfPacker_t* packer)
+{
+    packer->len = packer->headerLen;
+    packer->numMsgs = 0;
+    packer->deadline = AVTP_ACF_PACKER_NO_DEADLINE;
+}
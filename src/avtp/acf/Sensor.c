@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <string.h>
 
+#include "avtp/Byteorder.h"
 #include "avtp/acf/Common.h"
 #include "avtp/acf/Sensor.h"
 #include "avtp/Utils.h" 
@@ -40,15 +41,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_SensorFieldDesc[AVTP_SENSOR_FIELD_MAX] =
 {
-    /* ACF common header fields */
-    [AVTP_SENSOR_FIELD_ACF_MSG_TYPE]        = { .quadlet = 0, .offset =  0, .bits = 7 },
-    [AVTP_SENSOR_FIELD_ACF_MSG_LENGTH]      = { .quadlet = 0, .offset =  7, .bits = 9 },  
-    /* ACF Sensor header fields */   
-    [AVTP_SENSOR_FIELD_MTV]                 = { .quadlet = 0, .offset = 16, .bits = 1 },
-    [AVTP_SENSOR_FIELD_NUM_SENSOR]          = { .quadlet = 0, .offset = 17, .bits = 7 },
-    [AVTP_SENSOR_FIELD_SZ]                  = { .quadlet = 0, .offset = 24, .bits = 2 },
-    [AVTP_SENSOR_FIELD_SENSOR_GROUP]        = { .quadlet = 0, .offset = 26, .bits = 6 },
-    [AVTP_SENSOR_FIELD_MESSAGE_TIMESTAMP]   = { .quadlet = 1, .offset =  0, .bits = 64 },    
+    AVTP_SENSOR_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Sensor, Avtp_Sensor_t)
 };
 
 
@@ -73,3 +66,110 @@ int Avtp_Sensor_SetField(Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field, u
 {    
     return Avtp_SetField(Avtp_SensorFieldDesc, AVTP_SENSOR_FIELD_MAX, (uint8_t *) sensor_pdu, (uint8_t) field, value);        
 }
+
+uint64_t Avtp_Sensor_GetField_Unchecked(const Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_SensorFieldDesc, AVTP_SENSOR_FIELD_MAX, (const uint8_t*)sensor_pdu, (uint8_t)field);
+}
+
+void Avtp_Sensor_SetField_Unchecked(Avtp_Sensor_t* sensor_pdu, Avtp_SensorFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_SensorFieldDesc, AVTP_SENSOR_FIELD_MAX, (uint8_t*)sensor_pdu, (uint8_t)field, value);
+}
+
+size_t Avtp_Sensor_EncodeSamples(uint8_t* payload, const void* samples,
+                                 uint8_t num_samples, Avtp_SensorSz_t sz)
+{
+    size_t len = num_samples * Avtp_Sensor_GetSampleSize(sz);
+    size_t padded_len = (len + AVTP_QUADLET_SIZE - 1) & ~(size_t)(AVTP_QUADLET_SIZE - 1);
+
+    switch (sz) {
+    case AVTP_SENSOR_SZ_64BIT:
+        Avtp_CpuToBeArray64(payload, samples, num_samples);
+        break;
+    case AVTP_SENSOR_SZ_32BIT:
+        Avtp_CpuToBeArray32(payload, samples, num_samples);
+        break;
+    case AVTP_SENSOR_SZ_16BIT:
+        Avtp_CpuToBeArray16(payload, samples, num_samples);
+        break;
+    default:
+        memcpy(payload, samples, len);
+        break;
+    }
+    memset(payload + len, 0, padded_len - len);
+
+    return padded_len;
+}
+
+void Avtp_Sensor_DecodeSamples(void* samples, const uint8_t* payload,
+                               uint8_t num_samples, Avtp_SensorSz_t sz)
+{
+    switch (sz) {
+    case AVTP_SENSOR_SZ_64BIT:
+        Avtp_BeToCpuArray64(samples, payload, num_samples);
+        break;
+    case AVTP_SENSOR_SZ_32BIT:
+        Avtp_BeToCpuArray32(samples, payload, num_samples);
+        break;
+    case AVTP_SENSOR_SZ_16BIT:
+        Avtp_BeToCpuArray16(samples, payload, num_samples);
+        break;
+    default:
+        memcpy(samples, payload, num_samples * Avtp_Sensor_GetSampleSize(sz));
+        break;
+    }
+}
+
+int Avtp_Sensor_PackSamples(Avtp_Sensor_t* sensor_pdu, const void* samples,
+                            uint8_t num_samples, Avtp_SensorSz_t sz)
+{
+    if (sensor_pdu == NULL || (samples == NULL && num_samples > 0) ||
+            num_samples > AVTP_SENSOR_MAX_SAMPLES || (unsigned)sz > AVTP_SENSOR_SZ_8BIT) {
+        return -EINVAL;
+    }
+
+    size_t len = AVTP_SENSOR_HEADER_LEN +
+                 Avtp_Sensor_EncodeSamples(sensor_pdu->payload, samples, num_samples, sz);
+
+    const Avtp_FieldValue_t fields[] = {
+        { AVTP_SENSOR_FIELD_ACF_MSG_LENGTH, len / AVTP_QUADLET_SIZE },
+        { AVTP_SENSOR_FIELD_NUM_SENSOR, num_samples },
+        { AVTP_SENSOR_FIELD_SZ, sz },
+    };
+    int ret = Avtp_SetFields(Avtp_SensorFieldDesc, AVTP_SENSOR_FIELD_MAX, (uint8_t*)sensor_pdu,
+                             fields, sizeof(fields) / sizeof(fields[0]));
+    if (ret) return ret;
+
+    return len;
+}
+
+int Avtp_Sensor_UnpackSamples(const Avtp_Sensor_t* sensor_pdu, void* samples,
+                              uint8_t max_samples)
+{
+    if (sensor_pdu == NULL || samples == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_FieldValue_t fields[] = {
+        { AVTP_SENSOR_FIELD_ACF_MSG_LENGTH, 0 },
+        { AVTP_SENSOR_FIELD_NUM_SENSOR, 0 },
+        { AVTP_SENSOR_FIELD_SZ, 0 },
+    };
+    int ret = Avtp_GetFields(Avtp_SensorFieldDesc, AVTP_SENSOR_FIELD_MAX, (uint8_t*)sensor_pdu,
+                             fields, sizeof(fields) / sizeof(fields[0]));
+    if (ret) return ret;
+
+    size_t msg_len = fields[0].value * AVTP_QUADLET_SIZE;
+    uint8_t num_samples = fields[1].value;
+    Avtp_SensorSz_t sz = (Avtp_SensorSz_t)fields[2].value;
+    size_t len = num_samples * Avtp_Sensor_GetSampleSize(sz);
+
+    if (num_samples > max_samples || msg_len < AVTP_SENSOR_HEADER_LEN + len) {
+        return -EINVAL;
+    }
+
+    Avtp_Sensor_DecodeSamples(samples, sensor_pdu->payload, num_samples, sz);
+
+    return num_samples;
+}
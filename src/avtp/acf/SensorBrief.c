@@ -38,18 +38,9 @@
 /**
  * This table maps all IEEE 1722 ACF Abbreviated Sensor header fields to a descriptor.
  */
-static const Avtp_FieldDescriptor_t Avtp_SensorBriefFieldDesc[AVTP_SENSOR_FIELD_MAX] =
+static const Avtp_FieldDescriptor_t Avtp_SensorBriefFieldDesc[AVTP_SENSOR_BRIEF_FIELD_MAX] =
 {
-
-    /* ACF common header fields */
-    [AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_TYPE]      = { .quadlet = 0, .offset = 0, .bits = 7 },
-    [AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_LENGTH]    = { .quadlet = 0, .offset = 7, .bits = 9 },  
-
-    /* ACF Abbreviated Sensor header fields */   
-    [AVTP_SENSOR_BRIEF_FIELD_MTV]               = { .quadlet = 0, .offset = 16, .bits = 1 },
-    [AVTP_SENSOR_BRIEF_FIELD_NUM_SENSOR]        = { .quadlet = 0, .offset = 17, .bits = 7 },
-    [AVTP_SENSOR_BRIEF_FIELD_SZ]                = { .quadlet = 0, .offset = 24, .bits = 2 },
-    [AVTP_SENSOR_BRIEF_FIELD_SENSOR_GROUP]      = { .quadlet = 0, .offset = 26, .bits = 6 },    
+    AVTP_SENSOR_BRIEF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_SensorBrief, Avtp_SensorBrief_t)
 };
 
 int Avtp_SensorBrief_Init(Avtp_SensorBrief_t* sensor_pdu)
@@ -66,10 +57,73 @@ int Avtp_SensorBrief_Init(Avtp_SensorBrief_t* sensor_pdu)
 
 int Avtp_SensorBrief_GetField(Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field, uint64_t* value)
 {    
-    return Avtp_GetField(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_FIELD_MAX, (uint8_t *) sensor_pdu, (uint8_t) field, value);        
+    return Avtp_GetField(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_BRIEF_FIELD_MAX, (uint8_t *) sensor_pdu, (uint8_t) field, value);        
 }
 
 int Avtp_SensorBrief_SetField(Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field, uint64_t value)
 {    
-    return Avtp_SetField(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_FIELD_MAX, (uint8_t *) sensor_pdu, (uint8_t) field, value);        
+    return Avtp_SetField(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_BRIEF_FIELD_MAX, (uint8_t *) sensor_pdu, (uint8_t) field, value);        
+}
+
+uint64_t Avtp_SensorBrief_GetField_Unchecked(const Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_BRIEF_FIELD_MAX, (const uint8_t*)sensor_pdu, (uint8_t)field);
+}
+
+void Avtp_SensorBrief_SetField_Unchecked(Avtp_SensorBrief_t* sensor_pdu, Avtp_SensorBriefFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_BRIEF_FIELD_MAX, (uint8_t*)sensor_pdu, (uint8_t)field, value);
+}
+
+int Avtp_SensorBrief_PackSamples(Avtp_SensorBrief_t* sensor_pdu, const void* samples,
+                                 uint8_t num_samples, Avtp_SensorSz_t sz)
+{
+    if (sensor_pdu == NULL || (samples == NULL && num_samples > 0) ||
+            num_samples > AVTP_SENSOR_MAX_SAMPLES || (unsigned)sz > AVTP_SENSOR_SZ_8BIT) {
+        return -EINVAL;
+    }
+
+    size_t len = AVTP_SENSOR_BRIEF_HEADER_LEN +
+                 Avtp_Sensor_EncodeSamples(sensor_pdu->payload, samples, num_samples, sz);
+
+    const Avtp_FieldValue_t fields[] = {
+        { AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_LENGTH, len / AVTP_QUADLET_SIZE },
+        { AVTP_SENSOR_BRIEF_FIELD_NUM_SENSOR, num_samples },
+        { AVTP_SENSOR_BRIEF_FIELD_SZ, sz },
+    };
+    int ret = Avtp_SetFields(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_BRIEF_FIELD_MAX,
+                             (uint8_t*)sensor_pdu, fields, sizeof(fields) / sizeof(fields[0]));
+    if (ret) return ret;
+
+    return len;
+}
+
+int Avtp_SensorBrief_UnpackSamples(const Avtp_SensorBrief_t* sensor_pdu, void* samples,
+                                   uint8_t max_samples)
+{
+    if (sensor_pdu == NULL || samples == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_FieldValue_t fields[] = {
+        { AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_LENGTH, 0 },
+        { AVTP_SENSOR_BRIEF_FIELD_NUM_SENSOR, 0 },
+        { AVTP_SENSOR_BRIEF_FIELD_SZ, 0 },
+    };
+    int ret = Avtp_GetFields(Avtp_SensorBriefFieldDesc, AVTP_SENSOR_BRIEF_FIELD_MAX,
+                             (uint8_t*)sensor_pdu, fields, sizeof(fields) / sizeof(fields[0]));
+    if (ret) return ret;
+
+    size_t msg_len = fields[0].value * AVTP_QUADLET_SIZE;
+    uint8_t num_samples = fields[1].value;
+    Avtp_SensorSz_t sz = (Avtp_SensorSz_t)fields[2].value;
+    size_t len = num_samples * Avtp_Sensor_GetSampleSize(sz);
+
+    if (num_samples > max_samples || msg_len < AVTP_SENSOR_BRIEF_HEADER_LEN + len) {
+        return -EINVAL;
+    }
+
+    Avtp_Sensor_DecodeSamples(samples, sensor_pdu->payload, num_samples, sz);
+
+    return num_samples;
 }
@@ -39,18 +39,7 @@
  */
 static const Avtp_FieldDescriptor_t Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_MAX] =
 {
-    /* Common AVTP header */
-    [AVTP_TSCF_FIELD_SUBTYPE]                  = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_TSCF_FIELD_SV]                       = { .quadlet = 0, .offset = 8, .bits = 1 },
-    [AVTP_TSCF_FIELD_VERSION]                  = { .quadlet = 0, .offset = 9, .bits = 3 },
-    /* TSCF header*/    
-    [AVTP_TSCF_FIELD_MR]                       = { .quadlet = 0, .offset = 12, .bits = 1 },
-    [AVTP_TSCF_FIELD_TV]                       = { .quadlet = 0, .offset = 15, .bits = 1 },
-    [AVTP_TSCF_FIELD_SEQUENCE_NUM]             = { .quadlet = 0, .offset = 16, .bits = 8 },
-    [AVTP_TSCF_FIELD_TU]                       = { .quadlet = 0, .offset = 31, .bits = 1 },
-    [AVTP_TSCF_FIELD_STREAM_ID]                = { .quadlet = 1, .offset = 0, .bits = 64 },
-    [AVTP_TSCF_FIELD_AVTP_TIMESTAMP]           = { .quadlet = 3, .offset = 0, .bits = 32 },
-    [AVTP_TSCF_FIELD_STREAM_DATA_LENGTH]       = { .quadlet = 5, .offset = 0, .bits = 16 },
+    AVTP_TSCF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Tscf, Avtp_Tscf_t)
 };
 
 int Avtp_Tscf_Init(Avtp_Tscf_t* pdu)
@@ -59,11 +48,15 @@ int Avtp_Tscf_Init(Avtp_Tscf_t* pdu)
         return -EINVAL;
     }
 
+    const Avtp_FieldValue_t initValues[] = {
+        { AVTP_TSCF_FIELD_SUBTYPE, AVTP_SUBTYPE_TSCF },
+        { AVTP_TSCF_FIELD_SV, 1 },
+    };
+
     memset(pdu, 0, sizeof(Avtp_Tscf_t));
-    Avtp_Tscf_SetField(pdu, AVTP_TSCF_FIELD_SUBTYPE, AVTP_SUBTYPE_TSCF);
-    Avtp_Tscf_SetField(pdu, AVTP_TSCF_FIELD_SV, 1);
 
-    return 0;
+    return Avtp_SetFields(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*)pdu,
+                          initValues, sizeof(initValues) / sizeof(initValues[0]));
 }
 
 int Avtp_Tscf_GetField(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t* value)
@@ -75,3 +68,81 @@ int Avtp_Tscf_SetField(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t value
 {
     return Avtp_SetField(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*) pdu, (uint8_t) field, value); 
 }
+
+uint64_t Avtp_Tscf_GetField_Unchecked(const Avtp_Tscf_t* pdu, Avtp_TscfFields_t field)
+{
+    return Avtp_GetField_Unchecked(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Tscf_SetField_Unchecked(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
+
+int Avtp_Tscf_Unpack(const Avtp_Tscf_t* pdu, Avtp_TscfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SUBTYPE]);
+    header->sv = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SV]);
+    header->version = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_VERSION]);
+    header->mr = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_MR]);
+    header->tv = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_TV]);
+    header->sequence_num = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SEQUENCE_NUM]);
+    header->tu = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_TU]);
+    header->stream_id = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_STREAM_ID]);
+    header->avtp_timestamp = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_AVTP_TIMESTAMP]);
+    header->stream_data_length = Avtp_ExtractField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_STREAM_DATA_LENGTH]);
+
+    return 0;
+}
+
+int Avtp_Tscf_Pack(Avtp_Tscf_t* pdu, const Avtp_TscfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SUBTYPE], header->subtype);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SV], header->sv);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_VERSION], header->version);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_MR], header->mr);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_TV], header->tv);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SEQUENCE_NUM], header->sequence_num);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_TU], header->tu);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_STREAM_ID], header->stream_id);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_AVTP_TIMESTAMP], header->avtp_timestamp);
+    Avtp_InsertField(quadlets, &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_STREAM_DATA_LENGTH], header->stream_data_length);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_Tscf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_TSCF_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_Tscf_t* pdu = (const Avtp_Tscf_t*)buf;
+    if (Avtp_Tscf_GetSubtype(pdu) != AVTP_SUBTYPE_TSCF) {
+        return -EINVAL;
+    }
+
+    size_t pduLength = AVTP_TSCF_HEADER_LEN + Avtp_Tscf_GetStreamDataLength(pdu);
+    if (pduLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = pduLength;
+
+    return 0;
+}
@@ -36,26 +36,7 @@
 
 static const Avtp_FieldDescriptor_t fieldDescriptors[AVTP_CVF_FIELD_MAX] =
 {
-    [AVTP_CVF_FIELD_SUBTYPE]            = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_CVF_FIELD_SV]                 = { .quadlet = 0, .offset = 8, .bits = 1 },
-    [AVTP_CVF_FIELD_VERSION]            = { .quadlet = 0, .offset = 9, .bits = 3 },
-    [AVTP_CVF_FIELD_MR]                 = { .quadlet = 0, .offset = 12, .bits = 1 },
-    [AVTP_CVF_FIELD_RESERVED]           = { .quadlet = 0, .offset = 13, .bits = 2 },
-    [AVTP_CVF_FIELD_TV]                 = { .quadlet = 0, .offset = 15, .bits = 1 },
-    [AVTP_CVF_FIELD_SEQUENCE_NUM]       = { .quadlet = 0, .offset = 16, .bits = 8 },
-    [AVTP_CVF_FIELD_RESERVED_2]         = { .quadlet = 0, .offset = 24, .bits = 7 },
-    [AVTP_CVF_FIELD_TU]                 = { .quadlet = 0, .offset = 31, .bits = 1 },
-    [AVTP_CVF_FIELD_STREAM_ID]          = { .quadlet = 1, .offset = 0, .bits = 64 },
-    [AVTP_CVF_FIELD_AVTP_TIMESTAMP]     = { .quadlet = 3, .offset = 0, .bits = 32 },
-    [AVTP_CVF_FIELD_FORMAT]             = { .quadlet = 4, .offset = 0, .bits = 8 },
-    [AVTP_CVF_FIELD_FORMAT_SUBTYPE]     = { .quadlet = 4, .offset = 8, .bits = 8 },
-    [AVTP_CVF_FIELD_RESERVED_3]         = { .quadlet = 4, .offset = 16, .bits = 16 },
-    [AVTP_CVF_FIELD_STREAM_DATA_LENGTH] = { .quadlet = 5, .offset = 0, .bits = 16 },
-    [AVTP_CVF_FIELD_RESERVED_4]         = { .quadlet = 5, .offset = 16, .bits = 2 },
-    [AVTP_CVF_FIELD_PTV]                = { .quadlet = 5, .offset = 18, .bits = 1 },
-    [AVTP_CVF_FIELD_M]                  = { .quadlet = 5, .offset = 19, .bits = 1 },
-    [AVTP_CVF_FIELD_EVT]                = { .quadlet = 5, .offset = 20, .bits = 4 },
-    [AVTP_CVF_FIELD_RESERVED_5]         = { .quadlet = 5, .offset = 24, .bits = 8 },
+    AVTP_CVF_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Cvf, Avtp_Cvf_t)
 };
 
 int Avtp_Cvf_Init(Avtp_Cvf_t* pdu)
@@ -63,14 +44,13 @@ int Avtp_Cvf_Init(Avtp_Cvf_t* pdu)
     if (pdu == NULL) return -EINVAL;
 
     memset(pdu, 0, sizeof(Avtp_Cvf_t));
-    
-    int ret;
-    ret = Avtp_Cvf_SetField(pdu, AVTP_CVF_FIELD_SUBTYPE, AVTP_SUBTYPE_CVF);
-    if (ret != 0) return ret;
-    ret = Avtp_Cvf_SetField(pdu, AVTP_CVF_FIELD_SV, 1);
-    if (ret != 0) return ret;
-    
-    return 0;
+
+    const Avtp_FieldValue_t initValues[] = {
+        { AVTP_CVF_FIELD_SUBTYPE, AVTP_SUBTYPE_CVF },
+        { AVTP_CVF_FIELD_SV, 1 },
+    };
+    return Avtp_SetFields(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu,
+                          initValues, sizeof(initValues) / sizeof(initValues[0]));
 }
 
 int Avtp_Cvf_GetField(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t* value)
@@ -83,6 +63,94 @@ int Avtp_Cvf_SetField(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t value)
     return Avtp_SetField(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu, field, value);
 }
 
+uint64_t Avtp_Cvf_GetField_Unchecked(const Avtp_Cvf_t* pdu, Avtp_CvfField_t field)
+{
+    return Avtp_GetField_Unchecked(fieldDescriptors, AVTP_CVF_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Cvf_SetField_Unchecked(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
+
+int Avtp_Cvf_Unpack(const Avtp_Cvf_t* pdu, Avtp_CvfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CVF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_CVF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_SUBTYPE]);
+    header->sv = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_SV]);
+    header->version = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_VERSION]);
+    header->mr = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_MR]);
+    header->tv = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_TV]);
+    header->sequence_num = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_SEQUENCE_NUM]);
+    header->tu = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_TU]);
+    header->stream_id = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_STREAM_ID]);
+    header->avtp_timestamp = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_AVTP_TIMESTAMP]);
+    header->format = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_FORMAT]);
+    header->format_subtype = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_FORMAT_SUBTYPE]);
+    header->stream_data_length = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_STREAM_DATA_LENGTH]);
+    header->ptv = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_PTV]);
+    header->m = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_M]);
+    header->evt = Avtp_ExtractField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_EVT]);
+
+    return 0;
+}
+
+int Avtp_Cvf_Pack(Avtp_Cvf_t* pdu, const Avtp_CvfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CVF_HEADER_LEN / AVTP_QUADLET_SIZE] = { 0 };
+
+    if (pdu == NULL || header == NULL) {
+        return -EINVAL;
+    }
+
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_SUBTYPE], header->subtype);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_SV], header->sv);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_VERSION], header->version);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_MR], header->mr);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_TV], header->tv);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_SEQUENCE_NUM], header->sequence_num);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_TU], header->tu);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_STREAM_ID], header->stream_id);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_AVTP_TIMESTAMP], header->avtp_timestamp);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_FORMAT], header->format);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_FORMAT_SUBTYPE], header->format_subtype);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_STREAM_DATA_LENGTH], header->stream_data_length);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_PTV], header->ptv);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_M], header->m);
+    Avtp_InsertField(quadlets, &fieldDescriptors[AVTP_CVF_FIELD_EVT], header->evt);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_CVF_HEADER_LEN / AVTP_QUADLET_SIZE);
+
+    return 0;
+}
+
+int Avtp_Cvf_InitView(Avtp_PduView_t* view, const uint8_t* buf, size_t len)
+{
+    if (view == NULL || buf == NULL || len < AVTP_CVF_HEADER_LEN) {
+        return -EINVAL;
+    }
+
+    const Avtp_Cvf_t* pdu = (const Avtp_Cvf_t*)buf;
+    if (Avtp_Cvf_GetSubtype(pdu) != AVTP_SUBTYPE_CVF) {
+        return -EINVAL;
+    }
+
+    size_t pduLength = AVTP_CVF_HEADER_LEN + Avtp_Cvf_GetStreamDataLength(pdu);
+    if (pduLength > len) {
+        return -EINVAL;
+    }
+
+    view->base = buf;
+    view->len = pduLength;
+
+    return 0;
+}
+
 /******************************************************************************
  * Legacy API (deprecated)
  *****************************************************************************/
@@ -102,10 +170,11 @@ int avtp_cvf_pdu_init(void* pdu, uint8_t format_subtype)
     int ret;
     ret = Avtp_Cvf_Init((Avtp_Cvf_t*)pdu);
     if (ret != 0) return ret;
-    ret = Avtp_Cvf_SetField(pdu, AVTP_CVF_FIELD_FORMAT_SUBTYPE, format_subtype);
-    if (ret != 0) return ret;
-    ret = Avtp_Cvf_SetField(pdu, AVTP_CVF_FIELD_FORMAT, AVTP_CVF_FORMAT_RFC);
-    if (ret != 0) return ret;
 
-    return 0;
+    const Avtp_FieldValue_t formatValues[] = {
+        { AVTP_CVF_FIELD_FORMAT, AVTP_CVF_FORMAT_RFC },
+        { AVTP_CVF_FIELD_FORMAT_SUBTYPE, format_subtype },
+    };
+    return Avtp_SetFields(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu,
+                          formatValues, sizeof(formatValues) / sizeof(formatValues[0]));
 }
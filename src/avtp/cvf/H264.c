@@ -36,7 +36,7 @@
 
 static const Avtp_FieldDescriptor_t fieldDescriptors[AVTP_H264_FIELD_MAX] =
 {
-    [AVTP_H264_FIELD_TIMESTAMP] = { .quadlet = 0, .offset = 0, .bits = 32 },
+    AVTP_H264_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_H264, Avtp_H264_t)
 };
 
 int Avtp_H264_Init(Avtp_H264_t* pdu)
@@ -55,3 +55,13 @@ int Avtp_H264_SetField(Avtp_H264_t* pdu, Avtp_H264Field_t field, uint64_t value)
 {
     return Avtp_SetField(fieldDescriptors, AVTP_H264_FIELD_MAX, (uint8_t*)pdu, field, value);
 }
+
+uint64_t Avtp_H264_GetField_Unchecked(const Avtp_H264_t* pdu, Avtp_H264Field_t field)
+{
+    return Avtp_GetField_Unchecked(fieldDescriptors, AVTP_H264_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_H264_SetField_Unchecked(Avtp_H264_t* pdu, Avtp_H264Field_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(fieldDescriptors, AVTP_H264_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
@@ -36,14 +36,7 @@
 
 static const Avtp_FieldDescriptor_t fieldDescriptors[AVTP_JPEG2000_FIELD_MAX] =
 {
-    [AVTP_JPEG2000_FIELD_TP]                = { .quadlet = 0, .offset = 0, .bits = 2 },
-    [AVTP_JPEG2000_FIELD_MHF]               = { .quadlet = 0, .offset = 2, .bits = 2 },
-    [AVTP_JPEG2000_FIELD_MH_ID]             = { .quadlet = 0, .offset = 4, .bits = 3 },
-    [AVTP_JPEG2000_FIELD_T]                 = { .quadlet = 0, .offset = 7, .bits = 1 },
-    [AVTP_JPEG2000_FIELD_PRIORITY]          = { .quadlet = 0, .offset = 8, .bits = 8 },
-    [AVTP_JPEG2000_FIELD_TILE_NUMBER]       = { .quadlet = 0, .offset = 16, .bits = 16 },
-    [AVTP_JPEG2000_FIELD_RESERVED]          = { .quadlet = 1, .offset = 0, .bits = 8 },
-    [AVTP_JPEG2000_FIELD_FRAGMENT_OFFSET]   = { .quadlet = 1, .offset = 8, .bits = 24 },
+    AVTP_JPEG2000_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Jpeg2000, Avtp_Jpeg2000_t)
 };
 
 int Avtp_Jpeg2000_Init(Avtp_Jpeg2000_t* pdu)
@@ -62,3 +55,13 @@ int Avtp_Jpeg2000_SetField(Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field, uin
 {
     return Avtp_SetField(fieldDescriptors, AVTP_JPEG2000_FIELD_MAX, (uint8_t*)pdu, field, value);
 }
+
+uint64_t Avtp_Jpeg2000_GetField_Unchecked(const Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field)
+{
+    return Avtp_GetField_Unchecked(fieldDescriptors, AVTP_JPEG2000_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Jpeg2000_SetField_Unchecked(Avtp_Jpeg2000_t* pdu, Avtp_Jpeg2000Field_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(fieldDescriptors, AVTP_JPEG2000_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
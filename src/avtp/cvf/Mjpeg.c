@@ -36,12 +36,7 @@
 
 static const Avtp_FieldDescriptor_t fieldDescriptors[AVTP_MJPEG_FIELD_MAX] =
 {
-    [AVTP_MJPEG_FIELD_TYPE_SPECIFIC]    = { .quadlet = 0, .offset = 0, .bits = 8 },
-    [AVTP_MJPEG_FIELD_FRAGMENT_OFFSET]  = { .quadlet = 0, .offset = 8, .bits = 24 },
-    [AVTP_MJPEG_FIELD_TYPE]             = { .quadlet = 1, .offset = 0, .bits = 8 },
-    [AVTP_MJPEG_FIELD_Q]                = { .quadlet = 1, .offset = 8, .bits = 8 },
-    [AVTP_MJPEG_FIELD_WIDTH]            = { .quadlet = 1, .offset = 16, .bits = 8 },
-    [AVTP_MJPEG_FIELD_HEIGHT]           = { .quadlet = 1, .offset = 24, .bits = 8 },
+    AVTP_MJPEG_FIELD_LIST(AVTP_FIELD_DESCRIPTOR, Avtp_Mjpeg, Avtp_Mjpeg_t)
 };
 
 int Avtp_Mjpeg_Init(Avtp_Mjpeg_t* pdu)
@@ -60,3 +55,13 @@ int Avtp_Mjpeg_SetField(Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field, uint64_t val
 {
     return Avtp_SetField(fieldDescriptors, AVTP_MJPEG_FIELD_MAX, (uint8_t*)pdu, field, value);
 }
+
+uint64_t Avtp_Mjpeg_GetField_Unchecked(const Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field)
+{
+    return Avtp_GetField_Unchecked(fieldDescriptors, AVTP_MJPEG_FIELD_MAX, (const uint8_t*)pdu, (uint8_t)field);
+}
+
+void Avtp_Mjpeg_SetField_Unchecked(Avtp_Mjpeg_t* pdu, Avtp_MjpegField_t field, uint64_t value)
+{
+    Avtp_SetField_Unchecked(fieldDescriptors, AVTP_MJPEG_FIELD_MAX, (uint8_t*)pdu, (uint8_t)field, value);
+}
@@ -532,6 +532,44 @@ static void aaf_pdu_init(void **state)
     assert_true(pdu.packet_info == 0);
 }
 
+static void aaf_unpack_pack(void **state)
+{
+    int res;
+    Avtp_AafPcmStreamHeader_t header;
+    struct avtp_stream_pdu pdu = { 0 };
+    struct avtp_stream_pdu packed = { 0 };
+
+    pdu.subtype_data = htonl(0x02819201);
+    pdu.stream_id = htobe64(0xAABBCCDDEEFF0001);
+    pdu.avtp_time = htonl(0x80C0FFEE);
+    pdu.format_specific = htonl(0x04500210);
+    pdu.packet_info = htonl(0x00081400);
+
+    res = Avtp_AafPcmStream_Unpack((Avtp_AafPcmStream_t*)&pdu, &header);
+
+    assert_int_equal(res, 0);
+    assert_int_equal(header.subtype, AVTP_SUBTYPE_AAF);
+    assert_int_equal(header.sv, 1);
+    assert_int_equal(header.mr, 0);
+    assert_int_equal(header.tv, 1);
+    assert_int_equal(header.sequence_num, 0x92);
+    assert_int_equal(header.tu, 1);
+    assert_true(header.stream_id == 0xAABBCCDDEEFF0001);
+    assert_int_equal(header.avtp_timestamp, 0x80C0FFEE);
+    assert_int_equal(header.format, AVTP_AAF_FORMAT_INT_16BIT);
+    assert_int_equal(header.nsr, AVTP_AAF_PCM_NSR_48KHZ);
+    assert_int_equal(header.channels_per_frame, 2);
+    assert_int_equal(header.bit_depth, 16);
+    assert_int_equal(header.stream_data_length, 8);
+    assert_int_equal(header.sp, AVTP_AAF_PCM_SP_SPARSE);
+    assert_int_equal(header.evt, 4);
+
+    res = Avtp_AafPcmStream_Pack((Avtp_AafPcmStream_t*)&packed, &header);
+
+    assert_int_equal(res, 0);
+    assert_memory_equal(&pdu, &packed, AVTP_AAF_PCM_STREAM_HEADER_LEN);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -570,6 +608,7 @@ int main(void)
         cmocka_unit_test(aaf_set_field_evt),
         cmocka_unit_test(aaf_pdu_init_null_pdu),
         cmocka_unit_test(aaf_pdu_init),
+        cmocka_unit_test(aaf_unpack_pack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
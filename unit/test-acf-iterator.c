@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/CommonHeader.h"
+#include "avtp/acf/Iterator.h"
+#include "avtp/acf/Can.h"
+#include "avtp/acf/CanBrief.h"
+#include "avtp/acf/Common.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+
+#define MAX_PDU_SIZE        1500
+
+/*
+ * Builds an NTSCF PDU carrying a CAN, a CAN Brief and a Sensor message and
+ * returns its length.
+ */
+static size_t build_ntscf(uint8_t* pdu)
+{
+    uint8_t payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    size_t len = AVTP_NTSCF_HEADER_LEN;
+
+    memset(pdu, 0, MAX_PDU_SIZE);
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu);
+
+    Avtp_Can_Init((Avtp_Can_t*)(pdu + len));
+    len += Avtp_Can_SetPayload((Avtp_Can_t*)(pdu + len), 0x123, payload, 5, CAN_CLASSIC);
+
+    Avtp_CanBrief_Init((Avtp_CanBrief_t*)(pdu + len));
+    len += Avtp_CanBrief_SetPayload((Avtp_CanBrief_t*)(pdu + len), 0x456, payload, 8, CAN_CLASSIC);
+
+    // Sensor message with a header and two quadlets of data
+    Avtp_AcfCommon_SetAcfMsgType((Avtp_AcfCommon_t*)(pdu + len), AVTP_ACF_TYPE_SENSOR);
+    Avtp_AcfCommon_SetAcfMsgLength((Avtp_AcfCommon_t*)(pdu + len), 5);
+    len += 5 * AVTP_QUADLET_SIZE;
+
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)pdu, len - AVTP_NTSCF_HEADER_LEN);
+
+    return len;
+}
+
+static void acf_iter_init_invalid(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    Avtp_AcfIter_t iter;
+    size_t len = build_ntscf(pdu);
+
+    assert_int_equal(Avtp_AcfIter_Init(NULL, pdu, len), -EINVAL);
+    assert_int_equal(Avtp_AcfIter_Init(&iter, NULL, len), -EINVAL);
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, 2), -EINVAL);
+
+    // Data length beyond the received bytes
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, len - 1), -EINVAL);
+
+    // Not a control format
+    pdu[0] = AVTP_SUBTYPE_CRF;
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, len), -EINVAL);
+}
+
+static void acf_iter_ntscf(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    Avtp_AcfIter_t iter;
+    Avtp_AcfMsg_t msg;
+    size_t len = build_ntscf(pdu);
+    const uint8_t* expected = pdu + AVTP_NTSCF_HEADER_LEN;
+
+    // Trailing bytes behind the control format data are ignored
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, len + 16), 0);
+
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 1);
+    assert_int_equal(msg.msg_type, AVTP_ACF_TYPE_CAN);
+    assert_ptr_equal(msg.msg_ptr, expected);
+    assert_int_equal(msg.msg_len, AVTP_CAN_HEADER_LEN + 8);
+    assert_int_equal(Avtp_Can_GetCanIdentifier((const Avtp_Can_t*)msg.msg_ptr), 0x123);
+    expected += msg.msg_len;
+
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 1);
+    assert_int_equal(msg.msg_type, AVTP_ACF_TYPE_CAN_BRIEF);
+    assert_ptr_equal(msg.msg_ptr, expected);
+    assert_int_equal(msg.msg_len, AVTP_CAN_BRIEF_HEADER_LEN + 8);
+    expected += msg.msg_len;
+
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 1);
+    assert_int_equal(msg.msg_type, AVTP_ACF_TYPE_SENSOR);
+    assert_ptr_equal(msg.msg_ptr, expected);
+    assert_int_equal(msg.msg_len, 5 * AVTP_QUADLET_SIZE);
+
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 0);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 0);
+}
+
+static void acf_iter_tscf(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE] = { 0 };
+    uint8_t payload[4] = { 0 };
+    Avtp_AcfIter_t iter;
+    Avtp_AcfMsg_t msg;
+    size_t len = AVTP_TSCF_HEADER_LEN;
+
+    Avtp_Tscf_Init((Avtp_Tscf_t*)pdu);
+    Avtp_Can_Init((Avtp_Can_t*)(pdu + len));
+    len += Avtp_Can_SetPayload((Avtp_Can_t*)(pdu + len), 0x1, payload, 4, CAN_CLASSIC);
+    Avtp_Tscf_SetStreamDataLength((Avtp_Tscf_t*)pdu, len - AVTP_TSCF_HEADER_LEN);
+
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, len), 0);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 1);
+    assert_int_equal(msg.msg_type, AVTP_ACF_TYPE_CAN);
+    assert_ptr_equal(msg.msg_ptr, pdu + AVTP_TSCF_HEADER_LEN);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 0);
+}
+
+static void acf_iter_malformed(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    Avtp_AcfIter_t iter;
+    Avtp_AcfMsg_t msg;
+    size_t len = build_ntscf(pdu);
+    uint8_t* second = pdu + AVTP_NTSCF_HEADER_LEN + AVTP_CAN_HEADER_LEN + 8;
+
+    // Second message runs beyond the control format data
+    Avtp_AcfCommon_SetAcfMsgLength((Avtp_AcfCommon_t*)second, 100);
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, len), 0);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 1);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), -EINVAL);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 0);
+
+    // Zero length message would never advance
+    Avtp_AcfCommon_SetAcfMsgLength((Avtp_AcfCommon_t*)second, 0);
+    assert_int_equal(Avtp_AcfIter_Init(&iter, pdu, len), 0);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 1);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), -EINVAL);
+
+    // Bare message sequence shorter than a header
+    assert_int_equal(Avtp_AcfIter_InitMessages(&iter, pdu + AVTP_NTSCF_HEADER_LEN, 3), 0);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), -EINVAL);
+
+    assert_int_equal(Avtp_AcfIter_InitMessages(&iter, NULL, 0), 0);
+    assert_int_equal(Avtp_AcfIter_Next(&iter, &msg), 0);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(acf_iter_init_invalid),
+        cmocka_unit_test(acf_iter_ntscf),
+        cmocka_unit_test(acf_iter_tscf),
+        cmocka_unit_test(acf_iter_malformed),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
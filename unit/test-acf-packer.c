@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/CommonHeader.h"
+#include "avtp/acf/Packer.h"
+#include "avtp/acf/Can.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+
+#define MAX_PDU_SIZE        1500
+
+static uint8_t payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+/* Writes a CAN message with an 8 byte payload (24 bytes) at the reserved
+ * position and commits it. */
+static int pack_can(Avtp_AcfPacker_t* packer, uint64_t now)
+{
+    uint8_t* msg = Avtp_AcfPacker_Reserve(packer, AVTP_CAN_HEADER_LEN + sizeof(payload));
+    int len;
+
+    if (msg == NULL) {
+        return -1;
+    }
+
+    Avtp_Can_Init((Avtp_Can_t*)msg);
+    len = Avtp_Can_SetPayload((Avtp_Can_t*)msg, 0x123, payload, sizeof(payload), CAN_CLASSIC);
+
+    return Avtp_AcfPacker_Commit(packer, len, now);
+}
+
+static void acf_packer_init_invalid(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE] = { 0 };
+    Avtp_AcfPacker_t packer;
+    int res;
+
+    res = Avtp_AcfPacker_Init(NULL, pdu, MAX_PDU_SIZE, 0, 0);
+    assert_int_equal(res, -EINVAL);
+
+    res = Avtp_AcfPacker_Init(&packer, NULL, MAX_PDU_SIZE, 0, 0);
+    assert_int_equal(res, -EINVAL);
+
+    // Not a control format PDU
+    pdu[0] = AVTP_SUBTYPE_CRF;
+    res = Avtp_AcfPacker_Init(&packer, pdu, MAX_PDU_SIZE, 0, 0);
+    assert_int_equal(res, -EINVAL);
+
+    // No room for a single message
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu);
+    res = Avtp_AcfPacker_Init(&packer, pdu, AVTP_NTSCF_HEADER_LEN, 0, 0);
+    assert_int_equal(res, -EINVAL);
+
+    res = Avtp_AcfPacker_Init(&packer, pdu, MAX_PDU_SIZE, 0, 0);
+    assert_int_equal(res, 0);
+
+    // Messages must be a non-empty multiple of quadlets
+    res = Avtp_AcfPacker_Commit(&packer, 0, 0);
+    assert_int_equal(res, -EINVAL);
+    res = Avtp_AcfPacker_Commit(&packer, 6, 0);
+    assert_int_equal(res, -EINVAL);
+}
+
+static void acf_packer_count_flush(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE] = { 0 };
+    Avtp_AcfPacker_t packer;
+    int res;
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu);
+    res = Avtp_AcfPacker_Init(&packer, pdu, MAX_PDU_SIZE, 3, 0);
+    assert_int_equal(res, 0);
+
+    // Nothing to send yet
+    assert_int_equal(Avtp_AcfPacker_Finalize(&packer), 0);
+
+    assert_int_equal(pack_can(&packer, 0), 0);
+    assert_int_equal(pack_can(&packer, 0), 0);
+    assert_int_equal(pack_can(&packer, 0), 1);
+    assert_int_equal(Avtp_AcfPacker_GetNumMsgs(&packer), 3);
+
+    res = Avtp_AcfPacker_Finalize(&packer);
+    assert_int_equal(res, AVTP_NTSCF_HEADER_LEN + 3 * 24);
+    assert_int_equal(Avtp_Ntscf_GetNtscfDataLength((Avtp_Ntscf_t*)pdu), 3 * 24);
+
+    // Messages are laid out back to back
+    assert_int_equal(Avtp_Can_GetCanIdentifier((Avtp_Can_t*)(pdu + AVTP_NTSCF_HEADER_LEN + 48)), 0x123);
+
+    Avtp_AcfPacker_Reset(&packer);
+    assert_int_equal(Avtp_AcfPacker_GetNumMsgs(&packer), 0);
+    assert_int_equal(Avtp_AcfPacker_Finalize(&packer), 0);
+    assert_ptr_equal(Avtp_AcfPacker_Reserve(&packer, 24), pdu + AVTP_NTSCF_HEADER_LEN);
+}
+
+static void acf_packer_mtu_flush(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE] = { 0 };
+    Avtp_AcfPacker_t packer;
+    int res;
+
+    // Room for two CAN messages and a few bytes
+    Avtp_Tscf_Init((Avtp_Tscf_t*)pdu);
+    res = Avtp_AcfPacker_Init(&packer, pdu, AVTP_TSCF_HEADER_LEN + 2 * 24 + 8, 0, 0);
+    assert_int_equal(res, 0);
+
+    assert_int_equal(pack_can(&packer, 0), 0);
+    assert_int_equal(pack_can(&packer, 0), 0);
+
+    // Third message does not fit
+    assert_null(Avtp_AcfPacker_Reserve(&packer, 24));
+    assert_non_null(Avtp_AcfPacker_Reserve(&packer, 8));
+    assert_int_equal(Avtp_AcfPacker_Commit(&packer, 24, 0), -EINVAL);
+
+    res = Avtp_AcfPacker_Finalize(&packer);
+    assert_int_equal(res, AVTP_TSCF_HEADER_LEN + 2 * 24);
+    assert_int_equal(Avtp_Tscf_GetStreamDataLength((Avtp_Tscf_t*)pdu), 2 * 24);
+
+    // No room for another header after a full PDU
+    res = Avtp_AcfPacker_Init(&packer, pdu, AVTP_TSCF_HEADER_LEN + 24 + 2, 0, 0);
+    assert_int_equal(res, 0);
+    assert_int_equal(pack_can(&packer, 0), 1);
+
+    // Maximum length is limited by the NTSCF data length field
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu);
+    res = Avtp_AcfPacker_Init(&packer, pdu, UINT16_MAX, 0, 0);
+    assert_int_equal(res, 0);
+    assert_null(Avtp_AcfPacker_Reserve(&packer, 0x800));
+    assert_non_null(Avtp_AcfPacker_Reserve(&packer, 0x7FC));
+}
+
+static void acf_packer_deadline_flush(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE] = { 0 };
+    Avtp_AcfPacker_t packer;
+    int res;
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu);
+    res = Avtp_AcfPacker_Init(&packer, pdu, MAX_PDU_SIZE, 10, 500);
+    assert_int_equal(res, 0);
+
+    // An empty PDU is never due
+    assert_int_equal(Avtp_AcfPacker_GetDeadline(&packer), AVTP_ACF_PACKER_NO_DEADLINE);
+    assert_int_equal(Avtp_AcfPacker_IsDue(&packer, 100000), 0);
+
+    // The deadline starts with the first message
+    assert_int_equal(pack_can(&packer, 1000), 0);
+    assert_int_equal(pack_can(&packer, 1400), 0);
+    assert_int_equal(Avtp_AcfPacker_GetDeadline(&packer), 1500);
+    assert_int_equal(Avtp_AcfPacker_IsDue(&packer, 1499), 0);
+    assert_int_equal(Avtp_AcfPacker_IsDue(&packer, 1500), 1);
+
+    Avtp_AcfPacker_Reset(&packer);
+    assert_int_equal(Avtp_AcfPacker_GetDeadline(&packer), AVTP_ACF_PACKER_NO_DEADLINE);
+
+    // Without a latency the PDU waits for the count
+    res = Avtp_AcfPacker_Init(&packer, pdu, MAX_PDU_SIZE, 10, 0);
+    assert_int_equal(res, 0);
+    assert_int_equal(pack_can(&packer, 1000), 0);
+    assert_int_equal(Avtp_AcfPacker_GetDeadline(&packer), AVTP_ACF_PACKER_NO_DEADLINE);
+    assert_int_equal(Avtp_AcfPacker_IsDue(&packer, UINT64_MAX - 1), 0);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(acf_packer_init_invalid),
+        cmocka_unit_test(acf_packer_count_flush),
+        cmocka_unit_test(acf_packer_mtu_flush),
+        cmocka_unit_test(acf_packer_deadline_flush),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -31,8 +31,22 @@
 #include <cmocka.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <string.h>
 
 #include "avtp/CommonHeader.h"
+#include "avtp/Utils.h"
+
+/* Test layout with fields sharing quadlets and spanning quadlet boundaries. */
+static const Avtp_FieldDescriptor_t testFieldDescriptors[] = {
+    { .quadlet = 0, .offset = 0, .bits = 8 },
+    { .quadlet = 0, .offset = 8, .bits = 1 },
+    { .quadlet = 0, .offset = 13, .bits = 11 },
+    { .quadlet = 1, .offset = 0, .bits = 64 },
+    { .quadlet = 3, .offset = 3, .bits = 29 },
+    { .quadlet = 3, .offset = 24, .bits = 40 },
+};
+
+#define TEST_NUM_FIELDS (sizeof(testFieldDescriptors) / sizeof(testFieldDescriptors[0]))
 
 static void get_field_null_pdu(void **state)
 {
@@ -136,6 +150,136 @@ static void set_field_version(void **state)
     assert_true(ntohl(pdu.subtype_data) == 0x00500000);
 }
 
+static void set_fields_batched(void **state)
+{
+    int res;
+    uint8_t pdu[5 * AVTP_QUADLET_SIZE];
+    uint8_t ref[5 * AVTP_QUADLET_SIZE];
+    const Avtp_FieldValue_t fieldValues[] = {
+        { 4, 0x1abcdef0 },
+        { 0, AVTP_SUBTYPE_NTSCF },
+        { 2, 0x5a5 },
+        { 3, 0x0123456789abcdef },
+        { 1, 1 },
+        { 5, 0xfedcba9876 },
+    };
+
+    memset(pdu, 0xa5, sizeof(pdu));
+    memset(ref, 0xa5, sizeof(ref));
+
+    for (size_t i = 0; i < sizeof(fieldValues) / sizeof(fieldValues[0]); i++) {
+        Avtp_SetField(testFieldDescriptors, TEST_NUM_FIELDS, ref,
+                        fieldValues[i].field, fieldValues[i].value);
+    }
+
+    res = Avtp_SetFields(testFieldDescriptors, TEST_NUM_FIELDS, pdu, fieldValues,
+                        sizeof(fieldValues) / sizeof(fieldValues[0]));
+
+    assert_int_equal(res, 0);
+    assert_memory_equal(ref, pdu, sizeof(pdu));
+}
+
+static void set_fields_invalid_field(void **state)
+{
+    int res;
+    uint8_t pdu[5 * AVTP_QUADLET_SIZE] = { 0 };
+    uint8_t zero[5 * AVTP_QUADLET_SIZE] = { 0 };
+    const Avtp_FieldValue_t fieldValues[] = {
+        { 0, AVTP_SUBTYPE_NTSCF },
+        { TEST_NUM_FIELDS, 1 },
+    };
+
+    res = Avtp_SetFields(testFieldDescriptors, TEST_NUM_FIELDS, NULL, fieldValues, 1);
+    assert_int_equal(res, -EINVAL);
+
+    // No field must be written if any of them is invalid
+    res = Avtp_SetFields(testFieldDescriptors, TEST_NUM_FIELDS, pdu, fieldValues, 2);
+    assert_int_equal(res, -EINVAL);
+    assert_memory_equal(zero, pdu, sizeof(pdu));
+}
+
+static void get_fields_batched(void **state)
+{
+    int res;
+    uint64_t val;
+    uint8_t pdu[5 * AVTP_QUADLET_SIZE];
+    Avtp_FieldValue_t fieldValues[TEST_NUM_FIELDS];
+
+    for (size_t i = 0; i < sizeof(pdu); i++) {
+        pdu[i] = 0x3d * i;
+    }
+    for (size_t i = 0; i < TEST_NUM_FIELDS; i++) {
+        fieldValues[i].field = TEST_NUM_FIELDS - 1 - i;
+        fieldValues[i].value = 0;
+    }
+
+    res = Avtp_GetFields(testFieldDescriptors, TEST_NUM_FIELDS, pdu, fieldValues, TEST_NUM_FIELDS);
+    assert_int_equal(res, 0);
+
+    for (size_t i = 0; i < TEST_NUM_FIELDS; i++) {
+        Avtp_GetField(testFieldDescriptors, TEST_NUM_FIELDS, pdu, fieldValues[i].field, &val);
+        assert_true(fieldValues[i].value == val);
+    }
+
+    fieldValues[0].field = TEST_NUM_FIELDS;
+    res = Avtp_GetFields(testFieldDescriptors, TEST_NUM_FIELDS, pdu, fieldValues, TEST_NUM_FIELDS);
+    assert_int_equal(res, -EINVAL);
+}
+
+static void load_store_be_unaligned(void **state)
+{
+    uint8_t buf[16];
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        memset(buf, 0, sizeof(buf));
+
+        Avtp_StoreBe64(buf + offset, 0x0102030405060708);
+        assert_int_equal(buf[offset], 0x01);
+        assert_int_equal(buf[offset + 7], 0x08);
+        assert_true(Avtp_LoadBe64(buf + offset) == 0x0102030405060708);
+        assert_int_equal(Avtp_LoadBe32(buf + offset + 4), 0x05060708);
+        assert_int_equal(Avtp_LoadBe16(buf + offset + 2), 0x0304);
+
+        Avtp_StoreBe32(buf + offset, 0xAABBCCDD);
+        assert_int_equal(buf[offset], 0xAA);
+        assert_int_equal(Avtp_LoadBe32(buf + offset), 0xAABBCCDD);
+
+        Avtp_StoreBe16(buf + offset, 0xEEFF);
+        assert_int_equal(buf[offset + 1], 0xFF);
+        assert_int_equal(Avtp_LoadBe16(buf + offset), 0xEEFF);
+    }
+}
+
+static void get_set_field_unaligned(void **state)
+{
+    uint8_t aligned[5 * AVTP_QUADLET_SIZE] __attribute__((aligned(8)));
+    uint8_t buf[5 * AVTP_QUADLET_SIZE + 3];
+    uint8_t* pdu = buf + 3;
+    uint64_t val, ref;
+
+    for (size_t i = 0; i < sizeof(aligned); i++) {
+        aligned[i] = 0x3d * i;
+    }
+    memcpy(pdu, aligned, sizeof(aligned));
+
+    for (uint8_t field = 0; field < TEST_NUM_FIELDS; field++) {
+        Avtp_GetField(testFieldDescriptors, TEST_NUM_FIELDS, aligned, field, &ref);
+        Avtp_GetField(testFieldDescriptors, TEST_NUM_FIELDS, pdu, field, &val);
+        assert_true(val == ref);
+
+        const Avtp_FieldDescriptor_t* desc = &testFieldDescriptors[field];
+        val = Avtp_GetFieldInline(pdu, desc->quadlet, desc->offset, desc->bits);
+        assert_true(val == ref);
+    }
+
+    for (uint8_t field = 0; field < TEST_NUM_FIELDS; field++) {
+        const Avtp_FieldDescriptor_t* desc = &testFieldDescriptors[field];
+        Avtp_SetField(testFieldDescriptors, TEST_NUM_FIELDS, aligned, field, 0x5a5a5a5a5a5a5a5a);
+        Avtp_SetFieldInline(pdu, desc->quadlet, desc->offset, desc->bits, 0x5a5a5a5a5a5a5a5a);
+        assert_memory_equal(aligned, pdu, sizeof(aligned));
+    }
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -148,6 +292,11 @@ int main(void)
         cmocka_unit_test(set_field_invalid_field),
         cmocka_unit_test(set_field_subtype),
         cmocka_unit_test(set_field_version),
+        cmocka_unit_test(set_fields_batched),
+        cmocka_unit_test(set_fields_invalid_field),
+        cmocka_unit_test(get_fields_batched),
+        cmocka_unit_test(load_store_be_unaligned),
+        cmocka_unit_test(get_set_field_unaligned),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "avtp/Byteorder.h"
+
+/* Large enough to exercise the vector loops and the scalar tail. */
+#define TEST_ARRAY_BYTES    (8 * 67)
+
+static void fill(uint8_t* buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(i * 0x3d + 1);
+    }
+}
+
+static void bswap_array(void (*bswap)(void*, const void*, size_t),
+                            size_t elemSize)
+{
+    uint8_t src[TEST_ARRAY_BYTES + 1];
+    uint8_t dst[TEST_ARRAY_BYTES + 1];
+    uint8_t ref[TEST_ARRAY_BYTES + 1];
+
+    // Every length up to the buffer size, once aligned and once misaligned
+    for (size_t offset = 0; offset < 2; offset++) {
+        size_t maxN = (TEST_ARRAY_BYTES) / elemSize;
+        for (size_t n = 0; n <= maxN; n++) {
+            fill(src, sizeof(src));
+            memset(dst, 0xee, sizeof(dst));
+            memcpy(ref, dst, sizeof(ref));
+            for (size_t i = 0; i < n; i++) {
+                for (size_t b = 0; b < elemSize; b++) {
+                    ref[offset + i * elemSize + b] =
+                            src[offset + i * elemSize + elemSize - 1 - b];
+                }
+            }
+
+            bswap(dst + offset, src + offset, n);
+            assert_memory_equal(dst, ref, sizeof(dst));
+
+            // In place
+            bswap(src + offset, src + offset, n);
+            assert_memory_equal(src + offset, ref + offset, n * elemSize);
+        }
+    }
+}
+
+static void bswap_array16(void **state)
+{
+    bswap_array(Avtp_BswapArray16, sizeof(uint16_t));
+}
+
+static void bswap_array32(void **state)
+{
+    bswap_array(Avtp_BswapArray32, sizeof(uint32_t));
+}
+
+static void bswap_array64(void **state)
+{
+    bswap_array(Avtp_BswapArray64, sizeof(uint64_t));
+}
+
+static void cpu_to_be_array64(void **state)
+{
+    uint64_t host[3] = { 0x0102030405060708, 0x1112131415161718, 0x2122232425262728 };
+    uint8_t be[sizeof(host)];
+    uint64_t back[3];
+
+    Avtp_CpuToBeArray64(be, host, 3);
+    assert_int_equal(be[0], 0x01);
+    assert_int_equal(be[7], 0x08);
+    assert_int_equal(be[16], 0x21);
+    assert_true(Avtp_LoadBe64(be + 8) == host[1]);
+
+    Avtp_BeToCpuArray64(back, be, 3);
+    assert_memory_equal(back, host, sizeof(host));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(bswap_array16),
+        cmocka_unit_test(bswap_array32),
+        cmocka_unit_test(bswap_array64),
+        cmocka_unit_test(cpu_to_be_array64),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
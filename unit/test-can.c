@@ -124,12 +124,106 @@ static void can_set_payload(void **state) {
     }
 }
 
+static void can_brief_set_get_payload(void **state) {
+
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint8_t set_payload[CAN_PAYLOAD_SIZE] = {0,1,2,3,4,5,6,7};
+    uint8_t zero_array[CAN_PAYLOAD_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0};
+    uint16_t payload_length, pdu_length;
+    uint8_t* payload;
+
+    for (int i=0; i<=CAN_PAYLOAD_SIZE; i++) {
+        int ret;
+        memset(pdu, 0xff, MAX_PDU_SIZE);
+        Avtp_CanBrief_Init((Avtp_CanBrief_t*)pdu);
+        ret = Avtp_CanBrief_SetPayload((Avtp_CanBrief_t*)pdu, 0x800, set_payload,
+                        i, CAN_CLASSIC);
+        assert_int_equal(ret, AVTP_CAN_BRIEF_HEADER_LEN+i+((4 - i%4)&0x3));
+        assert_memory_equal(set_payload, pdu+AVTP_CAN_BRIEF_HEADER_LEN, i);
+        assert_memory_equal(zero_array, pdu+AVTP_CAN_BRIEF_HEADER_LEN+i, (4 - i%4)&0x3);
+        assert_int_equal(Avtp_CanBrief_GetEff((Avtp_CanBrief_t*)pdu), 1);
+        assert_int_equal(Avtp_CanBrief_GetCanIdentifier((Avtp_CanBrief_t*)pdu), 0x800);
+
+        payload = Avtp_CanBrief_GetPayload((Avtp_CanBrief_t*)pdu, &payload_length, &pdu_length);
+        assert_ptr_equal(payload, pdu+AVTP_CAN_BRIEF_HEADER_LEN);
+        assert_int_equal(payload_length, i);
+        assert_int_equal(pdu_length * 4, ret);
+    }
+}
+
+static void can_fd_payload(void **state) {
+
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint8_t set_payload[64];
+    uint16_t payload_length;
+    uint8_t* payload;
+    int ret;
+
+    for (int i = 0; i < sizeof(set_payload); i++) {
+        set_payload[i] = i;
+    }
+
+    memset(pdu, 0xff, MAX_PDU_SIZE);
+    Avtp_Can_Init((Avtp_Can_t*)pdu);
+    ret = Avtp_Can_SetPayload((Avtp_Can_t*)pdu, 0x123, set_payload,
+                              sizeof(set_payload), CAN_FD);
+    assert_int_equal(ret, AVTP_CAN_HEADER_LEN + sizeof(set_payload));
+    assert_int_equal(Avtp_Can_GetFdf((Avtp_Can_t*)pdu), 1);
+    assert_int_equal(Avtp_Can_GetBrs((Avtp_Can_t*)pdu), 0);
+
+    Avtp_Can_SetBrs((Avtp_Can_t*)pdu, 1);
+    Avtp_Can_SetEsi((Avtp_Can_t*)pdu, 1);
+    assert_int_equal(Avtp_Can_GetFdf((Avtp_Can_t*)pdu), 1);
+    assert_int_equal(Avtp_Can_GetCanIdentifier((Avtp_Can_t*)pdu), 0x123);
+
+    payload = Avtp_Can_GetPayload((Avtp_Can_t*)pdu, &payload_length, NULL);
+    assert_int_equal(payload_length, sizeof(set_payload));
+    assert_memory_equal(payload, set_payload, sizeof(set_payload));
+
+    // CAN FD payloads with padding
+    memset(pdu, 0xff, MAX_PDU_SIZE);
+    Avtp_CanBrief_Init((Avtp_CanBrief_t*)pdu);
+    ret = Avtp_CanBrief_SetPayload((Avtp_CanBrief_t*)pdu, 0x123, set_payload,
+                                   13, CAN_FD);
+    assert_int_equal(ret, AVTP_CAN_BRIEF_HEADER_LEN + 16);
+    assert_int_equal(Avtp_CanBrief_GetFdf((Avtp_CanBrief_t*)pdu), 1);
+    Avtp_CanBrief_GetPayload((Avtp_CanBrief_t*)pdu, &payload_length, NULL);
+    assert_int_equal(payload_length, 13);
+}
+
+static void can_field_accessors(void **state) {
+
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint8_t ref[MAX_PDU_SIZE];
+    uint64_t value;
+
+    memset(pdu, 0xa5, MAX_PDU_SIZE);
+    memset(ref, 0xa5, MAX_PDU_SIZE);
+
+    // Each specialized accessor must behave exactly like the generic one
+#define CHECK_ACCESSORS(prefix, type, field, name, q, o, b)                     \
+    prefix##_Set##name((type*)pdu, 0x123456789abcdef0ull);                      \
+    Avtp_Can_SetField((type*)ref, field, 0x123456789abcdef0ull & (~0ull >> (64 - (b)))); \
+    assert_memory_equal(ref, pdu, AVTP_CAN_HEADER_LEN);                         \
+    Avtp_Can_GetField((type*)ref, field, &value);                               \
+    assert_int_equal(prefix##_Get##name((type*)pdu), value);
+
+    AVTP_CAN_FIELD_LIST(CHECK_ACCESSORS, Avtp_Can, Avtp_Can_t)
+#undef CHECK_ACCESSORS
+
+    assert_int_equal(Avtp_Can_GetCanIdentifier((Avtp_Can_t*)pdu), 0x1abcdef0);
+    assert_int_equal(Avtp_Can_GetMessageTimestamp((Avtp_Can_t*)pdu), 0x123456789abcdef0ull);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(can_init),
         cmocka_unit_test(can_brief_init),
-        cmocka_unit_test(can_set_payload)
+        cmocka_unit_test(can_set_payload),
+        cmocka_unit_test(can_brief_set_get_payload),
+        cmocka_unit_test(can_fd_payload),
+        cmocka_unit_test(can_field_accessors)
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "common/candump.h"
+
+/* Feed input through a pipe and read all frames until the end of file. */
+static int read_all(const char *input, struct canfd_frame *frames, int max_frames,
+                    struct candump_reader *reader)
+{
+    int fds[2], is_fd, n = 0;
+    ssize_t res;
+
+    assert_int_equal(pipe(fds), 0);
+    if (strlen(input) > 4096)
+        assert_true(fcntl(fds[1], F_SETPIPE_SZ, (int)strlen(input)) >= (int)strlen(input));
+    assert_int_equal(write(fds[1], input, strlen(input)), strlen(input));
+    close(fds[1]);
+
+    candump_reader_init(reader, fds[0]);
+    do {
+        res = candump_reader_fill(reader);
+        assert_true(res >= 0);
+        while (n < max_frames && candump_reader_next(reader, &frames[n], &is_fd) > 0)
+            n++;
+    } while (res > 0);
+
+    close(fds[0]);
+
+    return n;
+}
+
+static void candump_reader_lines(void **state)
+{
+    struct candump_reader reader;
+    struct canfd_frame frames[4];
+    int n;
+
+    n = read_all("(0.000000) can0 123#1122\n\n(0.000000) can0 1ABCDEF0#33\n",
+                 frames, 4, &reader);
+
+    assert_int_equal(n, 2);
+    assert_int_equal(frames[0].can_id, 0x123);
+    assert_int_equal(frames[0].len, 2);
+    assert_int_equal(frames[0].data[1], 0x22);
+    assert_int_equal(frames[1].can_id, 0x1ABCDEF0 | CAN_EFF_FLAG);
+    assert_int_equal(frames[1].data[0], 0x33);
+    assert_int_equal(reader.invalid_lines, 0);
+}
+
+static void candump_reader_last_line_without_newline(void **state)
+{
+    struct candump_reader reader;
+    struct canfd_frame frames[4];
+    int n;
+
+    n = read_all("(0.000000) can0 123#11\n(0.000000) can0 456#2233", frames, 4, &reader);
+
+    assert_int_equal(n, 2);
+    assert_int_equal(frames[1].can_id, 0x456);
+    assert_int_equal(frames[1].len, 2);
+    assert_int_equal(frames[1].data[1], 0x33);
+    assert_int_equal(reader.invalid_lines, 0);
+
+    // Nothing is left after the end of file
+    assert_int_equal(reader.start, reader.end);
+}
+
+static void candump_reader_invalid_last_line(void **state)
+{
+    struct candump_reader reader;
+    struct canfd_frame frames[4];
+    int n;
+
+    n = read_all("(0.000000) can0 123#11\ngarbage", frames, 4, &reader);
+
+    assert_int_equal(n, 1);
+    assert_int_equal(reader.invalid_lines, 1);
+}
+
+static void candump_reader_overlong_line(void **state)
+{
+    static const char first[] = "(0.000000) can0 123#11\n(0.000000) can0 456#";
+    static const char last[] = "\n(0.000000) can0 789#33\n";
+    struct candump_reader reader;
+    struct canfd_frame frames[4];
+    size_t len = CANDUMP_BUF_SIZE + 1000;
+    char *input;
+    int n;
+
+    // The rest of the dropped line must not be parsed as a line of its own
+    input = malloc(len + 1);
+    assert_non_null(input);
+    memset(input, '2', len);
+    memcpy(input, first, strlen(first));
+    memcpy(input + len - strlen(last), last, strlen(last));
+    input[len] = '\0';
+
+    n = read_all(input, frames, 4, &reader);
+    free(input);
+
+    assert_int_equal(n, 2);
+    assert_int_equal(frames[0].can_id, 0x123);
+    assert_int_equal(frames[1].can_id, 0x789);
+    assert_int_equal(reader.invalid_lines, 1);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(candump_reader_lines),
+        cmocka_unit_test(candump_reader_last_line_without_newline),
+        cmocka_unit_test(candump_reader_invalid_last_line),
+        cmocka_unit_test(candump_reader_overlong_line),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "common/canfilter.h"
+
+static void canfilter_range_crossing_sff_limit(void **state)
+{
+    struct can_id_filter filter;
+
+    can_id_filter_init(&filter);
+    assert_int_equal(can_id_filter_add_rule(&filter, "700-800"), 0);
+    assert_int_equal(can_id_filter_compile(&filter), 0);
+
+    assert_int_equal(can_id_filter_match(&filter, 0x6FF, 0), 0);
+    assert_int_equal(can_id_filter_match(&filter, 0x700, 0), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x7FF, 0), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x700, 1), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x800, 1), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x801, 1), 0);
+
+    can_id_filter_free(&filter);
+}
+
+static void canfilter_eff_range_below_sff_limit(void **state)
+{
+    struct can_id_filter filter;
+
+    // Eight digits select extended identifiers only
+    can_id_filter_init(&filter);
+    assert_int_equal(can_id_filter_add_rule(&filter, "00000700-00000800"), 0);
+    assert_int_equal(can_id_filter_compile(&filter), 0);
+
+    assert_int_equal(can_id_filter_match(&filter, 0x700, 0), 0);
+    assert_int_equal(can_id_filter_match(&filter, 0x700, 1), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x800, 1), 1);
+
+    can_id_filter_free(&filter);
+}
+
+static void canfilter_sff_range(void **state)
+{
+    struct can_id_filter filter;
+
+    can_id_filter_init(&filter);
+    assert_int_equal(can_id_filter_add_rule(&filter, "100-1FF"), 0);
+    assert_int_equal(can_id_filter_compile(&filter), 0);
+
+    assert_int_equal(can_id_filter_match(&filter, 0x100, 0), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x1FF, 0), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x200, 0), 0);
+    assert_int_equal(can_id_filter_match(&filter, 0x100, 1), 0);
+
+    can_id_filter_free(&filter);
+}
+
+static void canfilter_wide_mask(void **state)
+{
+    struct can_id_filter filter;
+
+    // A mask above 0x7FF makes the rule apply to extended identifiers
+    can_id_filter_init(&filter);
+    assert_int_equal(can_id_filter_add_rule(&filter, "100:1FFFFFFF"), 0);
+    assert_int_equal(can_id_filter_compile(&filter), 0);
+
+    assert_int_equal(can_id_filter_match(&filter, 0x100, 0), 0);
+    assert_int_equal(can_id_filter_match(&filter, 0x100, 1), 1);
+    assert_int_equal(can_id_filter_match(&filter, 0x10100, 1), 0);
+
+    can_id_filter_free(&filter);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(canfilter_range_crossing_sff_limit),
+        cmocka_unit_test(canfilter_eff_range_below_sff_limit),
+        cmocka_unit_test(canfilter_sff_range),
+        cmocka_unit_test(canfilter_wide_mask),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
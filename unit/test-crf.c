@@ -32,6 +32,7 @@
 #include <arpa/inet.h>
 #include <stdio.h>
 #include <errno.h>
+#include <string.h>
 
 #include "avtp/CommonHeader.h"
 #include "avtp/Crf.h"
@@ -419,6 +420,91 @@ static void crf_pdu_init(void **state)
     assert_true(pdu.packet_info == 0);
 }
 
+static void crf_unpack(void **state)
+{
+    int res;
+    Avtp_CrfHeader_t header;
+    struct avtp_crf_pdu pdu = { 0 };
+
+    pdu.subtype_data = htonl(0x04809a01);
+    pdu.stream_id = htobe64(0xAABBCCDDEEFF0001);
+    pdu.packet_info = htobe64(0x2000bb8000400140);
+
+    res = Avtp_Crf_Unpack(NULL, &header);
+    assert_int_equal(res, -EINVAL);
+
+    res = Avtp_Crf_Unpack((Avtp_Crf_t*)&pdu, &header);
+
+    assert_int_equal(res, 0);
+    assert_int_equal(header.subtype, AVTP_SUBTYPE_CRF);
+    assert_int_equal(header.sv, 1);
+    assert_int_equal(header.version, 0);
+    assert_int_equal(header.mr, 0);
+    assert_int_equal(header.fs, 0);
+    assert_int_equal(header.tu, 0);
+    assert_int_equal(header.sequence_num, 0x9a);
+    assert_int_equal(header.type, AVTP_CRF_TYPE_AUDIO_SAMPLE);
+    assert_true(header.stream_id == 0xAABBCCDDEEFF0001);
+    assert_int_equal(header.pull, 1);
+    assert_int_equal(header.base_frequency, 48000);
+    assert_int_equal(header.crf_data_length, 64);
+    assert_int_equal(header.timestamp_interval, 320);
+}
+
+static void crf_pack(void **state)
+{
+    int res;
+    Avtp_CrfHeader_t header = { 0 };
+    uint8_t pdu[AVTP_CRF_HEADER_LEN];
+    uint8_t ref[AVTP_CRF_HEADER_LEN];
+
+    header.subtype = AVTP_SUBTYPE_CRF;
+    header.sv = 1;
+    header.sequence_num = 0x9a;
+    header.type = AVTP_CRF_TYPE_AUDIO_SAMPLE;
+    header.stream_id = 0xAABBCCDDEEFF0001;
+    header.pull = 1;
+    header.base_frequency = 48000;
+    header.crf_data_length = 64;
+    header.timestamp_interval = 320;
+
+    memset(pdu, 0xff, sizeof(pdu));
+    res = Avtp_Crf_Pack((Avtp_Crf_t*)pdu, &header);
+    assert_int_equal(res, 0);
+
+    memset(ref, 0, sizeof(ref));
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_SUBTYPE, AVTP_SUBTYPE_CRF);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_SV, 1);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_SEQUENCE_NUM, 0x9a);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_TYPE, AVTP_CRF_TYPE_AUDIO_SAMPLE);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_STREAM_ID, 0xAABBCCDDEEFF0001);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_PULL, 1);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_BASE_FREQUENCY, 48000);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_CRF_DATA_LENGTH, 64);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_TIMESTAMP_INTERVAL, 320);
+
+    assert_memory_equal(ref, pdu, AVTP_CRF_HEADER_LEN);
+}
+
+static void crf_field_unchecked(void **state)
+{
+    uint64_t val;
+    uint8_t pdu[AVTP_CRF_HEADER_LEN];
+    uint8_t ref[AVTP_CRF_HEADER_LEN];
+
+    memset(pdu, 0x5a, sizeof(pdu));
+    memset(ref, 0x5a, sizeof(ref));
+
+    for (int field = 0; field < AVTP_CRF_FIELD_MAX; field++) {
+        Avtp_Crf_SetField_Unchecked((Avtp_Crf_t*)pdu, field, 0xfedcba9876543210);
+        Avtp_Crf_SetField((Avtp_Crf_t*)ref, field, 0xfedcba9876543210);
+        assert_memory_equal(ref, pdu, AVTP_CRF_HEADER_LEN);
+
+        Avtp_Crf_GetField((Avtp_Crf_t*)ref, field, &val);
+        assert_true(Avtp_Crf_GetField_Unchecked((Avtp_Crf_t*)pdu, field) == val);
+    }
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -451,6 +537,9 @@ int main(void)
         cmocka_unit_test(crf_set_field_timestamp_interval),
         cmocka_unit_test(crf_pdu_init_null_pdu),
         cmocka_unit_test(crf_pdu_init),
+        cmocka_unit_test(crf_unpack),
+        cmocka_unit_test(crf_pack),
+        cmocka_unit_test(crf_field_unchecked),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
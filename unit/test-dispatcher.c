@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/Dispatcher.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/acf/Ntscf.h"
+
+#define MAX_PDU_SIZE        1500
+
+typedef struct {
+    int calls;
+    size_t lastLen;
+    uint8_t lastSubtype;
+} HandlerState_t;
+
+static int count_handler(const Avtp_PduView_t* view, void* ctx)
+{
+    HandlerState_t* state = ctx;
+    state->calls++;
+    state->lastLen = view->len;
+    state->lastSubtype = view->base[0];
+    return 42;
+}
+
+static void dispatcher_init_invalid(void **state)
+{
+    Avtp_Dispatcher_t dispatcher;
+
+    assert_int_equal(Avtp_Dispatcher_Init(NULL), -EINVAL);
+    assert_int_equal(Avtp_Dispatcher_Register(NULL, AVTP_SUBTYPE_CRF, count_handler, NULL), -EINVAL);
+    assert_int_equal(Avtp_Dispatcher_SetDefault(NULL, count_handler, NULL), -EINVAL);
+
+    assert_int_equal(Avtp_Dispatcher_Init(&dispatcher), 0);
+}
+
+static void dispatcher_dispatch(void **state)
+{
+    Avtp_Dispatcher_t dispatcher;
+    HandlerState_t crf = { 0 }, ntscf = { 0 }, fallback = { 0 };
+    uint8_t crf_pdu[AVTP_CRF_HEADER_LEN + 8];
+    uint8_t ntscf_pdu[AVTP_NTSCF_HEADER_LEN + 16] = { 0 };
+    uint8_t maap_pdu[4] = { AVTP_SUBTYPE_MAAP };
+
+    Avtp_Crf_Init((Avtp_Crf_t*)crf_pdu);
+    Avtp_Crf_SetCrfDataLength((Avtp_Crf_t*)crf_pdu, 8);
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)ntscf_pdu);
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)ntscf_pdu, 8);
+
+    Avtp_Dispatcher_Init(&dispatcher);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_CRF, count_handler, &crf);
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_NTSCF, count_handler, &ntscf);
+
+    // No handler for MAAP and no default handler yet
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, maap_pdu, sizeof(maap_pdu)), -ENOENT);
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, maap_pdu, 0), -EINVAL);
+
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, crf_pdu, sizeof(crf_pdu)), 42);
+    assert_int_equal(crf.calls, 1);
+    assert_int_equal(crf.lastLen, sizeof(crf_pdu));
+
+    // The view only covers the header and the announced data length
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, ntscf_pdu, sizeof(ntscf_pdu)), 42);
+    assert_int_equal(ntscf.calls, 1);
+    assert_int_equal(ntscf.lastLen, AVTP_NTSCF_HEADER_LEN + 8);
+
+    // Truncated PDUs never reach the handler
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, crf_pdu, sizeof(crf_pdu) - 1), -EINVAL);
+    assert_int_equal(crf.calls, 1);
+
+    // Default handler gets all remaining subtypes
+    Avtp_Dispatcher_SetDefault(&dispatcher, count_handler, &fallback);
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, maap_pdu, sizeof(maap_pdu)), 42);
+    assert_int_equal(fallback.calls, 1);
+    assert_int_equal(fallback.lastSubtype, AVTP_SUBTYPE_MAAP);
+
+    // Unregistering a subtype falls back to the default handler
+    Avtp_Dispatcher_Register(&dispatcher, AVTP_SUBTYPE_CRF, NULL, NULL);
+    assert_int_equal(Avtp_Dispatcher_Dispatch(&dispatcher, crf_pdu, sizeof(crf_pdu)), 42);
+    assert_int_equal(crf.calls, 1);
+    assert_int_equal(fallback.calls, 2);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(dispatcher_init_invalid),
+        cmocka_unit_test(dispatcher_dispatch),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/PduView.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/acf/Common.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Can.h"
+
+#define MAX_PDU_SIZE        1500
+
+static void pdu_view_advance(void **state)
+{
+    uint8_t buf[16] = { 0 };
+    Avtp_PduView_t view, rest;
+
+    assert_int_equal(Avtp_PduView_Init(NULL, buf, sizeof(buf)), -EINVAL);
+    assert_int_equal(Avtp_PduView_Init(&view, NULL, sizeof(buf)), -EINVAL);
+
+    assert_int_equal(Avtp_PduView_Init(&view, buf, sizeof(buf)), 0);
+    assert_int_equal(Avtp_PduView_Advance(&view, 4, &rest), 0);
+    assert_ptr_equal(rest.base, buf + 4);
+    assert_int_equal(rest.len, 12);
+
+    assert_int_equal(Avtp_PduView_Advance(&view, 16, &rest), 0);
+    assert_int_equal(rest.len, 0);
+    assert_int_equal(Avtp_PduView_Advance(&view, 17, &rest), -EINVAL);
+
+    rest = Avtp_PduView_Tail(&view, 8);
+    assert_ptr_equal(rest.base, buf + 8);
+    assert_int_equal(rest.len, 8);
+}
+
+static void crf_init_view(void **state)
+{
+    uint8_t pdu[AVTP_CRF_HEADER_LEN + 16];
+    Avtp_PduView_t view;
+
+    Avtp_Crf_Init((Avtp_Crf_t*)pdu);
+    Avtp_Crf_SetCrfDataLength((Avtp_Crf_t*)pdu, 16);
+
+    assert_int_equal(Avtp_Crf_InitView(&view, pdu, sizeof(pdu)), 0);
+    assert_ptr_equal(view.base, pdu);
+    assert_int_equal(view.len, sizeof(pdu));
+
+    // Trailing bytes (e.g. Ethernet padding) are not part of the view
+    assert_int_equal(Avtp_Crf_InitView(&view, pdu, sizeof(pdu) + 8), 0);
+    assert_int_equal(view.len, sizeof(pdu));
+
+    // Truncated payload and header
+    assert_int_equal(Avtp_Crf_InitView(&view, pdu, sizeof(pdu) - 1), -EINVAL);
+    assert_int_equal(Avtp_Crf_InitView(&view, pdu, AVTP_CRF_HEADER_LEN - 1), -EINVAL);
+
+    // Wrong subtype
+    pdu[0] = AVTP_SUBTYPE_AAF;
+    assert_int_equal(Avtp_Crf_InitView(&view, pdu, sizeof(pdu)), -EINVAL);
+}
+
+static void can_init_view(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint8_t payload[] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+    const uint8_t* view_payload;
+    uint16_t payload_length;
+    Avtp_PduView_t view;
+    int msg_len;
+
+    Avtp_Can_Init((Avtp_Can_t*)pdu);
+    msg_len = Avtp_Can_SetPayload((Avtp_Can_t*)pdu, 0x123, payload, sizeof(payload), CAN_CLASSIC);
+    assert_int_equal(msg_len, AVTP_CAN_HEADER_LEN + 8);
+
+    assert_int_equal(Avtp_Can_InitView(&view, pdu, MAX_PDU_SIZE), 0);
+    assert_int_equal(view.len, msg_len);
+
+    view_payload = Avtp_Can_GetViewPayload(&view, &payload_length);
+    assert_ptr_equal(view_payload, pdu + AVTP_CAN_HEADER_LEN);
+    assert_int_equal(payload_length, sizeof(payload));
+    assert_memory_equal(view_payload, payload, sizeof(payload));
+
+    // Message longer than the buffer
+    assert_int_equal(Avtp_Can_InitView(&view, pdu, msg_len - 1), -EINVAL);
+
+    // Message too short for its header
+    Avtp_Can_SetAcfMsgLength((Avtp_Can_t*)pdu, 3);
+    assert_int_equal(Avtp_Can_InitView(&view, pdu, MAX_PDU_SIZE), -EINVAL);
+
+    // Padding larger than the payload
+    Avtp_Can_SetAcfMsgLength((Avtp_Can_t*)pdu, 4);
+    Avtp_Can_SetPad((Avtp_Can_t*)pdu, 1);
+    assert_int_equal(Avtp_Can_InitView(&view, pdu, MAX_PDU_SIZE), -EINVAL);
+
+    // Wrong message type
+    Avtp_Can_SetPad((Avtp_Can_t*)pdu, 0);
+    Avtp_Can_SetAcfMsgType((Avtp_Can_t*)pdu, AVTP_ACF_TYPE_LIN);
+    assert_int_equal(Avtp_Can_InitView(&view, pdu, MAX_PDU_SIZE), -EINVAL);
+    assert_int_equal(Avtp_AcfCommon_InitView(&view, pdu, MAX_PDU_SIZE), 0);
+}
+
+static void ntscf_traverse_views(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint8_t payload[8] = { 0 };
+    Avtp_PduView_t cf_view, msgs, msg;
+    size_t len = AVTP_NTSCF_HEADER_LEN;
+    int count = 0;
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu);
+    for (int i = 0; i < 3; i++) {
+        Avtp_Can_Init((Avtp_Can_t*)(pdu + len));
+        len += Avtp_Can_SetPayload((Avtp_Can_t*)(pdu + len), 0x100 + i, payload, i * 3, CAN_CLASSIC);
+    }
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)pdu, len - AVTP_NTSCF_HEADER_LEN);
+
+    assert_int_equal(Avtp_Ntscf_InitView(&cf_view, pdu, len), 0);
+    msgs = Avtp_PduView_Tail(&cf_view, AVTP_NTSCF_HEADER_LEN);
+    while (msgs.len > 0) {
+        assert_int_equal(Avtp_Can_InitView(&msg, msgs.base, msgs.len), 0);
+        assert_int_equal(Avtp_Can_GetCanIdentifier((const Avtp_Can_t*)msg.base), 0x100 + count);
+        msgs = Avtp_PduView_Tail(&msgs, msg.len);
+        count++;
+    }
+    assert_int_equal(count, 3);
+
+    // Data length beyond the received bytes
+    assert_int_equal(Avtp_Ntscf_InitView(&cf_view, pdu, len - 1), -EINVAL);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(pdu_view_advance),
+        cmocka_unit_test(crf_init_view),
+        cmocka_unit_test(can_init_view),
+        cmocka_unit_test(ntscf_traverse_views),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
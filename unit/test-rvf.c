@@ -869,6 +869,36 @@ static void rvf_set_field_raw_line_number(void **state)
     assert_true(be64toh(pay->raw_header) == 0x0000000000000123);
 }
 
+static void rvf_unpack_pack(void **state)
+{
+    int res;
+    Avtp_RvfHeader_t header;
+    uint8_t pdu[AVTP_RVF_HEADER_LEN];
+    uint8_t packed[AVTP_RVF_HEADER_LEN];
+
+    for (int i = 0; i < AVTP_RVF_HEADER_LEN; i++) {
+        pdu[i] = 0x11 * i;
+    }
+    Avtp_Rvf_SetField((Avtp_Rvf_t*)pdu, AVTP_RVF_FIELD_RESERVED, 0);
+    Avtp_Rvf_SetField((Avtp_Rvf_t*)pdu, AVTP_RVF_FIELD_RESERVED_2, 0);
+    Avtp_Rvf_SetField((Avtp_Rvf_t*)pdu, AVTP_RVF_FIELD_RESERVED_3, 0);
+    Avtp_Rvf_SetField((Avtp_Rvf_t*)pdu, AVTP_RVF_FIELD_RESERVED_4, 0);
+    Avtp_Rvf_SetField((Avtp_Rvf_t*)pdu, AVTP_RVF_FIELD_RESERVED_5, 0);
+    Avtp_Rvf_SetField((Avtp_Rvf_t*)pdu, AVTP_RVF_FIELD_RESERVED_6, 0);
+
+    res = Avtp_Rvf_Unpack((Avtp_Rvf_t*)pdu, &header);
+
+    assert_int_equal(res, 0);
+    assert_true(header.stream_id == 0x445566778899aabb);
+    assert_int_equal(header.line_number, 0xfe0f);
+
+    memset(packed, 0xff, sizeof(packed));
+    res = Avtp_Rvf_Pack((Avtp_Rvf_t*)packed, &header);
+
+    assert_int_equal(res, 0);
+    assert_memory_equal(pdu, packed, AVTP_RVF_HEADER_LEN);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -925,6 +955,7 @@ int main(void)
         cmocka_unit_test(rvf_set_field_raw_line_number),
         cmocka_unit_test(rvf_pdu_init_null_pdu),
         cmocka_unit_test(rvf_pdu_init),
+        cmocka_unit_test(rvf_unpack_pack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "avtp/acf/Sensor.h"
+#include "avtp/acf/SensorBrief.h"
+
+#define MAX_PDU_SIZE        1500
+
+static void sensor_pack_invalid(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint16_t samples[AVTP_SENSOR_MAX_SAMPLES + 1] = { 0 };
+
+    Avtp_Sensor_Init((Avtp_Sensor_t*)pdu);
+
+    assert_int_equal(Avtp_Sensor_PackSamples(NULL, samples, 1, AVTP_SENSOR_SZ_16BIT), -EINVAL);
+    assert_int_equal(Avtp_Sensor_PackSamples((Avtp_Sensor_t*)pdu, NULL, 1, AVTP_SENSOR_SZ_16BIT), -EINVAL);
+    assert_int_equal(Avtp_Sensor_PackSamples((Avtp_Sensor_t*)pdu, samples,
+                                             AVTP_SENSOR_MAX_SAMPLES + 1, AVTP_SENSOR_SZ_16BIT), -EINVAL);
+    assert_int_equal(Avtp_Sensor_PackSamples((Avtp_Sensor_t*)pdu, samples, 1, 4), -EINVAL);
+
+    assert_int_equal(Avtp_Sensor_UnpackSamples(NULL, samples, 1), -EINVAL);
+    assert_int_equal(Avtp_Sensor_UnpackSamples((Avtp_Sensor_t*)pdu, NULL, 1), -EINVAL);
+}
+
+static void sensor_pack_16bit(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint16_t samples[3] = { 0x0102, 0x0304, 0x0506 };
+    uint16_t out[3] = { 0 };
+    const uint8_t ref[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00, 0x00 };
+    int ret;
+
+    memset(pdu, 0xff, sizeof(pdu));
+    Avtp_Sensor_Init((Avtp_Sensor_t*)pdu);
+    Avtp_Sensor_SetSensorGroup((Avtp_Sensor_t*)pdu, 0x15);
+
+    ret = Avtp_Sensor_PackSamples((Avtp_Sensor_t*)pdu, samples, 3, AVTP_SENSOR_SZ_16BIT);
+    assert_int_equal(ret, AVTP_SENSOR_HEADER_LEN + 8);
+    assert_memory_equal(pdu + AVTP_SENSOR_HEADER_LEN, ref, sizeof(ref));
+
+    assert_int_equal(Avtp_Sensor_GetAcfMsgLength((Avtp_Sensor_t*)pdu), ret / AVTP_QUADLET_SIZE);
+    assert_int_equal(Avtp_Sensor_GetNumSensor((Avtp_Sensor_t*)pdu), 3);
+    assert_int_equal(Avtp_Sensor_GetSz((Avtp_Sensor_t*)pdu), AVTP_SENSOR_SZ_16BIT);
+    assert_int_equal(Avtp_Sensor_GetSensorGroup((Avtp_Sensor_t*)pdu), 0x15);
+
+    // Destination too small
+    assert_int_equal(Avtp_Sensor_UnpackSamples((Avtp_Sensor_t*)pdu, out, 2), -EINVAL);
+
+    assert_int_equal(Avtp_Sensor_UnpackSamples((Avtp_Sensor_t*)pdu, out, 3), 3);
+    assert_memory_equal(out, samples, sizeof(samples));
+
+    // Message length too short for num_sensor
+    Avtp_Sensor_SetAcfMsgLength((Avtp_Sensor_t*)pdu, 4);
+    assert_int_equal(Avtp_Sensor_UnpackSamples((Avtp_Sensor_t*)pdu, out, 3), -EINVAL);
+}
+
+static void sensor_pack_all_sizes(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint64_t samples64[AVTP_SENSOR_MAX_SAMPLES], out64[AVTP_SENSOR_MAX_SAMPLES];
+    uint32_t samples32[AVTP_SENSOR_MAX_SAMPLES], out32[AVTP_SENSOR_MAX_SAMPLES];
+    uint16_t samples16[AVTP_SENSOR_MAX_SAMPLES], out16[AVTP_SENSOR_MAX_SAMPLES];
+    uint8_t samples8[AVTP_SENSOR_MAX_SAMPLES], out8[AVTP_SENSOR_MAX_SAMPLES];
+    const void* samples[] = { samples64, samples32, samples16, samples8 };
+    void* out[] = { out64, out32, out16, out8 };
+
+    for (int i = 0; i < AVTP_SENSOR_MAX_SAMPLES; i++) {
+        samples64[i] = 0x0102030405060708ULL * (i + 1);
+        samples32[i] = 0x01020304 * (i + 1);
+        samples16[i] = 0x0102 * (i + 1);
+        samples8[i] = i + 1;
+    }
+
+    for (int sz = AVTP_SENSOR_SZ_64BIT; sz <= AVTP_SENSOR_SZ_8BIT; sz++) {
+        size_t size = Avtp_Sensor_GetSampleSize(sz);
+
+        for (int n = 0; n <= AVTP_SENSOR_MAX_SAMPLES; n += 7) {
+            size_t len = (n * size + 3) & ~3;
+            int ret;
+
+            memset(pdu, 0xff, sizeof(pdu));
+            Avtp_Sensor_Init((Avtp_Sensor_t*)pdu);
+            ret = Avtp_Sensor_PackSamples((Avtp_Sensor_t*)pdu, samples[sz], n, sz);
+            assert_int_equal(ret, AVTP_SENSOR_HEADER_LEN + len);
+
+            // Payload is big-endian and padding is zeroed
+            for (int k = 0; k < n; k++) {
+                uint64_t v = 0;
+                for (size_t b = 0; b < size; b++) {
+                    v = (v << 8) | pdu[AVTP_SENSOR_HEADER_LEN + k * size + b];
+                }
+                switch (sz) {
+                case AVTP_SENSOR_SZ_64BIT: assert_true(v == samples64[k]); break;
+                case AVTP_SENSOR_SZ_32BIT: assert_true(v == samples32[k]); break;
+                case AVTP_SENSOR_SZ_16BIT: assert_true(v == samples16[k]); break;
+                default: assert_true(v == samples8[k]); break;
+                }
+            }
+            for (size_t b = n * size; b < len; b++) {
+                assert_int_equal(pdu[AVTP_SENSOR_HEADER_LEN + b], 0);
+            }
+
+            memset(out[sz], 0, AVTP_SENSOR_MAX_SAMPLES * size);
+            assert_int_equal(Avtp_Sensor_UnpackSamples((Avtp_Sensor_t*)pdu, out[sz],
+                                                       AVTP_SENSOR_MAX_SAMPLES), n);
+            assert_memory_equal(out[sz], samples[sz], n * size);
+        }
+    }
+}
+
+static void sensor_brief_pack(void **state)
+{
+    uint8_t pdu[MAX_PDU_SIZE];
+    uint32_t samples[5] = { 0x11223344, 0x55667788, 0x99aabbcc, 0xddeeff00, 0x12345678 };
+    uint32_t out[5] = { 0 };
+    uint8_t bytes[5] = { 1, 2, 3, 4, 5 };
+    const uint8_t ref[] = { 1, 2, 3, 4, 5, 0, 0, 0 };
+    int ret;
+
+    Avtp_SensorBrief_Init((Avtp_SensorBrief_t*)pdu);
+    ret = Avtp_SensorBrief_PackSamples((Avtp_SensorBrief_t*)pdu, samples, 5, AVTP_SENSOR_SZ_32BIT);
+    assert_int_equal(ret, AVTP_SENSOR_BRIEF_HEADER_LEN + 20);
+    assert_int_equal(pdu[AVTP_SENSOR_BRIEF_HEADER_LEN], 0x11);
+    assert_int_equal(pdu[AVTP_SENSOR_BRIEF_HEADER_LEN + 3], 0x44);
+    assert_int_equal(Avtp_SensorBrief_GetAcfMsgLength((Avtp_SensorBrief_t*)pdu), 6);
+    assert_int_equal(Avtp_SensorBrief_GetAcfMsgType((Avtp_SensorBrief_t*)pdu), AVTP_ACF_TYPE_SENSOR_BRIEF);
+
+    assert_int_equal(Avtp_SensorBrief_UnpackSamples((Avtp_SensorBrief_t*)pdu, out, 5), 5);
+    assert_memory_equal(out, samples, sizeof(samples));
+
+    memset(pdu, 0xff, sizeof(pdu));
+    Avtp_SensorBrief_Init((Avtp_SensorBrief_t*)pdu);
+    ret = Avtp_SensorBrief_PackSamples((Avtp_SensorBrief_t*)pdu, bytes, 5, AVTP_SENSOR_SZ_8BIT);
+    assert_int_equal(ret, AVTP_SENSOR_BRIEF_HEADER_LEN + 8);
+    assert_memory_equal(pdu + AVTP_SENSOR_BRIEF_HEADER_LEN, ref, sizeof(ref));
+    assert_int_equal(Avtp_SensorBrief_GetNumSensor((Avtp_SensorBrief_t*)pdu), 5);
+    assert_int_equal(Avtp_SensorBrief_GetSz((Avtp_SensorBrief_t*)pdu), AVTP_SENSOR_SZ_8BIT);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(sensor_pack_invalid),
+        cmocka_unit_test(sensor_pack_16bit),
+        cmocka_unit_test(sensor_pack_all_sizes),
+        cmocka_unit_test(sensor_brief_pack),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be 
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "avtp/StreamTemplate.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/aaf/PcmStream.h"
+#include "avtp/acf/Ntscf.h"
+
+static void stream_template_init_invalid(void **state)
+{
+    int res;
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_STREAM_TEMPLATE_MAX_LEN + 1] = { 0 };
+
+    res = Avtp_StreamTemplate_Init(NULL, header, AVTP_AAF_PCM_STREAM_HEADER_LEN);
+    assert_int_equal(res, -EINVAL);
+
+    res = Avtp_StreamTemplate_Init(&tmpl, NULL, AVTP_AAF_PCM_STREAM_HEADER_LEN);
+    assert_int_equal(res, -EINVAL);
+
+    // Unsupported subtype
+    header[0] = AVTP_SUBTYPE_MAAP;
+    res = Avtp_StreamTemplate_Init(&tmpl, header, AVTP_AAF_PCM_STREAM_HEADER_LEN);
+    assert_int_equal(res, -EINVAL);
+
+    // Header too short for the data length field
+    header[0] = AVTP_SUBTYPE_AAF;
+    res = Avtp_StreamTemplate_Init(&tmpl, header, AVTP_AAF_PCM_STREAM_HEADER_LEN - 1);
+    assert_int_equal(res, -EINVAL);
+
+    // Header too long for the template
+    res = Avtp_StreamTemplate_Init(&tmpl, header, sizeof(header));
+    assert_int_equal(res, -EINVAL);
+}
+
+static void stream_template_emit_aaf(void **state)
+{
+    int res;
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_AAF_PCM_STREAM_HEADER_LEN];
+    uint8_t ref[AVTP_AAF_PCM_STREAM_HEADER_LEN];
+    uint8_t pdu[AVTP_AAF_PCM_STREAM_HEADER_LEN];
+
+    Avtp_AafPcmStream_Init((Avtp_AafPcmStream_t*)header);
+    Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)header, AVTP_AAF_PCM_STREAM_FIELD_TV, 1);
+    Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)header, AVTP_AAF_PCM_STREAM_FIELD_STREAM_ID, 0xAABBCCDDEEFF0001);
+    Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)header, AVTP_AAF_PCM_STREAM_FIELD_FORMAT, AVTP_AAF_FORMAT_INT_16BIT);
+    Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)header, AVTP_AAF_PCM_STREAM_FIELD_SP, AVTP_AAF_PCM_SP_SPARSE);
+    Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)header, AVTP_AAF_PCM_STREAM_FIELD_EVT, 0x5);
+
+    res = Avtp_StreamTemplate_Init(&tmpl, header, sizeof(header));
+    assert_int_equal(res, 0);
+
+    for (int i = 0; i < 3; i++) {
+        memcpy(ref, header, sizeof(header));
+        Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)ref, AVTP_AAF_PCM_STREAM_FIELD_SEQUENCE_NUM, 0xfe + i);
+        Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)ref, AVTP_AAF_PCM_STREAM_FIELD_AVTP_TIMESTAMP, 0x80C0FFEE + i);
+        Avtp_AafPcmStream_SetField((Avtp_AafPcmStream_t*)ref, AVTP_AAF_PCM_STREAM_FIELD_STREAM_DATA_LENGTH, 0x100 + i);
+
+        memset(pdu, 0xff, sizeof(pdu));
+        Avtp_StreamTemplate_Emit(&tmpl, pdu, 0xfe + i, 0x80C0FFEE + i, 0x100 + i);
+
+        assert_memory_equal(ref, pdu, sizeof(pdu));
+    }
+}
+
+static void stream_template_emit_crf(void **state)
+{
+    int res;
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_CRF_HEADER_LEN];
+    uint8_t ref[AVTP_CRF_HEADER_LEN];
+    uint8_t pdu[AVTP_CRF_HEADER_LEN];
+
+    Avtp_Crf_Init((Avtp_Crf_t*)header);
+    Avtp_Crf_SetField((Avtp_Crf_t*)header, AVTP_CRF_FIELD_STREAM_ID, 0xAABBCCDDEEFF0002);
+    Avtp_Crf_SetField((Avtp_Crf_t*)header, AVTP_CRF_FIELD_TIMESTAMP_INTERVAL, 160);
+
+    res = Avtp_StreamTemplate_Init(&tmpl, header, sizeof(header));
+    assert_int_equal(res, 0);
+
+    memcpy(ref, header, sizeof(header));
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_SEQUENCE_NUM, 7);
+    Avtp_Crf_SetField((Avtp_Crf_t*)ref, AVTP_CRF_FIELD_CRF_DATA_LENGTH, 48);
+
+    Avtp_StreamTemplate_Emit(&tmpl, pdu, 7, 0xdeadbeef, 48);
+
+    assert_memory_equal(ref, pdu, sizeof(pdu));
+}
+
+static void stream_template_emit_ntscf(void **state)
+{
+    int res;
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_NTSCF_HEADER_LEN];
+    uint8_t ref[AVTP_NTSCF_HEADER_LEN];
+    uint8_t pdu[AVTP_NTSCF_HEADER_LEN];
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)header);
+    Avtp_Ntscf_SetField((Avtp_Ntscf_t*)header, AVTP_NTSCF_FIELD_VERSION, 0x7);
+    Avtp_Ntscf_SetField((Avtp_Ntscf_t*)header, AVTP_NTSCF_FIELD_STREAM_ID, 0xAABBCCDDEEFF0003);
+
+    res = Avtp_StreamTemplate_Init(&tmpl, header, sizeof(header));
+    assert_int_equal(res, 0);
+
+    memcpy(ref, header, sizeof(header));
+    Avtp_Ntscf_SetField((Avtp_Ntscf_t*)ref, AVTP_NTSCF_FIELD_SEQUENCE_NUM, 0x42);
+    Avtp_Ntscf_SetField((Avtp_Ntscf_t*)ref, AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, 0x5a5);
+
+    // Bits of the length beyond the 11 bit field must not leak into version
+    Avtp_StreamTemplate_Emit(&tmpl, pdu, 0x42, 0, 0xfda5);
+
+    assert_memory_equal(ref, pdu, sizeof(pdu));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(stream_template_init_invalid),
+        cmocka_unit_test(stream_template_emit_aaf),
+        cmocka_unit_test(stream_template_emit_crf),
+        cmocka_unit_test(stream_template_emit_ntscf),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}